@@ -57,13 +57,13 @@ const Module decrypt_pka(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "Error: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream msg(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile msg(args.at("file"));
         if (!msg){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -71,13 +71,13 @@ const Module decrypt_pka(
 
         OpenPGP::Key::Ptr signer = nullptr;
         if (args.at("-s").size()){
-            std::ifstream s(args.at("-s"), std::ios::binary);
+            OpenPGP::MappedFile s(args.at("-s"));
             if (!s){
                 err << "Error: File \"" + args.at("-s") + "\" not opened." << std::endl;
                 return -1;
             }
 
-            signer = std::make_shared <OpenPGP::Key> (s);
+            signer = std::make_shared <OpenPGP::Key> (s.stream());
 
             if (!signer -> meaningful()){
                 err << "Error: Bad signing key.\n";
@@ -85,8 +85,8 @@ const Module decrypt_pka(
             }
         }
 
-        OpenPGP::SecretKey pri(key);
-        OpenPGP::Message message(msg);
+        OpenPGP::SecretKey pri(key.stream());
+        OpenPGP::Message message(msg.stream());
 
         const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, args.at("passphrase"), message);
 
@@ -56,7 +56,7 @@ const Module decrypt_sym(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream msg(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile msg(args.at("file"));
         if (!msg){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -64,13 +64,13 @@ const Module decrypt_sym(
 
         OpenPGP::Key::Ptr signer = nullptr;
         if (args.at("-s").size()){
-            std::ifstream s(args.at("-s"), std::ios::binary);
+            OpenPGP::MappedFile s(args.at("-s"));
             if (!s){
                 err << "Error: File \"" + args.at("-s") + "\" not opened." << std::endl;
                 return -1;
             }
 
-            signer = std::make_shared <OpenPGP::PublicKey> (s);
+            signer = std::make_shared <OpenPGP::PublicKey> (s.stream());
 
             if (!signer -> meaningful()){
                 err << "Error: Bad signing key.\n";
@@ -78,7 +78,7 @@ const Module decrypt_sym(
             }
         }
 
-        const OpenPGP::Message message(msg);
+        const OpenPGP::Message message(msg.stream());
         const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(message, args.at("passphrase"));
 
         if (!decrypted.meaningful()){
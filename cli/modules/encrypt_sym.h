@@ -62,7 +62,7 @@ const Module encrypt_sym(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream file(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile file(args.at("file"));
         if (!file){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -90,13 +90,13 @@ const Module encrypt_sym(
 
         OpenPGP::SecretKey::Ptr signer = nullptr;
         if (args.at("--sign").size()){
-            std::ifstream signing(args.at("--sign"), std::ios::binary);
+            OpenPGP::MappedFile signing(args.at("--sign"));
             if (!signing){
                 err << "Error: File \"" + args.at("--sign") + "\" not opened." << std::endl;
                 return -1;
             }
 
-            signer = std::make_shared <OpenPGP::SecretKey> (signing);
+            signer = std::make_shared <OpenPGP::SecretKey> (signing.stream());
 
             if (!signer -> meaningful()){
                 err << "Error: Bad signing key.\n";
@@ -105,7 +105,7 @@ const Module encrypt_sym(
         }
 
         const OpenPGP::Encrypt::Args encryptargs(args.at("file"),
-                                                 std::string(std::istreambuf_iterator <char> (file), {}),
+                                                 file.str(),
                                                  OpenPGP::Sym::NUMBER.at(args.at("--sym")),
                                                  OpenPGP::Compression::NUMBER.at(args.at("-c")),
                                                  flags.at("--mdc"),
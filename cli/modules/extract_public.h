@@ -30,13 +30,13 @@ const Module extract_public(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "IOError: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::SecretKey pri(key);
+        const OpenPGP::SecretKey pri(key.stream());
         if (!pri.meaningful()){
             err << "Error: Key is not meaningful." << std::endl;
             return -1;
@@ -56,7 +56,7 @@ const Module fingerprint(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream f(args.at("key-file"), std::ios::binary);
+        OpenPGP::MappedFile f(args.at("key-file"));
         if (!f){
             err << "Error: File \"" << args.at("key-file") << "\" not opened." << std::endl;
             return -1;
@@ -69,7 +69,7 @@ const Module fingerprint(
             return -1;
         }
 
-        const OpenPGP::Key key(f);
+        const OpenPGP::Key key(f.stream());
 
         if (!key.meaningful()){
             err << "Error: Key is not meaningful." << std::endl;
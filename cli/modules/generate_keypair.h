@@ -67,6 +67,7 @@ const Module generate_keypair(
     // optional flags
     {
         std::make_pair("-a",         std::make_pair("armored",                                               true)),
+        std::make_pair("--standard", std::make_pair("use pre-validated DSA/ElGamal groups",                 false)),
     },
 
     // function to run
@@ -120,6 +121,7 @@ const Module generate_keypair(
         config.bits       = std::strtoul(args.at("--pkeysize").c_str(), 0, 10);
         config.sym        = OpenPGP::Sym::NUMBER.at(args.at("--psym"));
         config.hash       = OpenPGP::Hash::NUMBER.at(args.at("--phash"));
+        config.standard   = flags.at("--standard");
 
         OpenPGP::KeyGen::Config::UserID uid;
         uid.user          = args.at("-u");
@@ -134,6 +136,7 @@ const Module generate_keypair(
         subkey.sym        = OpenPGP::Sym::NUMBER.at(args.at("--ssym"));
         subkey.hash       = OpenPGP::Hash::NUMBER.at(args.at("--shash"));
         subkey.sig        = OpenPGP::Hash::NUMBER.at(args.at("--ssig"));
+        subkey.standard   = flags.at("--standard");
         config.subkeys.push_back(subkey);
 
         const OpenPGP::SecretKey pri = OpenPGP::KeyGen::generate_key(config);
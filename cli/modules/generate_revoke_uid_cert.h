@@ -58,7 +58,7 @@ const Module generate_revoke_uid_cert(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "Error: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
@@ -69,7 +69,7 @@ const Module generate_revoke_uid_cert(
             return -1;
         }
 
-        const OpenPGP::SecretKey pri(key);
+        const OpenPGP::SecretKey pri(key.stream());
         const OpenPGP::Revoke::Args revargs(pri,
                                      args.at("passphrase"),
                                      pri,
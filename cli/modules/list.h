@@ -55,13 +55,13 @@ const Module list(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream f(args.at("key-file"), std::ios::binary);
+        OpenPGP::MappedFile f(args.at("key-file"));
         if (!f){
             err << "Error: File \"" << args.at("key-file") << "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key key(f);
+        const OpenPGP::Key key(f.stream());
 
         if (!key.meaningful()){
             err << "Warning: Provided key is not meaningful" << std::endl;
@@ -59,7 +59,7 @@ const Module revoke_subkey(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "Error: Could not open private key file \"" + args.at("private-key") + "\"" << std::endl;
             return -1;
@@ -77,7 +77,7 @@ const Module revoke_subkey(
             return -1;
         }
 
-        const OpenPGP::SecretKey pri(key);
+        const OpenPGP::SecretKey pri(key.stream());
         const OpenPGP::Revoke::Args revargs(pri,
                                             args.at("passphrase"),
                                             pri,
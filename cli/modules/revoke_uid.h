@@ -59,7 +59,7 @@ const Module revoke_uid(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "IOError: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
@@ -77,7 +77,7 @@ const Module revoke_uid(
             return -1;
         }
 
-        const OpenPGP::SecretKey pri(key);
+        const OpenPGP::SecretKey pri(key.stream());
         const OpenPGP::Revoke::Args revargs(pri,
                                             args.at("passphrase"),
                                             pri,
@@ -56,20 +56,20 @@ const Module revoke_with_cert(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream target(args.at("target"), std::ios::binary);
+        OpenPGP::MappedFile target(args.at("target"));
         if (!target){
             err << "IOError: File \"" + args.at("target") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream cert(args.at("revocation-certificate"), std::ios::binary);
+        OpenPGP::MappedFile cert(args.at("revocation-certificate"));
         if (!cert){
             err << "IOError: File \"" + args.at("revocation-certificate") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key key(target);
-        const OpenPGP::RevocationCertificate rev(cert);
+        const OpenPGP::Key key(target.stream());
+        const OpenPGP::RevocationCertificate rev(cert.stream());
 
         const OpenPGP::PublicKey revoked = OpenPGP::Revoke::with_cert(key, rev);
 
@@ -55,13 +55,13 @@ const Module show(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream file(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile file(args.at("file"));
         if (!file){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
         }
 
-        out << OpenPGP::PGP(file) << std::flush;
+        out << OpenPGP::PGP(file.stream()) << std::flush;
         return 0;
     }
 );
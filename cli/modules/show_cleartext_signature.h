@@ -55,13 +55,13 @@ const Module show_cleartext_signature(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream file(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile file(args.at("file"));
         if (!file){
             err << "Error: File \"" + args.at("filename") + "\" not opened." << std::endl;
             return -1;
         }
 
-        out << OpenPGP::CleartextSignature(file).show() << std::endl;
+        out << OpenPGP::CleartextSignature(file.stream()).show() << std::endl;
 
         return 0;
     }
@@ -57,13 +57,13 @@ const Module sign_cleartext_signature(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "IOError: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile file(args.at("file"));
         if (!file){
             err << "IOError: File \"" << args.at("file") << "\" not opened." << std::endl;
             return -1;
@@ -74,12 +74,12 @@ const Module sign_cleartext_signature(
             return -1;
         }
 
-        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(key),
+        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(key.stream()),
                                            args.at("passphrase"),
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::CleartextSignature signature = OpenPGP::Sign::cleartext_signature(signargs, std::string(std::istreambuf_iterator<char>(file), {}));
+        const OpenPGP::CleartextSignature signature = OpenPGP::Sign::cleartext_signature(signargs, file.str());
 
         if (!signature.meaningful()){
             err << "Error: Generated bad cleartext signature." << std::endl;
@@ -58,13 +58,13 @@ const Module sign_file(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("private-key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("private-key"));
         if (!key){
             err << "IOError: File \"" + args.at("private-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        OpenPGP::MappedFile file(args.at("file"));
         if (!file){
             err << "IOError: file \"" + args.at("file") + "\" could not be opened." << std::endl;
             return -1;
@@ -80,12 +80,12 @@ const Module sign_file(
             return -1;
         }
 
-        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(key),
+        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(key.stream()),
                                            args.at("passphrase"),
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::Message message = OpenPGP::Sign::binary(signargs, args.at("file"), std::string(std::istreambuf_iterator <char> (file), {}), OpenPGP::Compression::NUMBER.at(args.at("-c")));
+        const OpenPGP::Message message = OpenPGP::Sign::binary(signargs, args.at("file"), file.str(), OpenPGP::Compression::NUMBER.at(args.at("-c")));
 
         if (!message.meaningful()){
             err << "Error: Generated bad file signature." << std::endl;
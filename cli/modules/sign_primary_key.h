@@ -59,13 +59,13 @@ const Module sign_primary_key(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream signer_file(args.at("signer-key"), std::ios::binary);
+        OpenPGP::MappedFile signer_file(args.at("signer-key"));
         if (!signer_file){
             err << "IOError: File \"" + args.at("signer-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream signee_file(args.at("signee-key"), std::ios::binary);
+        OpenPGP::MappedFile signee_file(args.at("signee-key"));
         if (!signee_file){
             err << "IOError: File \"" + args.at("signee-key") + "\" not opened." << std::endl;
             return -1;
@@ -76,12 +76,12 @@ const Module sign_primary_key(
             return -1;
         }
 
-        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file),
+        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file.stream()),
                                            args.at("passphrase"),
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::PublicKey key = OpenPGP::Sign::primary_key(signargs, OpenPGP::PublicKey(signee_file), args.at("-u"), OpenPGP::mpitoulong(OpenPGP::hextompi(args.at("-c"))));
+        const OpenPGP::PublicKey key = OpenPGP::Sign::primary_key(signargs, OpenPGP::PublicKey(signee_file.stream()), args.at("-u"), OpenPGP::mpitoulong(OpenPGP::hextompi(args.at("-c"))));
 
         if (!key.meaningful()){
             err << "Error: Generated bad primary key signature." << std::endl;
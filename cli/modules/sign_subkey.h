@@ -60,13 +60,13 @@ const Module sign_subkey(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & /* out   */,
        std::ostream                              & err) -> int {
-        std::ifstream signer_file(args.at("signer-key"), std::ios::binary);
+        OpenPGP::MappedFile signer_file(args.at("signer-key"));
         if (!signer_file){
             err << "IOError: File \"" + args.at("signer-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream signee_file(args.at("signee-key"), std::ios::binary);
+        OpenPGP::MappedFile signee_file(args.at("signee-key"));
         if (!signee_file){
             err << "IOError: File \"" + args.at("signee-key") + "\" not opened." << std::endl;
             return -1;
@@ -77,12 +77,12 @@ const Module sign_subkey(
             return -1;
         }
 
-        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file),
+        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file.stream()),
                                            args.at("passphrase"),
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        // OpenPGP::PublicKey key = OpenPGP::Sign::subkey(signargs, OpenPGP::PublicKey(signee_file), mpitoulong(hextompi(args.at("-c"))));
+        // OpenPGP::PublicKey key = OpenPGP::Sign::subkey(signargs, OpenPGP::PublicKey(signee_file.stream()), mpitoulong(hextompi(args.at("-c"))));
 
         // if (!key.meaningful()){
             // err << "Error: Generated bad subkey signature." << std::endl;
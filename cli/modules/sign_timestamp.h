@@ -57,7 +57,7 @@ const Module sign_timestamp(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream signer_file(args.at("signer-key"), std::ios::binary);
+        OpenPGP::MappedFile signer_file(args.at("signer-key"));
         if (!signer_file){
             err << "IOError: File \"" + args.at("signer-key") + "\" not opened." << std::endl;
             return -1;
@@ -75,7 +75,7 @@ const Module sign_timestamp(
             return -1;
         }
 
-        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file),
+        const OpenPGP::Sign::Args signargs(OpenPGP::SecretKey(signer_file.stream()),
                                            args.at("passphrase"),
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
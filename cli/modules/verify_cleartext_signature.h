@@ -56,20 +56,20 @@ const Module verify_cleartext_signature(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("key"));
         if (!key){
             err << "Error: File \"" + args.at("key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream sig(args.at("signature"), std::ios::binary);
+        OpenPGP::MappedFile sig(args.at("signature"));
         if (!sig){
             err << "Error: File \"" + args.at("signature") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key signer(key);
-        const OpenPGP::CleartextSignature signature(sig);
+        const OpenPGP::Key signer(key.stream());
+        const OpenPGP::CleartextSignature signature(sig.stream());
 
         const int verified = OpenPGP::Verify::cleartext_signature(signer, signature);
 
@@ -56,20 +56,20 @@ const Module verify_file(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("key"));
         if (!key){
             err << "Error: Key file \"" + args.at("key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream msg(args.at("message"), std::ios::binary);
+        OpenPGP::MappedFile msg(args.at("message"));
         if (!msg){
             err << "Error: Message file \"" + args.at("message") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key signer(key);
-        const OpenPGP::Message message(msg);
+        const OpenPGP::Key signer(key.stream());
+        const OpenPGP::Message message(msg.stream());
 
         const int verified = OpenPGP::Verify::binary(signer, message);
 
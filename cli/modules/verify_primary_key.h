@@ -56,19 +56,19 @@ const Module verify_primary_key(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream signer(args.at("signer-key"), std::ios::binary);
+        OpenPGP::MappedFile signer(args.at("signer-key"));
         if (!signer){
             err << "Error: Key file \"" + args.at("signer-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream signee(args.at("signee-key"), std::ios::binary);
+        OpenPGP::MappedFile signee(args.at("signee-key"));
         if (!signee){
             err << "Error: Signing Key file \"" + args.at("signee-key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key signerkey(signer), signeekey(signee);
+        const OpenPGP::Key signerkey(signer.stream()), signeekey(signee.stream());
 
         const int verified = OpenPGP::Verify::primary_key(signerkey, signeekey);
 
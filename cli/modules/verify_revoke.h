@@ -56,20 +56,20 @@ const Module verify_revoke(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("key"));
         if (!key){
             err << "Error: Public key file \"" + args.at("key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream cert(args.at("revocation-certificate"), std::ios::binary);
+        OpenPGP::MappedFile cert(args.at("revocation-certificate"));
         if (!cert){
             err << "Error: Revocation certificate file \"" + args.at("revocation-certificate") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key signer(key);
-        const OpenPGP::RevocationCertificate rev(cert);
+        const OpenPGP::Key signer(key.stream());
+        const OpenPGP::RevocationCertificate rev(cert.stream());
 
             const int verified = OpenPGP::Verify::revoke(signer, rev);
 
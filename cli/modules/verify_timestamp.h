@@ -56,20 +56,20 @@ const Module verify_timestamp(
        const std::map <std::string, bool>        & /* flags */,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream key(args.at("key"), std::ios::binary);
+        OpenPGP::MappedFile key(args.at("key"));
         if (!key){
             err << "Error: Public key file \"" + args.at("key") + "\" not opened." << std::endl;
             return -1;
         }
 
-        std::ifstream sig(args.at("signature"), std::ios::binary);
+        OpenPGP::MappedFile sig(args.at("signature"));
         if (!sig){
             err << "Error: Signature file \"" + args.at("signature") + "\" not opened." << std::endl;
             return -1;
         }
 
-        const OpenPGP::Key signer(key);
-        const OpenPGP::DetachedSignature signature(sig);
+        const OpenPGP::Key signer(key.stream());
+        const OpenPGP::DetachedSignature signature(sig.stream());
 
         const int verified = OpenPGP::Verify::timestamp(signer, signature);
 
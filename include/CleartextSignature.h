@@ -80,6 +80,7 @@ namespace OpenPGP {
             CleartextSignature(const CleartextSignature & copy);
             CleartextSignature(const std::string & data);
             CleartextSignature(std::istream & stream);
+            static CleartextSignature from_file(const std::string & path);   // read through a read-only memory map
 
             void read(const std::string & data);
             void read(std::istream & stream);
@@ -46,6 +46,7 @@ namespace OpenPGP {
             DetachedSignature(const DetachedSignature & copy);
             DetachedSignature(const std::string & data);
             DetachedSignature(std::istream & stream);
+            static DetachedSignature from_file(const std::string & path);   // read through a read-only memory map
             ~DetachedSignature();
 
             // whether or not PGP data matches Detached Signature format without constructing a new object
@@ -65,6 +65,7 @@ namespace OpenPGP {
             Key(const Key & copy);
             Key(const std::string & data);
             Key(std::istream & stream);
+            static Key from_file(const std::string & path);   // read through a read-only memory map
             ~Key();
 
             // keyid that is searched for on keyservers
@@ -172,6 +173,7 @@ namespace OpenPGP {
             PublicKey(const PublicKey & copy);
             PublicKey(const std::string & data);
             PublicKey(std::istream & stream);
+            static PublicKey from_file(const std::string & path);   // read through a read-only memory map
             PublicKey(const SecretKey & sec);
             ~PublicKey();
 
@@ -207,6 +209,7 @@ namespace OpenPGP {
             SecretKey(const SecretKey & copy);
             SecretKey(const std::string & data);
             SecretKey(std::istream & stream);
+            static SecretKey from_file(const std::string & path);   // read through a read-only memory map
             ~SecretKey();
 
             // Extract Public Key data from a Secret Key
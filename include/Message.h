@@ -112,6 +112,7 @@ namespace OpenPGP {
             Message(const Message & copy);
             Message(const std::string & data);
             Message(std::istream & stream);
+            static Message from_file(const std::string & path);   // read through a read-only memory map
             ~Message();
 
             // Read Binary data
@@ -129,6 +129,19 @@ namespace OpenPGP {
     // returns Tag data with new format Tag length
     // octets trys to force the data into an octet length type; mostly useful for writing into larger octet lengths
     std::string write_new_length(const uint8_t tag, const std::string & data, const Packet::PartialBodyLength part, uint8_t octets = 0);
+
+    // append only the header of a packet with a length octet body
+    // partial body lengths are mixed into the data, so they are not handled here
+    void write_old_header(const uint8_t tag, const std::size_t length, std::string & out, uint8_t octets = 0);
+    void write_new_header(const uint8_t tag, const std::size_t length, std::string & out, uint8_t octets = 0);
+
+    // append only the new format length octets, without the tag octet
+    // used for the length headers that follow a partial body length
+    void write_new_length_octets(std::size_t length, std::string & out, const uint8_t octets = 0);
+
+    // number of octets write_old_length/write_new_length add to length octets of data
+    std::size_t old_length_size(const std::size_t length, const Packet::PartialBodyLength part, uint8_t octets = 0);
+    std::size_t new_length_size(const std::size_t length, const Packet::PartialBodyLength part, uint8_t octets = 0);
 }
 
 #endif
@@ -143,6 +143,10 @@ namespace OpenPGP {
 
     std::string EMSA_PKCS1_v1_5(const uint8_t & hash, const std::string & hashed_data, const unsigned int & keylength);
 
+    // EM without the hash value; the same for every message signed
+    // with a given hash and key length
+    std::string EMSA_PKCS1_v1_5_prefix(const uint8_t & hash, const unsigned int & keylength);
+
 }
 
 #endif
@@ -0,0 +1,129 @@
+/*
+montgomery.h
+Montgomery multiplication and multi-exponentiation
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __MONTGOMERY__
+#define __MONTGOMERY__
+
+#include <vector>
+
+#include <gmp.h>
+
+#include "Misc/mpi.h"
+
+namespace OpenPGP {
+    // Montgomery arithmetic modulo an odd modulus, done on raw limbs
+    // so that reductions do not need divisions
+    //
+    // mul and sqr take the same time for all inputs of a given modulus
+    class Montgomery {
+        public:
+            typedef std::vector <mp_limb_t> Residue;
+
+        private:
+            MPI mod;
+            Residue m;                  // limbs of mod
+            mp_size_t n;                // number of limbs
+            mp_limb_t minv;             // -mod^-1 mod 2^GMP_NUMB_BITS
+
+            // t (2n limbs) is destroyed; out (n limbs) may alias t
+            // the final subtraction is done without branching
+            void redc(mp_limb_t * out, mp_limb_t * t) const;
+
+        public:
+            Montgomery(const MPI & modulus);
+
+            const MPI & get_mod() const;
+            mp_size_t size() const;
+
+            // conversion into and out of Montgomery form
+            Residue to(const MPI & a) const;
+            MPI from(const Residue & a) const;
+
+            // R mod m, the Montgomery form of 1
+            Residue one() const;
+
+            // scratch must have space for 2 * size() limbs
+            // out may alias the inputs
+            void mul(mp_limb_t * out, const mp_limb_t * a, const mp_limb_t * b, mp_limb_t * scratch) const;
+            void sqr(mp_limb_t * out, const mp_limb_t * a, mp_limb_t * scratch) const;
+    };
+
+    // table of odd powers {b, b^3, b^5, ..., b^(2^w - 1)} for sliding window exponentiation
+    class WindowTable {
+        private:
+            Montgomery ctx;
+            unsigned int window;
+            std::vector <Montgomery::Residue> odd;
+
+        public:
+            WindowTable(const MPI & base, const MPI & mod, const unsigned int w = 0);
+            WindowTable(const MPI & base, const Montgomery & mont, const unsigned int w = 0);
+
+            const Montgomery & get_ctx() const;
+            unsigned int get_window() const;
+            const Montgomery::Residue & get(const unsigned int digit) const; // digit must be odd
+    };
+
+    // Lim-Lee comb table of a fixed base for exponents of up to bits bits
+    // entry j is the product of b^(2^(i * spacing)) for every bit i set in j
+    class CombTable {
+        private:
+            Montgomery ctx;
+            std::size_t bits;
+            unsigned int teeth;
+            std::size_t spacing;
+            std::vector <Montgomery::Residue> table;
+
+        public:
+            CombTable(const MPI & base, const MPI & mod, const std::size_t bits, const unsigned int teeth = 6);
+            CombTable(const MPI & base, const Montgomery & mont, const std::size_t bits, const unsigned int teeth = 6);
+
+            const Montgomery & get_ctx() const;
+            std::size_t get_bits() const;
+            unsigned int get_teeth() const;
+            std::size_t get_spacing() const;
+
+            // copy entry index into out without the memory access pattern depending on index
+            void select(mp_limb_t * out, const std::size_t index) const;
+    };
+
+    // window size for an exponent of the given length
+    unsigned int window_size(const std::size_t bits);
+
+    // base ^ exp mod m
+    // Only use these for public values, since the running time
+    // depends on the exponents
+    MPI powm(const WindowTable & base, const MPI & exp);
+
+    // a ^ x * b ^ y mod m using a single shared chain of squarings (Shamir's trick)
+    // both tables must have the same modulus
+    MPI powm(const WindowTable & a, const MPI & x, const WindowTable & b, const MPI & y);
+
+    // base ^ exp mod m, for secret exponents 0 <= exp < 2^base.get_bits()
+    // the sequence of operations and memory accesses does not depend on exp
+    MPI powm_sec(const CombTable & base, const MPI & exp);
+}
+
+#endif
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #define __MPI__
 
 #include <cstddef>
+#include <string>
 
 #include <gmpxx.h>
 
@@ -34,11 +35,13 @@ namespace OpenPGP {
     typedef mpz_class MPI;
 
     MPI rawtompi(const std::string & raw);
+    MPI rawtompi(const char * raw, const std::size_t size);
     MPI hextompi(const std::string & hex);
     MPI dectompi(const std::string & dec);
     MPI bintompi(const std::string & bin);
 
     std::string mpitoraw(const MPI & a);
+    std::size_t mpitoraw(const MPI & a, char * out);                         // out must have space for bytesize(a) octets; returns the number of octets written
     std::string mpitohex(const MPI & a);
     std::string mpitodec(const MPI & a);
     std::string mpitobin(const MPI & a);
@@ -46,6 +49,7 @@ namespace OpenPGP {
     unsigned long mpitoulong(const MPI & a);
 
     std::size_t bitsize(const MPI & a);
+    std::size_t bytesize(const MPI & a);
 
     bool knuth_prime_test(const MPI & a, int test);
 
@@ -58,6 +62,8 @@ namespace OpenPGP {
     MPI random(unsigned int bits);
 
     std::string write_MPI(const MPI & data);                                 // given some value, return the formatted mpi
+    void write_MPI(const MPI & data, std::string & out);                     // append the formatted mpi to out
+    std::size_t write_MPI(const MPI & data, char * out);                     // out must have space for 2 + bytesize(data) octets; returns the number of octets written
     MPI read_MPI(const std::string & data, std::string::size_type & pos);    // remove mpi from data, returning mpi value. the rest of the data will be returned through pass-by-reference
 
 }
@@ -94,7 +94,7 @@ namespace OpenPGP {
 
     const unsigned int MAX_LINE_LENGTH = 64;
 
-    std::string ascii2radix64(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string ascii2radix64(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
     // 6.4.  Decoding Radix-64
     //
@@ -111,7 +111,7 @@ namespace OpenPGP {
     //    transmitted was a multiple of three and no "=" characters are
     //    present.
 
-    std::string radix642ascii(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string radix642ascii(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
 }
 
@@ -29,7 +29,13 @@ THE SOFTWARE.
 #include "DetachedSignature.h"     // Detached Signatures
 #include "Key.h"                   // Transferable Keys
 #include "Message.h"               // OpenPGP Messages
+#include "PacketReader.h"          // Packets pulled from a stream one at a time
+#include "PacketWriter.h"          // Packets pushed into a stream as they are produced
+#include "PreparedKey.h"           // Keys prepared for repeated use
 #include "RevocationCertificate.h" // OpenPGP Messages
+#include "VerifyCache.h"           // Cached verification results
+#include "common/Arena.h"          // Arena allocation for parsed packets
+#include "common/MappedFile.h"     // Memory mapped input files
 
 // OpenPGP Functions
 #include "decrypt.h"               // decrypt stuff
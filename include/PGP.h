@@ -33,6 +33,7 @@ THE SOFTWARE.
 
 #include "Misc/radix64.h"
 #include "Packets/Packets.h"
+#include "common/Arena.h"
 #include "common/HumanReadable.h"
 
 namespace OpenPGP {
@@ -65,18 +66,39 @@ namespace OpenPGP {
             typedef std::vector <Armor_Key> Armor_Keys;
             typedef std::vector <Packet::Tag::Ptr> Packets;
 
+            // location of a packet inside the binary data it was read from
+            struct Index_Entry {
+                std::string::size_type offset;              // position of the packet header
+                uint8_t tag;
+                Packet::HeaderFormat format;
+                std::string::size_type length;              // length of the packet body (all pieces if partial)
+                Packet::PartialBodyLength partial;
+            };
+
+            typedef std::vector <Index_Entry> Index;
+
         protected:
+            friend class PacketReader;                      // parses packets with read_packet_raw
+
             bool armored;                                   // default true
             Type_t type;                                    // what type of key is this
             Armor_Keys keys;                                // key-value pairs in the ASCII header
-            Packets packets;                                // main data
+            mutable Packets packets;                        // main data; entries are nullptr until parsed when read lazily
+
+            bool lazy;                                      // only index packet headers when reading
+            Index index;                                    // headers of lazily read packets; empty if packets were parsed eagerly
+            mutable std::shared_ptr <const std::string> source; // binary data the index refers to; released once every packet is parsed
+
+            bool use_arena;                                 // place parsed packets and subpackets in one Arena
+            mutable Arena::Ptr arena;                       // arena of the last read; kept alive by its packets as well
 
             // reads the data starting at pos, and gets the ctb, format, and tag
             // pos is shifted up by 1
             uint8_t read_packet_header(const std::string & data, std::string::size_type & pos, uint8_t & ctb, Packet::HeaderFormat & format, uint8_t & tag) const;
 
             // reads the length of the packet data and extracts the start and length of the packet data
-            // if partial returns Packet::PARTIAL, the partial_data variable should be used instead of data
+            // if partial returns Packet::PARTIAL and partial_data is not empty, partial_data holds the
+            // joined body and should be used instead of data; otherwise the body is still inside data
             Packet::PartialBodyLength read_packet_unformatted(const Packet::HeaderFormat format, const uint8_t ctb, const std::string & data, std::string::size_type & pos, std::string::size_type & packet_start, std::string::size_type & packet_length, std::string & partial_data) const;
 
             // parses raw packet data
@@ -85,6 +107,12 @@ namespace OpenPGP {
             // parse packet with header; wrapper for read_packet_header and read_packet_unformatted
             Packet::Tag::Ptr read_packet(const std::string & data, std::string::size_type & pos) const;
 
+            // reads only the header of the packet at pos and moves pos past its body
+            Index_Entry index_packet(const std::string & data, std::string::size_type & pos) const;
+
+            // parse every packet that has only been indexed so far
+            void parse_all() const;
+
             // modifies output string so each line is no longer than MAX_LINE_SIZE long
             std::string format_string(const std::string & data, const uint8_t line_length = MAX_LINE_LENGTH) const;
 
@@ -97,6 +125,10 @@ namespace OpenPGP {
             PGP(std::istream & stream);
             virtual ~PGP();
 
+            // Read a file through a read-only memory map
+            // throws std::runtime_error if the file cannot be opened
+            static PGP from_file(const std::string & path);
+
             // Read ASCII Header + Base64 data
             // all of the input will be considered valid for processing
             void read(const std::string & data);
@@ -104,6 +136,8 @@ namespace OpenPGP {
 
             // Read Binary data
             // all of the input will be considered valid for processing
+            // if lazy is set, only the packet headers are read here and
+            // each packet is parsed the first time it is accessed
             virtual void read_raw(const std::string & data);
             void read_raw(std::istream & stream);
 
@@ -119,11 +153,22 @@ namespace OpenPGP {
             bool get_armored()              const;
             Type_t get_type()               const;
             const Armor_Keys & get_keys()   const;
+            bool get_lazy()                 const;
+            bool get_use_arena()            const;
+            Arena::Ptr get_arena()          const;          // arena used by the last read; nullptr unless set_use_arena(true)
+            const Index & get_index()       const;          // packet headers found by a lazy read; does not parse anything
+            Packets::size_type size()       const;          // number of packets; does not parse anything
+            uint8_t get_tag(const Packets::size_type i) const;                  // tag of packet i; does not parse anything
+            // get_packet and get_packets parse lazily read packets on first use, which
+            // changes this object; call get_packets() once before sharing it between threads
+            const Packet::Tag::Ptr & get_packet(const Packets::size_type i) const; // parses only packet i if it was read lazily
             const Packets & get_packets()   const;          // get copy of all packet pointers (for looping through packets)
             Packets get_packets_clone()     const;          // clone all packets (for modifying packets)
 
             // Modifiers
             void set_armored(const bool a);
+            void set_lazy(const bool l);                    // affects subsequent reads only
+            void set_use_arena(const bool a);               // affects subsequent reads only
             void set_type(const Type_t t);
             void set_keys(const Armor_Keys & keys);
             void set_packets(const Packets & p);            // copies the the input packet pointers
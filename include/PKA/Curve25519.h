@@ -0,0 +1,66 @@
+/*
+Curve25519.h
+Ed25519 (RFC 8032) and X25519 (RFC 7748)
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __PKA_CURVE25519__
+#define __PKA_CURVE25519__
+
+#include <string>
+#include <vector>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Curve25519 {
+            // all keys, points, scalars and shared secrets are 32 octets,
+            // little endian, as in the RFCs; functions that fail return an
+            // empty string
+            constexpr std::size_t SIZE = 32;
+
+            // Diffie-Hellman function; scalar is clamped before use
+            // Returns an empty string if the result is all zeros
+            std::string x25519(const std::string & scalar, const std::string & u);
+
+            // X25519 public key of scalar (u = 9)
+            std::string x25519_base(const std::string & scalar);
+
+            // Public key A of a 32 octet private key (seed)
+            std::string ed25519_public(const std::string & seed);
+
+            // 64 octet signature R || S of message
+            std::string ed25519_sign(const std::string & message, const std::string & seed, const std::string & pub);
+
+            // Signatures are checked with the cofactored equation
+            // [8][S]B = [8]R + [8][k]A, so a signature that passes
+            // alone also passes in a batch and vice versa
+            bool ed25519_verify(const std::string & message, const std::string & sig, const std::string & pub);
+
+            // Check several signatures with one multi-scalar multiplication
+            // over a random linear combination of their equations
+            // Returns true only if every signature is valid
+            bool ed25519_verify(const std::vector <std::string> & messages, const std::vector <std::string> & sigs, const std::vector <std::string> & pubs);
+        }
+    }
+}
+
+#endif
@@ -26,11 +26,16 @@ THE SOFTWARE.
 #ifndef __DSA__
 #define __DSA__
 
+#include <memory>
+
 #include "RNG/RNGs.h"
 #include "common/includes.h"
+#include "Misc/montgomery.h"
 #include "Misc/mpi.h"
 #include "Misc/pgptime.h"
 #include "PKA.h"
+#include "PKA/DSA_Const.h"
+#include "PKA/Pool.h"
 
 namespace OpenPGP {
     namespace PKA {
@@ -38,6 +43,10 @@ namespace OpenPGP {
             // Generate new set of parameters
             Values new_public(const uint32_t & L = 2048, const uint32_t & N = 256);
 
+            // Get a set of pre-validated parameters {p, q, g}
+            // Returns an empty set if (L, N) is not in STANDARD_DOMAIN_PARAMETERS
+            Values standard_public(const uint32_t & L = 2048, const uint32_t & N = 256);
+
             // Generate new keypair with parameters
             Values keygen(Values & pub);
 
@@ -45,9 +54,40 @@ namespace OpenPGP {
             Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k = 0);
             Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k = 0);
 
+            // Message independent part of a signature
+            // Each presignature must only be used once
+            struct Presignature {
+                MPI r;                          // (g^k mod p) mod q
+                MPI kinv;                       // k^-1 mod q
+            };
+
+            // Generate a presignature with a random k
+            Presignature presign(const Values & pub);
+
+            // Sign hash of data with a presignature
+            // Returns an empty set if s would be 0; use another presignature
+            Values sign(const MPI & data, const Values & pri, const Values & pub, const Presignature & pre);
+
+            // Presignatures made in the background for one set of public values
+            class PresignaturePool : public Pool <Presignature> {
+                public:
+                    PresignaturePool(const Values & pub, const std::size_t capacity = 64);
+            };
+
+            // Sign hash of data with presignatures from a pool
+            Values sign(const MPI & data, const Values & pri, const Values & pub, PresignaturePool & pool);
+            Values sign(const std::string & data, const Values & pri, const Values & pub, PresignaturePool & pool);
+
             // Verify signature on hash
             bool verify(const MPI & data, const Values & sig, const Values & pub);
             bool verify(const std::string & data, const Values & sig, const Values & pub);
+
+            // Odd powers of g, shared by every key in the domain (p, g)
+            // Returns nullptr if p is not an odd number greater than 2
+            std::shared_ptr <const WindowTable> domain_table(const MPI & p, const MPI & g);
+
+            // Verify signature on hash with the odd powers of g and y modulo p
+            bool verify(const MPI & data, const Values & sig, const Values & pub, const WindowTable & g, const WindowTable & y);
         }
     }
 }
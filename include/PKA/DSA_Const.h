@@ -0,0 +1,159 @@
+/*
+DSA_Const.h
+Standard DSA domain parameters
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __DSA_CONST__
+#define __DSA_CONST__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace DSA {
+            // Pre-validated (L, N) domain parameters
+            //
+            // Generated with FIPS 186-4 A.1.1.2 (SHA-256), with g generated
+            // by the verifiable canonical method of A.2.3 (index = 1).
+            // The domain parameter seed and counter are kept so that the
+            // parameters can be validated with A.1.1.3 and A.2.4.
+            struct DomainParameters {
+                uint32_t     L;
+                uint32_t     N;
+                const char * p;         // hex
+                const char * q;         // hex
+                const char * g;         // hex
+                const char * seed;      // hex
+                uint32_t     counter;
+            };
+
+            constexpr DomainParameters STANDARD_DOMAIN_PARAMETERS[] = {
+                {
+                    1024, 160,
+                    "8AFBF3274D25F8AC9756362439AEE833A3EF5530C59FB895447F90B0AA2414EF"
+                    "FD8B44C8DC2707665523B53AE2B1F3176F97ED9CBF670BD76EF1FD0D87556707"
+                    "C1D082C45D973EB431DBDEB4B43F91BA34896380A09DE896EB88D4B3B30FB4AD"
+                    "1FEEF22CF750C441AFD2A334AE7A9EDC444A3AF55BAE7154BDB58A52556700C3",
+
+                    "EAEDEECF99B41EF11A1B100EF839DD55D6033E01",
+
+                    "9C4B1CE5964CAAEE3A15DEC1AD57E3D1485F778280624BDB5DCFDF45A0B1D555"
+                    "2E8ED36EA03670A6DE9A2B555B1D1FB111DD6579DC2D83B485F8D0D3405002A1"
+                    "C7FF2599F8F96AC24A3A69ECC6085F4F9EB07E4823A750D34E31BD9F969984C1"
+                    "9D9F52FFF558C0E5D35DE4199431F72766752A96F8FE538E22665F799AF65AE",
+
+                    "CC44744235DBBD77937E573612F26DE884F009C4",
+                    72
+                },
+                {
+                    2048, 224,
+                    "B68916CC3179D036419F0F89220905322830EAB57F8083F6A84B20A4B6451C71"
+                    "BFBE27745B9491FA8105FC3C299BCD669376B6A8634D977DB523714953205532"
+                    "D2225CE69808D59CDEC66A9F32E580097531649152569DD1C26FE4F5326711CE"
+                    "8ED84D21CE2B931C1AE6D8F07E82230618E70F01C3A6555F8EBE57E372CF0F33"
+                    "60E13BF6B45D5F15A303E05E153201CFFFEBD6AB4B5EB0125945928523345846"
+                    "416C9F924918961CE3F71820D31C15A014F1E8265A429DA47FE77CA354A26595"
+                    "0AC83ADBBE34F9EED5DC9ED92B93F8B4F1F5EDE025FD4E9FBE0380683C6DA0A3"
+                    "2CFA02C2465DE3FDC6F16FB71AA7C3919A97675462954DC6D7B030D8FE5E2605",
+
+                    "BFA63EC5FF6A3129747CE1DC7E46796C517690CA2E366457F2869649",
+
+                    "3C62F5A32191A9A30EB54958F65F949F579E0224E378C95476B426505A82A8FB"
+                    "D69BD82C45DADD0B0C2C89F55AE316CA6869C7FFE9C4D59F34BCAE739B335B39"
+                    "472BE8867EA0FCEB3D90926760087F51B7F1C555582A1A068B67F8E7C8F95A5F"
+                    "C3EA486D367419E286B3EEBA63CED00C1B3CBA77D0C172A28CD849AC43CCB9CF"
+                    "AD2DDA23B32230473EC5A191025538A290F89C6A1D6410F5A8275C0834E4CAC0"
+                    "471AFF3082264BE3D6B06DE2DEF5F60350D0AECBC41910544640F4A59AC19C0E"
+                    "E9F28C55DF4C2E31B80826F826FBFDBE5C92E3734E271AB773684B6DF81AC74D"
+                    "6D09265699849127815C9F161105E34480493D9F618B28BB1C5895D7AE999E12",
+
+                    "C0CFBF444E4054C9FA90FF023F5FAE417623DB368FB7A9D7BDF029F8",
+                    271
+                },
+                {
+                    2048, 256,
+                    "962FFE2091E30AEE327FAB131B03096F60D16E68834895AD12C0B5A8380ABB85"
+                    "C43C411AFA0E8F562CB8EDF04C177E08ACF009F8A8EA7149E3491C68EBC0D351"
+                    "86E1472A3BE2588FC725B246C1800CB5349ECE4A8D87A4554528DEC4E3476684"
+                    "3A108CF78408E77A9CDC9D398A7C0F9D20BD06C6459C94F46B1DF832AE768D8E"
+                    "54476E716B0885D825ECDBD3CB45830A2522922E5E54DB646CE45FBC7AF9FCBC"
+                    "9FDE4BF64779BD5993263947665007F9DE9F3B5645566BB8365758367B5A8F2C"
+                    "B06BCB8B45E86E9BAFF81A4AF55D082D24539A6110EF26AE6B0F4402F5BC9524"
+                    "5CCFB09966918519748B182B9BC99106CC044F6EA9D7A7F32EB685E593EB0FAF",
+
+                    "92DB2822CBC7EF773ED3612F8238F43364C3AA304F039F6322F3293C3AAF397D",
+
+                    "57873B405FEBF009F53EEE6764FE873F661249DC28874A4438E91847A0DB50D7"
+                    "26339C04DA920516D6211808B3B7D45FC6A34E8FCEF22881A64A03B18EFCCC5F"
+                    "2133C1F003CA1B32385B524015D38A5595D5B248D5F7F351DC8FDA77CD97D9E2"
+                    "77A0D69A5D69E39F4DC22A3E3647AA3C133EF1BEC42E35BC7072DA567D626892"
+                    "BD3D7A605F350353FD39B8114D392FCF9896E35D2A8509A0F3B07350628566A6"
+                    "FE7EF2BF4CB8D65A2E32FFBD385AE6867E614C92ABDDAB48815EF18AF966C4E7"
+                    "DD513576B611012D8F173E070741FF578BC71C34789E35C2974495F047B017F6"
+                    "96D8910C2D63096B4AE54E4772F8B964AD4E84CE1B9BB08C977ECBA067DBC842",
+
+                    "DF63CFBD1FB6CBBA20BFAACB34D2705FB97B83C1E930C5758CB8FA2BA2BC6930",
+                    1332
+                },
+                {
+                    3072, 256,
+                    "C8F173E5F1B5AA7CBE257338C5A8B9F10B986866DA979667047A97CB8FB53C5C"
+                    "11D5F5B935FD8E81238A2529420FDB2055D5822792200C19AA80919E854F6748"
+                    "C1A5C6174B18541CBD343D42CC72FCBC4F193F46341E9E79A9D2FD4768F12B09"
+                    "2BE1478309524EF78EA1DCE93E825D29FFC84B33D3E8FA1276B18C461F341FF5"
+                    "F6DEE01F425936C27FC10B81D3D77774674056017FB8B62C134E8233BF11B717"
+                    "1EE55A2E61B951E1ECE770FDB5CE320DECE35380A1D06D6F404B38FE8E510718"
+                    "B133AF60C72156502B4903A78FDC0671703C976E6D43F2A6BD4E221244280D1F"
+                    "C2E99029F4D9431872AFD9D0ABB9842FF6DC4603797D37C4B0E0B313EAE95D50"
+                    "134CA27001E0C338FCC688349EB08C58801144CC3D55394DEEE5DB1021825E78"
+                    "DBC7C3F9115913D7D6FABAE1FCADA24EB968E8F4C107A426B016D8345FC74EE3"
+                    "471521B0D56F7D8CF8DA7E0951280AB9257728DC8AA9606477358C0C8E055340"
+                    "6DBE2638FD9BFF6B71AC214AC33B4B98F5BD2B617E6760E8291A53BB8BA97809",
+
+                    "BEF7847520973707FB030DBE9D1428FB514BD3E3DDB6D57D51A8615304719C3F",
+
+                    "9A962F84C7987212AF93CA031CB8B3E49DFAF9B568FE9340D3088AD3C6B52159"
+                    "B1BF43D0B4566CED4E0DA615FE250EB360BEED080B1D5936794DB9AC6E6BA801"
+                    "994C652B57827E13B3E61E728ABC1B5DF1F8F83A86C53ADCCD8B5F49BBBCE74D"
+                    "2C17AF1F902D8B474BDA149A5A07F7A83BBD30F2373B225AADF50D4D33BDF754"
+                    "E23B82CDE63D1AF55E6AE5899F594A0FDC0F93B450B01464C6791A7B80084CB4"
+                    "B6DAB2B106392EFABBDCE0C739C3FF96A58FDA72E5BC0F8FC2FFACB465DEE0A1"
+                    "EA5B8B824580B3562227272D8EE70735A8751872D1AE2C7AD763BD75033FFB0F"
+                    "F531A3AD55A81C862AE166FC6BC1BE17115CE0AAA2CA8FE7798B91F7FD60C0FF"
+                    "523B9938A923411A4B04B763D453C3E1278E5B0084792D08A052E431E3850C6A"
+                    "AD25629D6EE8A01C5335C9383FF5EDCEBB383334E96A710554B3C0CD64C0DB3E"
+                    "671D4F2ECE1EA637368205C17701F3CF4A029EACE9120CD7B67F811C2DCDD44D"
+                    "654323018F2E9DF5259E9DFA3BC23C51D9BE9E0FD4126522790E0F4CAF80E42D",
+
+                    "A03EDCFDFDF7CF2819015F8BB630D37F9FD9039FD2D5FA82FAA855086F3F201D",
+                    75
+                }
+            };
+
+            constexpr std::size_t STANDARD_DOMAIN_PARAMETERS_COUNT = sizeof(STANDARD_DOMAIN_PARAMETERS) / sizeof(DomainParameters);
+        }
+    }
+}
+
+#endif
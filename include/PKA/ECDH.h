@@ -0,0 +1,67 @@
+/*
+ECDH.h
+ECDH (X25519) session key wrapping as used by OpenPGP
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDH__
+#define __ECDH__
+
+#include <string>
+
+#include "Misc/mpi.h"
+#include "PKA.h"
+#include "PKA/Curve25519.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDH {
+            // Only Curve25519 is supported
+            //
+            //     public key: {0x40 || u}
+            //     secret key: {k}, the X25519 scalar in big endian order
+            //
+            // RFC 6637 13. The encrypted session key is the MPI
+            // of the ephemeral point followed by the wrapped key
+
+            // Generate new keypair {0x40 || u, k}
+            Values keygen();
+
+            // RFC 6637 8. Key Derivation Function parameters
+            std::string kdf_param(const std::string & curve, const uint8_t hash, const uint8_t sym, const std::string & fingerprint);
+
+            // RFC 3394 AES Key Wrap; data is a multiple of 8 octets
+            // unwrap returns an empty string if the integrity check fails
+            std::string key_wrap(const uint8_t sym, const std::string & kek, const std::string & data);
+            std::string key_unwrap(const uint8_t sym, const std::string & kek, const std::string & data);
+
+            // Wrap m (symmetric algorithm, session key, checksum) to pub
+            // Returns {0x40 || V} and puts the wrapped key into wrapped
+            Values encrypt(const std::string & m, const Values & pub, const std::string & param, const uint8_t hash, const uint8_t sym, std::string & wrapped);
+
+            // Unwrap m; returns an empty string on failure
+            std::string decrypt(const MPI & ephemeral, const std::string & wrapped, const Values & pri, const std::string & param, const uint8_t hash, const uint8_t sym);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ECDSA.h
+ECDSA over the NIST prime curves
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDSA__
+#define __ECDSA__
+
+#include <string>
+#include <vector>
+
+#include "Misc/mpi.h"
+#include "PKA.h"
+#include "PKA/ECDSA_Const.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDSA {
+            // NIST P-256 and P-384
+            //
+            //     public key: {0x04 || X || Y}
+            //     secret key: {d}
+            //     signature:  {r, s}
+            //
+            // The curve is identified by the length of the public point.
+            // Digests longer than the group order are truncated to its
+            // bit length (FIPS 186-4 6.4).
+
+            // Generate new keypair {0x04 || X || Y, d} on a curve given by its OID (hex)
+            Values keygen(const std::string & curve);
+
+            // Sign hash of data; k is only for testing
+            Values sign(const std::string & digest, const Values & pri, const Values & pub, MPI k = 0);
+
+            // Verify signature on hash
+            bool verify(const std::string & digest, const Values & sig, const Values & pub);
+
+            // Verify several signatures, sharing one inversion modulo n
+            // for all of the s values and one field inversion for all
+            // of the public key tables of each curve
+            // Returns one result per signature
+            std::vector <bool> verify(const std::vector <std::string> & digests, const std::vector <Values> & sigs, const std::vector <Values> & pubs);
+        }
+    }
+}
+
+#endif
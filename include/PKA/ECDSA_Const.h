@@ -0,0 +1,75 @@
+/*
+ECDSA_Const.h
+NIST prime curves for ECDSA
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDSA_CONST__
+#define __ECDSA_CONST__
+
+#include <cstddef>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDSA {
+            // Short Weierstrass curves y^2 = x^3 - 3x + b over GF(p)
+            // with prime order n and cofactor 1 (FIPS 186-4 D.1.2)
+            struct CurveParameters {
+                const char * oid;       // hex, as in CURVE_OID
+                std::size_t  bits;
+                const char * p;         // hex
+                const char * b;         // hex
+                const char * n;         // hex
+                const char * gx;        // hex
+                const char * gy;        // hex
+            };
+
+            constexpr CurveParameters CURVES[] = {
+                {
+                    "2A8648CE3D030107", 256,            // P-256
+                    "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+                    "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B",
+                    "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551",
+                    "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296",
+                    "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5",
+                },
+                {
+                    "2B81040022", 384,                  // P-384
+                    "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE"
+                    "FFFFFFFF0000000000000000FFFFFFFF",
+                    "B3312FA7E23EE7E4988E056BE3F82D19181D9C6EFE8141120314088F5013875A"
+                    "C656398D8A2ED19D2A85C8EDD3EC2AEF",
+                    "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC7634D81F4372DDF"
+                    "581A0DB248B0A77AECEC196ACCC52973",
+                    "AA87CA22BE8B05378EB1C71EF320AD746E1D3B628BA79B9859F741E082542A38"
+                    "5502F25DBF55296C3A545E3872760AB7",
+                    "3617DE4A96262C6F5D9E98BF9292DC29F8F41DBD289A147CE9DA3113B5F0B8C0"
+                    "0A60B1CE1D7E819D7A431D7C90EA0E5F",
+                },
+            };
+
+            constexpr std::size_t CURVES_COUNT = sizeof(CURVES) / sizeof(CurveParameters);
+        }
+    }
+}
+
+#endif
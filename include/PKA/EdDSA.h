@@ -0,0 +1,65 @@
+/*
+EdDSA.h
+EdDSA (Ed25519) signatures as used by OpenPGP
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __EdDSA__
+#define __EdDSA__
+
+#include <string>
+#include <vector>
+
+#include "Misc/mpi.h"
+#include "PKA.h"
+#include "PKA/Curve25519.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace EdDSA {
+            // Only Ed25519 is supported
+            //
+            //     public key: {0x40 || A}
+            //     secret key: {private key (seed)}
+            //     signature:  {R, S}
+            //
+            // R, S and the seed are 32 octet strings stored as MPIs,
+            // so leading zeros are dropped and have to be put back
+
+            // Generate new keypair {0x40 || A, seed}
+            Values keygen();
+
+            // Sign hash of data
+            Values sign(const std::string & digest, const Values & pri, const Values & pub);
+
+            // Verify signature on hash
+            bool verify(const std::string & digest, const Values & sig, const Values & pub);
+
+            // Verify several signatures with one combined check
+            // Returns one result per signature; if the combined
+            // check fails, each signature is checked on its own
+            std::vector <bool> verify(const std::vector <std::string> & digests, const std::vector <Values> & sigs, const std::vector <Values> & pubs);
+        }
+    }
+}
+
+#endif
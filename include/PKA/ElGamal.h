@@ -26,8 +26,11 @@ THE SOFTWARE.
 #ifndef __ELGAMAL__
 #define __ELGAMAL__
 
+#include "Misc/montgomery.h"
 #include "Misc/mpi.h"
+#include "PKA/ElGamal_Const.h"
 #include "PKA/PKA.h"
+#include "PKA/Pool.h"
 
 namespace OpenPGP {
     namespace PKA {
@@ -35,10 +38,45 @@ namespace OpenPGP {
             // Generate ElGamal key values
             Values keygen(unsigned int bits = 2048);
 
+            // Get a pre-validated group {p, g}
+            // Returns an empty set if there is no MODP group of the given size
+            Values standard_group(const unsigned int bits = 2048);
+
+            // Generate ElGamal key values using a standard group
+            // Only the secret exponent is generated
+            Values keygen_standard(const unsigned int bits = 2048);
+
             // Encrypt data
             Values encrypt(const MPI & data, const PKA::Values & pub);
             Values encrypt(const std::string & data, const PKA::Values & pub);
 
+            // Message independent part of an encryption
+            // Each ephemeral pair must only be used once
+            struct Ephemeral {
+                MPI gk;                         // g^k mod p
+                MPI yk;                         // y^k mod p
+            };
+
+            // Generate an ephemeral pair with a random k
+            Ephemeral ephemeral(const PKA::Values & pub);
+
+            // Generate an ephemeral pair with the comb tables of g and y
+            // Both tables must cover exponents of bitsize(p) bits
+            Ephemeral ephemeral(const PKA::Values & pub, const CombTable & g, const CombTable & y);
+
+            // Encrypt data with an ephemeral pair
+            Values encrypt(const MPI & data, const PKA::Values & pub, const Ephemeral & eph);
+
+            // Ephemeral pairs made in the background for one recipient
+            class EphemeralPool : public Pool <Ephemeral> {
+                public:
+                    EphemeralPool(const PKA::Values & pub, const std::size_t capacity = 64);
+            };
+
+            // Encrypt data with ephemeral pairs from a pool
+            Values encrypt(const MPI & data, const PKA::Values & pub, EphemeralPool & pool);
+            Values encrypt(const std::string & data, const PKA::Values & pub, EphemeralPool & pool);
+
             // Decrypt data
             std::string decrypt(const PKA::Values & c, const PKA::Values & pri, const PKA::Values & pub);
         }
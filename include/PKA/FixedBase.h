@@ -0,0 +1,55 @@
+/*
+FixedBase.h
+Cache of fixed-base exponentiation tables
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __PKA_FIXED_BASE__
+#define __PKA_FIXED_BASE__
+
+#include <memory>
+
+#include "Misc/montgomery.h"
+#include "Misc/mpi.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        // number of (base, mod) pairs that are tracked
+        constexpr std::size_t FIXED_BASE_CACHE_SIZE = 32;
+
+        // Get the comb table of base for exponents of up to bits bits
+        //
+        // Tables are only built once a base has been used more than once,
+        // so one-off operations do not pay for the precomputation.
+        // Returns nullptr if there is no table yet, or the modulus is not
+        // usable, in which case the caller should use powm.
+        std::shared_ptr <const CombTable> fixed_base(const MPI & base, const MPI & mod, const std::size_t bits);
+
+        // base ^ exp mod m, using the cached table of base if there is one
+        MPI fixed_base_powm(const MPI & base, const MPI & exp, const MPI & mod, const std::size_t bits);
+
+        // drop all cached tables
+        void clear_fixed_base();
+    }
+}
+
+#endif
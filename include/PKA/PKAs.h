@@ -29,6 +29,9 @@ THE SOFTWARE.
 #include <map>
 
 #include "PKA/DSA.h"
+#include "PKA/ECDH.h"
+#include "PKA/ECDSA.h"
+#include "PKA/EdDSA.h"
 #include "PKA/ElGamal.h"
 #include "PKA/PKA.h"
 #include "PKA/RSA.h"
@@ -172,11 +175,16 @@ namespace OpenPGP {
                 DSA = {L, N}
                 ELGAMAL = {bits}
                 RSA = {bits}
+                ECDH, EdDSA = {bits} (ignored; always Curve25519)
 
             pub and pri are destination containers
+
+            if standard is set, DSA and ElGamal keys use the pre-validated
+            groups in DSA_Const.h and ElGamal_Const.h instead of generating
+            new ones, failing if there is no group of the requested size
         */
         Params generate_params(const uint8_t pka, const std::size_t bits);
-        uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub);
+        uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub, const bool standard = false);
     }
 }
 
@@ -0,0 +1,140 @@
+/*
+Pool.h
+Background precomputation of single-use values
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __PKA_POOL__
+#define __PKA_POOL__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace OpenPGP {
+    namespace PKA {
+        // Keeps up to capacity values made by a generator, refilled by a
+        // background thread. Each value is handed out exactly once.
+        // The generator must be safe to call from multiple threads.
+        // If it throws on the background thread, refilling stops and the
+        // exception is rethrown by the next take() that finds no values.
+        template <typename T>
+        class Pool {
+            public:
+                typedef std::function <T ()> Generator;
+
+            private:
+                Generator generate;
+                std::size_t capacity;
+
+                std::deque <T> values;
+                mutable std::mutex mutex;
+                std::condition_variable taken;
+                bool stop;
+                std::exception_ptr error;               // thrown by the generator on the worker
+
+                std::thread worker;                     // started last
+
+                void run() {
+                    std::unique_lock <std::mutex> lock(mutex);
+                    while (!stop) {
+                        if (values.size() >= capacity) {
+                            taken.wait(lock);
+                            continue;
+                        }
+
+                        lock.unlock();
+                        try {
+                            T value = generate();
+                            lock.lock();
+                            values.push_back(std::move(value));
+                        }
+                        catch (...) {
+                            lock.lock();
+                            error = std::current_exception();
+                            return;
+                        }
+                    }
+                }
+
+            public:
+                Pool(const Generator & gen, const std::size_t cap = 64)
+                    : generate(gen),
+                      capacity(cap),
+                      values(),
+                      mutex(),
+                      taken(),
+                      stop(false),
+                      error(),
+                      worker(&Pool::run, this)
+                {}
+
+                Pool(const Pool &) = delete;
+                Pool & operator=(const Pool &) = delete;
+
+                virtual ~Pool() {
+                    {
+                        std::lock_guard <std::mutex> lock(mutex);
+                        stop = true;
+                    }
+                    taken.notify_all();
+                    worker.join();
+                }
+
+                // remove a precomputed value
+                // if none are ready, one is generated on the calling thread
+                // a failure of the background thread is rethrown once, after which
+                // every value is generated on the calling thread
+                T take() {
+                    {
+                        std::lock_guard <std::mutex> lock(mutex);
+                        if (values.size()) {
+                            T value = std::move(values.front());
+                            values.pop_front();
+                            taken.notify_one();
+                            return value;
+                        }
+
+                        if (error) {
+                            std::exception_ptr e = error;
+                            error = nullptr;
+                            std::rethrow_exception(e);
+                        }
+                    }
+
+                    return generate();
+                }
+
+                // number of values ready to be taken
+                std::size_t size() const {
+                    std::lock_guard <std::mutex> lock(mutex);
+                    return values.size();
+                }
+        };
+    }
+}
+
+#endif
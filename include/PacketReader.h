@@ -0,0 +1,132 @@
+/*
+PacketReader.h
+Incremental packet reader for streams
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PACKET_READER__
+#define __OPENPGP_PACKET_READER__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Packets/Packet.h"
+#include "Packets/PartialBodyLengthEnums.h"
+
+namespace OpenPGP {
+    // Pulls packets out of a stream one at a time
+    //
+    // Only the header of the current packet is read by next(). Its body
+    // can then be parsed into a packet object with packet(), or read in
+    // pieces through read() or body() without ever holding all of it.
+    // Partial body lengths and old format indeterminate lengths are
+    // followed as the body is read, so large data packets (Tags 8, 9,
+    // 11, and 18) never have to fit in memory.
+    //
+    //     PacketReader reader(file);
+    //     while (reader.next()) {
+    //         if (reader.get_tag() == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA) {
+    //             std::istream & body = reader.body();
+    //             ...
+    //         }
+    //         else {
+    //             Packet::Tag::Ptr packet = reader.packet();
+    //             ...
+    //         }
+    //     }
+    class PacketReader {
+        public:
+            static const std::size_t DEFAULT_BUFFER_SIZE = 1 << 16;
+
+        private:
+            // streambuf over the body of the current packet
+            class Body : public std::streambuf {
+                private:
+                    PacketReader & reader;
+                    std::vector <char> buffer;
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    Body(PacketReader & r, const std::size_t buffer_size);
+                    void reset();
+            };
+
+            std::istream & in;
+            uint64_t offset;                        // octets consumed from in
+
+            bool started;                           // next() has found a packet
+            uint8_t tag;
+            Packet::HeaderFormat format;
+            Packet::PartialBodyLength partial;
+            uint64_t header_offset;                 // where the current packet starts
+            uint64_t remaining;                     // octets left in the current piece of the body
+            bool last;                              // the current piece is the last one
+            bool indeterminate;                     // body runs to the end of the stream
+
+            Body buf;
+            std::istream body_stream;
+
+            // read one octet; throws if the stream ends
+            uint8_t get();
+
+            // read a length header and set up the next piece of the body
+            void read_old_length(const uint8_t ctb);
+            void read_new_length();
+
+        public:
+            PacketReader(std::istream & stream, const std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+            PacketReader(const PacketReader &) = delete;
+            PacketReader & operator=(const PacketReader &) = delete;
+
+            // skip whatever is left of the current packet and read the next header
+            // returns false when the stream has no more packets
+            bool next();
+
+            // header of the current packet
+            uint8_t get_tag()                           const;
+            Packet::HeaderFormat get_format()           const;
+            Packet::PartialBodyLength get_partial()     const;
+            uint64_t get_offset()                       const;  // octets before the current packet header
+
+            // read up to size octets of the current body; returns 0 at the end of the body
+            std::size_t read(char * out, const std::size_t size);
+
+            // the rest of the current body as a stream with a bounded buffer
+            // only valid until the next call to next(); do not mix with read()
+            std::istream & body();
+
+            // the rest of the current body in memory
+            std::string read_body();
+
+            // parse the current packet; the body must not have been read yet
+            Packet::Tag::Ptr packet();
+    };
+}
+
+#endif
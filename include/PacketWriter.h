@@ -0,0 +1,131 @@
+/*
+PacketWriter.h
+Incremental packet writer for streams
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PACKET_WRITER__
+#define __OPENPGP_PACKET_WRITER__
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Packets/Packet.h"
+
+namespace OpenPGP {
+    // Pushes packets into a stream as their bodies are produced
+    //
+    // A data packet (Tags 8, 9, 11, and 18) is started with begin(). Its
+    // body is then written in pieces through write() or body(). Every
+    // time a full chunk has been collected and more data follows, the
+    // chunk is written out with a partial body length header, so only
+    // one chunk is ever held in memory. finish() writes whatever is left
+    // with a definite length header, as RFC 4880 sec 4.2.2.4 requires of
+    // the last piece. Bodies that never fill a chunk are written with a
+    // single definite length header.
+    //
+    //     PacketWriter writer(file);
+    //     writer.packet(one_pass_signature);
+    //     writer.begin(Packet::LITERAL_DATA);
+    //     writer.write(literal_header);
+    //     while (...) {
+    //         writer.write(data, size);
+    //     }
+    //     writer.finish();
+    //     writer.packet(signature);
+    class PacketWriter {
+        public:
+            static const std::size_t DEFAULT_CHUNK_SIZE = 1 << 16;
+
+        private:
+            // unbuffered streambuf that forwards into the current body
+            class Body : public std::streambuf {
+                private:
+                    PacketWriter & writer;
+
+                protected:
+                    int_type overflow(int_type c);
+                    std::streamsize xsputn(const char * s, std::streamsize n);
+                    int sync();
+
+                public:
+                    Body(PacketWriter & w);
+            };
+
+            std::ostream & out;
+
+            bool started;                           // begin() has been called and finish() has not
+            uint8_t tag;
+            uint8_t chunk_bits;                     // chunk size as a power of 2
+            std::vector <char> chunk;               // body octets not written yet
+            std::size_t used;
+            bool partial_written;                   // at least one partial body length header was written
+            uint64_t length;                        // body octets received for the current packet
+
+            Body buf;
+            std::ostream body_stream;
+
+            // write octets to out; throws if the stream fails
+            void put(const char * data, const std::size_t size);
+
+            // write the full chunk with a partial body length header
+            void flush_chunk();
+
+        public:
+            // chunk_size is rounded down to a power of 2 between 512 and 2^30
+            PacketWriter(std::ostream & stream, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+            // finishes the current packet; errors are ignored, so call finish() to see them
+            ~PacketWriter();
+
+            PacketWriter(const PacketWriter &) = delete;
+            PacketWriter & operator=(const PacketWriter &) = delete;
+
+            // finish the current packet, if any, and start a new one
+            // throws if tag cannot have partial body lengths
+            void begin(const uint8_t packet_tag);
+
+            // append octets to the current body
+            void write(const char * data, const std::size_t size);
+            void write(const std::string & data);
+
+            // the current body as a stream
+            // only valid until the next call to finish() or begin()
+            std::ostream & body();
+
+            // write the rest of the current body with a definite length
+            void finish();
+
+            // finish the current packet, if any, and write a whole packet
+            void packet(const Packet::Tag::Ptr & packet);
+
+            uint8_t get_tag()                           const;
+            uint64_t get_length()                       const;  // body octets given to the current packet
+            std::size_t get_chunk_size()                const;
+    };
+}
+
+#endif
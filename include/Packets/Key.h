@@ -26,6 +26,8 @@ THE SOFTWARE.
 #ifndef __PACKET_KEY__
 #define __PACKET_KEY__
 
+#include <array>
+
 #include "Hashes/Hashes.h"
 #include "PKA/PKAs.h"
 #include "Packets/Packet.h"
@@ -35,6 +37,19 @@ namespace OpenPGP {
 
         // For Tags 5, 6, 7, and 14
         class Key : public Tag {
+            public:
+                typedef std::array <uint8_t, 20> Fingerprint;   // version 3 (MD5) fingerprints only fill the first 16 octets
+
+            private:
+                mutable std::string common_cache;   // output of raw_common, kept until a field changes
+                mutable bool common_cached;
+
+                // calculated on first use, kept until a field changes
+                mutable Fingerprint fingerprint;
+                mutable std::size_t fingerprint_size;   // 0 if not calculated
+                mutable uint64_t keyid;
+                mutable bool keyid_cached;
+
             protected:
                 uint32_t time;
                 uint8_t pka;
@@ -59,6 +74,7 @@ namespace OpenPGP {
                 void read_common(const std::string & data, std::string::size_type & pos, const std::string::size_type & length);
                 void show_common(HumanReadable & hr) const;
                 std::string actual_raw() const;
+                virtual void modified();
 
             public:
                 typedef std::shared_ptr <Key> Ptr;
@@ -90,6 +106,9 @@ namespace OpenPGP {
 
                 std::string get_fingerprint() const;    // binary
                 std::string get_keyid() const;          // binary
+
+                const Fingerprint & get_fingerprint_array() const;
+                uint64_t get_keyid_int() const;
         };
     }
 }
@@ -129,6 +129,15 @@ namespace OpenPGP {
 
         // Tag class for all packet types
         class Tag {
+            private:
+                // Output of actual_raw, kept until a field changes.
+                // Packets that were read completely start out with
+                // the octets they were read from.
+                mutable std::string raw_cache;
+                mutable bool raw_cached;
+
+                const std::string & cached_raw() const;
+
             protected:
                 uint8_t tag;                  // RFC 4880 sec 4.3
                 uint8_t version;
@@ -143,6 +152,13 @@ namespace OpenPGP {
                 virtual std::string actual_write() const;
                 virtual Status actual_valid(const bool check_mpi) const = 0;
 
+                virtual bool keep_raw() const;  // whether raw() may hold on to a copy of its output
+                virtual void modified();        // call before changing anything actual_raw uses
+
+                // raw() without building an intermediate string where possible
+                virtual std::size_t raw_size() const;
+                virtual void append_raw(std::string & out) const;
+
                 Tag(const uint8_t t);
                 Tag(const uint8_t t, const uint8_t ver);
 
@@ -155,8 +171,10 @@ namespace OpenPGP {
                 void read(const std::string & data, const bool check_end = true);
                 void show(HumanReadable & hr) const;
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw(Status * status = nullptr, const bool check_mpi = false) const;
+                std::string raw(Status * status = nullptr, const bool check_mpi = false) const; // not safe to call on the same packet from multiple threads until it has been called once
                 virtual std::string write(Status * status = nullptr, const bool check_mpi = false) const;
+                std::size_t write_size() const;                 // size of write() output, without writing
+                void write_into(std::string & out) const;       // append write() output to out; does not check validity
                 Status valid(const bool check_mpi = false) const;
 
                 // Accessors
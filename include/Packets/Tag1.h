@@ -98,6 +98,9 @@ namespace OpenPGP {
                 std::string keyid;      // 8 octets
                 uint8_t pka;
                 PKA::Values mpi;        // algorithm specific fields
+                #ifdef GPG_COMPATIBLE
+                std::string wrapped;    // ECDH wrapped session key
+                #endif
 
                 void actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length);
                 void show_contents(HumanReadable & hr) const;
@@ -113,10 +116,16 @@ namespace OpenPGP {
                 std::string get_keyid() const;
                 uint8_t get_pka() const;
                 PKA::Values get_mpi() const;
+                #ifdef GPG_COMPATIBLE
+                std::string get_wrapped() const;
+                #endif
 
                 void set_keyid(const std::string & k);
                 void set_pka(const uint8_t p);
                 void set_mpi(const PKA::Values & m);
+                #ifdef GPG_COMPATIBLE
+                void set_wrapped(const std::string & w);
+                #endif
 
                 Tag::Ptr clone() const;
         };
@@ -163,15 +163,46 @@ namespace OpenPGP {
                 uint32_t time;
                 std::string keyid;
 
+                // where a subpacket is within the raw subpacket data
+                struct Subpacket_Location {
+                    uint8_t type;                           // without the critical bit
+                    std::string::size_type pos;             // position of the type octet
+                    std::string::size_type length;          // type octet + subpacket data
+                };
+
+                // Subpackets are kept as read and only turned into objects
+                // when something asks for them. Lookups of single values use
+                // the index into the raw data instead.
+                struct Subpacket_Area {
+                    std::string raw;                        // all subpackets, headers included
+                    std::vector <Subpacket_Location> index;
+                    bool decoded;                           // subpackets holds objects for everything in raw
+                    bool modified;                          // subpackets were changed; raw and index are stale
+                    Subpackets subpackets;
+
+                    Subpacket_Area();
+                    Subpacket_Area(const Subpacket_Area & copy);
+                    Subpacket_Area & operator=(const Subpacket_Area & copy);
+                };
+
                 // version 4 stuff
-                Subpackets hashed_subpackets;
-                Subpackets unhashed_subpackets;
+                mutable Subpacket_Area hashed_area;
+                mutable Subpacket_Area unhashed_area;
+
+                // Function to find subpackets without parsing them
+                static void index_subpackets(const std::string & data, const std::string::size_type start, const std::string::size_type length, Subpacket_Area & area);
+
+                // Function to parse one subpacket
+                static Subpacket::Tag2::Sub::Ptr read_subpacket(const std::string & raw, const Subpacket_Location & location);
 
-                // Function to read subpacket headers
-                void read_subpacket(const std::string & data, std::string::size_type & pos, std::string::size_type & length);
+                static const Subpackets & decode_subpackets(Subpacket_Area & area);
+                static Subpackets & modify_subpackets(Subpacket_Area & area);  // decodes and marks raw data as stale
+                static Subpackets clone_subpackets(const Subpackets & subpackets);
+                static Status valid_subpackets(const Subpacket_Area & area);
+                static std::string write_subpackets(const Subpacket_Area & area);
 
-                // Function to parse all subpackets
-                void read_subpackets(const std::string & data, Subpackets & subpackets);
+                // contents of the first (or last) subpacket of a type; returns false if there is none
+                static bool find_contents(const Subpacket_Area & area, const uint8_t type, const bool last, std::string & contents);
 
                 void actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length);
                 void show_contents(HumanReadable & hr) const;
@@ -196,10 +227,12 @@ namespace OpenPGP {
                 std::array <uint32_t, 3> get_times()            const;      // signature creation/expiration time and key expiration time; creation time should always exist; expirations times are 0 for version 3 signatures
                 std::string get_keyid()                         const;
 
+                // these return copies of the subpackets; edits only take effect through set_*_subpackets
+                // the first call parses the area and keeps the result, so it is not thread safe
                 Subpackets get_hashed_subpackets()              const;
-                Subpackets get_hashed_subpackets_clone()        const;
+                Subpackets get_hashed_subpackets_clone()        const;      // same as get_hashed_subpackets
                 Subpackets get_unhashed_subpackets()            const;
-                Subpackets get_unhashed_subpackets_clone()      const;
+                Subpackets get_unhashed_subpackets_clone()      const;      // same as get_unhashed_subpackets
                 std::string get_up_to_hashed()                  const;     // used for signature trailer
                 std::string get_without_unhashed()              const;     // used for signature type 0x50
 
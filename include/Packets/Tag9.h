@@ -84,6 +84,9 @@ namespace OpenPGP {
                 std::string actual_raw() const;
                 std::string actual_write() const;
                 Status actual_valid(const bool check_mpi) const;
+                bool keep_raw() const;
+                std::size_t raw_size() const;
+                void append_raw(std::string & out) const;
 
             public:
                 typedef std::shared_ptr <Packet::Tag9> Ptr;
@@ -0,0 +1,85 @@
+/*
+PreparedKey.h
+Public key with its derived values computed once
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PREPARED_KEY__
+#define __OPENPGP_PREPARED_KEY__
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "Misc/montgomery.h"
+#include "PKA/PKAs.h"
+#include "Packets/Key.h"
+
+namespace OpenPGP {
+    // A single key packet along with everything that verification and
+    // encryption would otherwise recompute from it on every call
+    //
+    // Build one per key that is used repeatedly, and pass it to the
+    // Verify and Encrypt functions that accept it. The key packet
+    // should not be modified afterwards.
+    class PreparedKey {
+        public:
+            typedef std::shared_ptr <PreparedKey> Ptr;
+
+        private:
+            Packet::Key::Ptr key;
+            PKA::Values mpi;
+            std::size_t modulus_length;                     // octets of the RSA modulus or ElGamal prime
+            std::string keyid;
+            std::string fingerprint;
+
+            // RSA: EMSA-PKCS1-v1_5 encoding up to the hash value, per hash
+            std::map <uint8_t, std::string> emsa;
+
+            // DSA: odd powers of g and y
+            std::shared_ptr <const WindowTable> dsa_g, dsa_y;
+
+            // ElGamal: comb tables of g and y
+            std::shared_ptr <const CombTable> elgamal_g, elgamal_y;
+
+        public:
+            PreparedKey(const Packet::Key::Ptr & key);
+
+            const Packet::Key::Ptr & get_key() const;
+            uint8_t get_pka() const;
+            const PKA::Values & get_mpi() const;
+            std::size_t get_modulus_length() const;
+            const std::string & get_keyid() const;          // binary
+            const std::string & get_fingerprint() const;    // binary
+
+            // Returns an empty string if the key is not RSA or the hash is not known
+            const std::string & get_emsa_prefix(const uint8_t hash) const;
+
+            // Return nullptr if the key is not of that type
+            const std::shared_ptr <const WindowTable> & get_dsa_g() const;
+            const std::shared_ptr <const WindowTable> & get_dsa_y() const;
+            const std::shared_ptr <const CombTable> & get_elgamal_g() const;
+            const std::shared_ptr <const CombTable> & get_elgamal_y() const;
+    };
+}
+
+#endif
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __BBS__
 #define __BBS__
 
+#include <mutex>
 #include <string>
 
 #include "Misc/mpi.h"
@@ -38,6 +39,7 @@ namespace OpenPGP {
                 Only one "real" instance of BBS exists at a time, since
                 seeding once will seed for the entire program.
                 */
+                static std::recursive_mutex mutex; // guards the shared state
                 static bool seeded;               // whether or not BBS is seeded
                 static MPI state;                 // current state
                 static MPI m;                     // large integer
@@ -53,6 +55,7 @@ namespace OpenPGP {
                 BBS(const MPI & SEED, const unsigned int & bits = 1024, MPI p = 0, MPI q = 0);
                 std::string rand_bits (const unsigned int & bits  = 1, const std::string & par = "even");
                 std::string rand_bytes(const unsigned int & bytes = 1, const std::string & par = "even");
+                void rand_bytes(void * buf, const std::size_t bytes);
         };
     }
 }
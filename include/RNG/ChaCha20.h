@@ -0,0 +1,68 @@
+/*
+ChaCha20.h
+ChaCha20 based deterministic random bit generator
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __CHACHA20_RNG__
+#define __CHACHA20_RNG__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OpenPGP {
+    namespace RNG {
+        // A buffered ChaCha20 DRBG with one generator per thread
+        //
+        // Each thread's generator is keyed from getrandom() on first use
+        // and mixes in fresh OS entropy after every RESEED_INTERVAL octets
+        // and after a fork. Every refill replaces the key with the first
+        // 32 octets of its own output (fast key erasure), and handed out
+        // octets are wiped from the buffer, so earlier output cannot be
+        // recovered from the state.
+        class ChaCha20{
+            public:
+                static const std::size_t RESEED_INTERVAL = 1 << 20;
+
+                ChaCha20(...);
+
+                // mix additional input into this thread's generator
+                ChaCha20(const std::string & seed);
+                ChaCha20(const void * buf, const std::size_t num);
+
+                std::string rand_bits (const unsigned int & bits  = 1);
+                std::string rand_bytes(const unsigned int & bytes = 1);
+
+                // write random octets directly into buf
+                void rand_bytes(void * buf, const std::size_t bytes);
+
+                // octets this thread's generator has handed out since it was last reseeded
+                static std::size_t get_generated();
+
+                // RFC 7539 sec 2.3 block function with a zero nonce
+                static void block(const uint32_t key[8], const uint32_t counter, uint8_t out[64]);
+        };
+    }
+}
+
+#endif
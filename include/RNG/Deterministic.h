@@ -0,0 +1,59 @@
+/*
+Deterministic.h
+Seeded random octets for reproducible tests and benchmarks
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __RNG_DETERMINISTIC__
+#define __RNG_DETERMINISTIC__
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "Provider.h"
+
+namespace OpenPGP {
+    namespace RNG {
+        // ChaCha20 keystream keyed with SHA-256(seed), never reseeded
+        //
+        // The same seed always produces the same octets in the order
+        // they are requested. This is NOT suitable for real keys or
+        // messages; install it only in tests and benchmarks.
+        class Deterministic : public Provider{
+            private:
+                std::mutex mutex;
+                uint32_t key[8];
+                uint32_t counter;
+                uint8_t block[64];
+                std::size_t used;               // octets of block already handed out
+
+            public:
+                Deterministic(const std::string & seed);
+
+                void generate(void * buf, const std::size_t bytes);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+Provider.h
+Replaceable source of random octets
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __RNG_PROVIDER__
+#define __RNG_PROVIDER__
+
+#include <cstddef>
+#include <memory>
+
+namespace OpenPGP {
+    namespace RNG {
+        // Source of the octets handed out by RNG::RNG
+        //
+        // Nothing is installed by default, and the generator selected at
+        // build time is used. Tests and benchmarks can install a seeded
+        // Deterministic provider so that every run does the same work.
+        class Provider{
+            public:
+                typedef std::shared_ptr <Provider> Ptr;
+
+                virtual ~Provider();
+
+                // write bytes random octets into buf
+                virtual void generate(void * buf, const std::size_t bytes) = 0;
+        };
+
+        // install a provider for the whole process; nullptr restores the default
+        void set_provider(const Provider::Ptr & provider);
+
+        // the provider in effect on this thread, or nullptr for the default
+        Provider::Ptr get_provider();
+
+        // Use a provider on the current thread only, overriding the
+        // process-wide one until this object goes out of scope
+        class ScopedProvider{
+            private:
+                Provider::Ptr previous;
+
+            public:
+                ScopedProvider(const Provider::Ptr & provider);
+                ScopedProvider(const ScopedProvider & copy) = delete;
+                ScopedProvider & operator=(const ScopedProvider & copy) = delete;
+                ~ScopedProvider();
+        };
+    }
+}
+
+#endif
@@ -43,6 +43,7 @@ namespace OpenPGP {
                 RAND_bytes(const void * buf, int num);
                 std::string rand_bits (const unsigned int & bits  = 1, const std::size_t max_attempts = 5);
                 std::string rand_bytes(const unsigned int & bytes = 1, const std::size_t max_attempts = 5);
+                void rand_bytes(void * buf, const std::size_t bytes, const std::size_t max_attempts = 5);
         };
     }
 }
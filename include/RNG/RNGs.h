@@ -26,21 +26,60 @@ THE SOFTWARE.
 #ifndef __RNG__
 #define __RNG__
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Misc/mpi.h"
+#include "Provider.h"
+
 #ifdef OPENSSL_RNG
 #include "RAND_bytes.h"
 namespace OpenPGP {
     namespace RNG {
-        typedef RAND_bytes RNG;
+        typedef RAND_bytes Default;
     }
 }
 
-#else
+#elif defined(BBS_RNG)
 #include "BBS.h"
 namespace OpenPGP {
     namespace RNG {
-        typedef BBS RNG;
+        typedef BBS Default;
+    }
+}
+
+#else
+#include "ChaCha20.h"
+namespace OpenPGP {
+    namespace RNG {
+        typedef ChaCha20 Default;
     }
 }
 #endif
 
+namespace OpenPGP {
+    namespace RNG {
+        // Random octets from the Provider in effect (see Provider.h),
+        // or from the Default generator when none is installed
+        class RNG{
+            public:
+                RNG(...);
+                std::string rand_bits (const unsigned int & bits  = 1);
+                std::string rand_bytes(const unsigned int & bytes = 1);
+                void rand_bytes(void * buf, const std::size_t bytes);
+        };
+
+        // random_mpi flags
+        constexpr uint8_t TOP_BIT = 0x01;   // set the highest bit so the value is exactly bits long
+        constexpr uint8_t ODD     = 0x02;   // set the lowest bit
+
+        // random value of at most bits bits, drawn as raw octets
+        MPI random_mpi(const unsigned int bits, const uint8_t flags = 0);
+
+        // uniformly random value in [0, modulus)
+        MPI random_mpi(const MPI & modulus);
+    }
+}
+
 #endif
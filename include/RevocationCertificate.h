@@ -38,6 +38,7 @@ namespace OpenPGP {
             RevocationCertificate(const RevocationCertificate & copy);
             RevocationCertificate(const std::string & data);
             RevocationCertificate(std::istream & stream);
+            static RevocationCertificate from_file(const std::string & path);   // read through a read-only memory map
             ~RevocationCertificate();
 
             uint8_t get_revoke_type() const;
@@ -0,0 +1,120 @@
+/*
+VerifyCache.h
+Cache of signature verification results
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_VERIFY_CACHE__
+#define __OPENPGP_VERIFY_CACHE__
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Packets/Key.h"
+#include "Packets/Tag2.h"
+#include "common/MappedFile.h"
+
+namespace OpenPGP {
+    // Results of signature checks that have already been done
+    //
+    // An entry is keyed by the signer's fingerprint, the signature
+    // packet and the digest of the signed data, so a key that has not
+    // changed since it was last checked can be revalidated without any
+    // public key operations. Only valid (true) and invalid (false)
+    // results are kept; errors are always recomputed.
+    //
+    // The file is a 16 octet header ("PGPVCACH", version, count; both
+    // 4 octet big endian) followed by records of a 32 octet key and a
+    // 1 octet result, sorted by key. It is mapped into memory and
+    // searched in place. Recently used entries are also held in a small
+    // in-memory LRU, and new entries stay in memory until save().
+    class VerifyCache {
+        public:
+            typedef std::shared_ptr <VerifyCache> Ptr;
+
+            static const std::size_t KEY_SIZE    = 32;
+            static const std::size_t RECORD_SIZE = KEY_SIZE + 1;
+            static const std::size_t HEADER_SIZE = 16;
+            static const uint32_t VERSION        = 1;
+
+        private:
+            typedef std::list <std::pair <std::string, bool> > LRU;
+
+            mutable std::mutex mutex;
+
+            std::string path;
+
+            // mapped file
+            std::unique_ptr <MappedFile> file;
+            const uint8_t * map;                    // contents of file
+            std::size_t count;
+
+            // results not written to the file yet
+            std::map <std::string, bool> pending;
+
+            // in-memory front
+            std::size_t capacity;
+            LRU lru;
+            std::unordered_map <std::string, LRU::iterator> index;
+
+            bool load();
+            void unload();
+            bool find_mapped(const std::string & key, bool & result) const;
+            void touch(const std::string & key, const bool result);
+
+        public:
+            // memory only
+            VerifyCache(const std::size_t capacity = 4096);
+
+            // backed by a file; the file does not need to exist yet
+            VerifyCache(const std::string & path, const std::size_t capacity = 4096);
+
+            VerifyCache(const VerifyCache & copy) = delete;
+            VerifyCache & operator=(const VerifyCache & copy) = delete;
+
+            ~VerifyCache();
+
+            // the lookup key of a signature made by signer over digest
+            // the packets are read under this cache's lock, since reading them can fill their caches
+            std::string key(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & sig, const std::string & digest) const;
+
+            // returns whether or not the key was found
+            bool get(const std::string & key, bool & result);
+
+            // only call with results of true or false
+            void set(const std::string & key, const bool result);
+
+            // number of distinct entries, counting ones only in the file
+            std::size_t size() const;
+
+            // merge new results into the file (and reload it)
+            // returns false if there is no file or it could not be written
+            bool save();
+    };
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+Arena.h
+Monotonic memory for objects parsed from one input
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_ARENA__
+#define __OPENPGP_ARENA__
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace OpenPGP {
+    // Memory handed out from large blocks and never returned one object
+    // at a time
+    //
+    // Objects created with make_shared_in_arena while a Scope is active
+    // share their control block and storage with the arena. The blocks
+    // are freed together once the arena and every object in it are gone.
+    // Destructors still run normally, so members that allocate on their
+    // own (std::string, MPIs) are not affected.
+    //
+    // An arena is not thread safe; only one thread should allocate from
+    // it at a time. Objects in it can be released from any thread.
+    class Arena {
+        public:
+            typedef std::shared_ptr <Arena> Ptr;
+
+            static const std::size_t BLOCK_SIZE = 1 << 16;
+
+            // Use an arena for make_shared_in_arena on the current thread
+            // until this object goes out of scope
+            class Scope {
+                private:
+                    Ptr previous;
+
+                public:
+                    Scope(const Ptr & arena);
+                    Scope(const Scope & copy) = delete;
+                    Scope & operator=(const Scope & copy) = delete;
+                    ~Scope();
+            };
+
+            // the arena in effect on this thread, or nullptr
+            static Ptr current();
+
+        private:
+            std::size_t block_size;
+            std::vector <char *> blocks;
+            char * next;                            // next free octet in the newest block
+            std::size_t left;                       // free octets in the newest block
+            std::size_t total;                      // octets handed out
+
+        public:
+            Arena(const std::size_t block_size = BLOCK_SIZE);
+            Arena(const Arena & copy) = delete;
+            Arena & operator=(const Arena & copy) = delete;
+            ~Arena();
+
+            void * allocate(const std::size_t size, const std::size_t align);
+
+            std::size_t used()          const;      // octets handed out
+            std::size_t block_count()   const;
+    };
+
+    // std::allocator interface over an Arena
+    // deallocate does nothing; the memory goes away with the arena
+    template <typename T>
+    class ArenaAllocator {
+        public:
+            typedef T value_type;
+
+            Arena::Ptr arena;
+
+            ArenaAllocator(const Arena::Ptr & a)
+                : arena(a)
+            {}
+
+            template <typename U>
+            ArenaAllocator(const ArenaAllocator <U> & copy)
+                : arena(copy.arena)
+            {}
+
+            T * allocate(const std::size_t n) {
+                return static_cast <T *> (arena -> allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T *, const std::size_t) {}
+
+            template <typename U>
+            bool operator==(const ArenaAllocator <U> & rhs) const {
+                return arena == rhs.arena;
+            }
+
+            template <typename U>
+            bool operator!=(const ArenaAllocator <U> & rhs) const {
+                return arena != rhs.arena;
+            }
+    };
+
+    // std::make_shared, but placed in the current arena if there is one
+    template <typename T, typename... Args>
+    std::shared_ptr <T> make_shared_in_arena(Args &&... args) {
+        const Arena::Ptr arena = Arena::current();
+        if (arena) {
+            return std::allocate_shared <T> (ArenaAllocator <T> (arena), std::forward <Args> (args)...);
+        }
+
+        return std::make_shared <T> (std::forward <Args> (args)...);
+    }
+}
+
+#endif
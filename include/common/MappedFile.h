@@ -0,0 +1,93 @@
+/*
+MappedFile.h
+Read-only memory mapped files
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_MAPPED_FILE__
+#define __OPENPGP_MAPPED_FILE__
+
+#include <cstddef>
+#include <istream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+namespace OpenPGP {
+    // streambuf that reads from memory owned by someone else
+    // used to parse strings and mapped files without copying them into a std::stringstream
+    class MemoryBuffer : public std::streambuf {
+        protected:
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in);
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+
+        public:
+            MemoryBuffer(const char * data = nullptr, const std::size_t size = 0);
+            void reset(const char * data, const std::size_t size);
+    };
+
+    // Read-only memory map of a whole file
+    //
+    // The contents can be parsed through stream() directly from the page
+    // cache instead of being copied into a std::string first. Files that
+    // cannot be mapped (pipes, devices) are read into memory instead.
+    class MappedFile {
+        private:
+            const char * data;
+            std::size_t length;
+            bool opened;
+            bool mapped;
+            std::string contents;                   // used when the file could not be mapped
+            MemoryBuffer buf;
+            std::istream in;
+
+        public:
+            MappedFile(const std::string & path);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator=(const MappedFile &) = delete;
+
+            // true if the file could not be opened (like std::ifstream)
+            bool operator!()            const;
+
+            const char * get_data()     const;
+            std::size_t size()          const;
+            std::string str()           const;  // copy of the contents
+
+            // stream over the mapping; starts at the beginning of the file
+            std::istream & stream();
+    };
+
+    // construct a T from the contents of a mapped file
+    template <typename T>
+    T read_mapped(const std::string & path) {
+        MappedFile file(path);
+        if (!file) {
+            throw std::runtime_error("Error: File \"" + path + "\" not opened.");
+        }
+
+        return T(file.stream());
+    }
+}
+
+#endif
@@ -22,6 +22,9 @@ static const std::string whitespace = "\x20\x09\x0a\x0b\x0c\x0d";
 // string to integer
 uint64_t toint(const std::string & s, const int & base = 10);
 
+// big endian integer from octets of data starting at pos, without copying them out
+uint64_t toint(const std::string & data, const std::string::size_type pos, const std::size_t octets);
+
 // flip the order of the octets
 // base = 2 for binary source
 //        16 for hex source
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "Misc/PKCS1.h"
 #include "Misc/cfb.h"
 #include "PKA/PKAs.h"
+#include "PreparedKey.h"
 #include "revoke.h"
 #include "sign.h"
 
@@ -97,6 +98,11 @@ namespace OpenPGP {
         Message pka(const Args & args,
                     const Key & pub);
 
+        // encrypt with a key prepared for repeated use
+        // key must be an encrypting key; revocation is not checked
+        Message pka(const Args & args,
+                    const PreparedKey & key);
+
         // encrypt with passphrase
         Message sym(const Args & args,
                     const std::string & passphrase,
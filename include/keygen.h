@@ -54,6 +54,7 @@ namespace OpenPGP {
             std::size_t bits        = 2048;
             uint8_t     sym         = Sym::ID::AES256;          // symmetric key algorithm used by S2K
             uint8_t     hash        = Hash::ID::SHA256;         // hash algorithm used by S2K
+            bool        standard    = false;                    // use a pre-validated DSA/ElGamal group
 
             // User ID (s)
             struct UserID{
@@ -75,6 +76,7 @@ namespace OpenPGP {
                 uint8_t     hash    = Hash::ID::SHA256;         // hash algorithm used by S2K
                 uint8_t     sig     = Hash::ID::SHA256;         // hash algorithm used to sign
                 uint32_t    expire  = 0;
+                bool        standard = false;                   // use a pre-validated DSA/ElGamal group
             };
 
             // 0 or more subkeys
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #define __VERIFY__
 
 #include <string>
+#include <vector>
 
 #include "CleartextSignature.h"
 #include "DetachedSignature.h"
@@ -37,7 +38,9 @@ THE SOFTWARE.
 #include "Misc/sigcalc.h"
 #include "PKA/PKAs.h"
 #include "Packets/Packets.h"
+#include "PreparedKey.h"
 #include "RevocationCertificate.h"
+#include "VerifyCache.h"
 
 namespace OpenPGP {
     namespace Verify {
@@ -46,11 +49,37 @@ namespace OpenPGP {
 
         // verify pka with packets
         int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee);
+
+        // verify pka with a key prepared for repeated use
+        int with_pka(const std::string & digest, const uint8_t hash, const PreparedKey & signer, const PKA::Values & signee);
+        int with_pka(const std::string & digest, const PreparedKey & signer, const Packet::Tag2::Ptr & signee);
+
+        // verify pka with packets, using earlier results when the cache has them
+        int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee, VerifyCache & cache);
         // /////////////////
 
         // detached signatures (not a standalone signature)
         int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig);
 
+        // signer is the signing key itself, not a transferable key,
+        // so revocation and key selection are up to the caller
+        int detached_signature(const PreparedKey & signer, const std::string & data, const DetachedSignature & sig);
+
+        // one detached signature in a batch
+        struct Job {
+            Key::Ptr key;
+            std::string data;
+            DetachedSignature::Ptr sig;
+        };
+
+        // Check many detached signatures; each result is what
+        // detached_signature(*key, data, *sig) would return
+        //
+        // Jobs with the same signing key share one PreparedKey, and the
+        // hashing and verification are spread over the given number of
+        // threads (0 for one per core)
+        std::vector <int> batch(const std::vector <Job> & jobs, const unsigned int threads = 0);
+
         // 0x00: Signature of a binary document.
         int binary(const Key & key, const Message & message);
 
@@ -65,8 +94,16 @@ namespace OpenPGP {
         // 0x13: Positive certification of a User ID and Public-Key packet.
         int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature);
         int primary_key(const Key & signer, const Key & signee);
+        int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature, VerifyCache & cache);
+        int primary_key(const Key & signer, const Key & signee, VerifyCache & cache);
 
         // 0x18: Subkey Binding Signature
+        int subkey_binding(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & binding);
+        int subkey_binding(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & binding, VerifyCache & cache);
+
+        // every subkey binding signature on the key
+        int subkey_binding(const Key & key);
+        int subkey_binding(const Key & key, VerifyCache & cache);
 
         // 0x19: Primary Key Binding Signature
 
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "Misc/sigcalc.h"
+#include "common/MappedFile.h"
 #include "common/includes.h"
 
 namespace OpenPGP {
@@ -43,8 +44,13 @@ CleartextSignature::CleartextSignature(std::istream & stream)
     }
 }
 
+CleartextSignature CleartextSignature::from_file(const std::string & path) {
+    return read_mapped <CleartextSignature> (path);
+}
+
 void CleartextSignature::read(const std::string & data) {
-    std::stringstream s(data);
+    MemoryBuffer buf(data.data(), data.size());
+    std::istream s(&buf);
     read(s);
 }
 
@@ -1,5 +1,7 @@
 #include "DetachedSignature.h"
 
+#include "common/MappedFile.h"
+
 namespace OpenPGP {
 
 DetachedSignature::DetachedSignature()
@@ -40,6 +42,10 @@ DetachedSignature::DetachedSignature(std::istream & stream)
     }
 }
 
+DetachedSignature DetachedSignature::from_file(const std::string & path) {
+    return read_mapped <DetachedSignature> (path);
+}
+
 DetachedSignature::~DetachedSignature() {}
 
 bool DetachedSignature::meaningful(const PGP & pgp) {
@@ -48,7 +54,7 @@ bool DetachedSignature::meaningful(const PGP & pgp) {
         return false;
     }
 
-    if (pgp.get_packets().size() != 1) {
+    if (pgp.size() != 1) {
         // "Error: Wrong number of packets.\n";
         return false;
     }
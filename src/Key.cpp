@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <stdexcept>
 
+#include "common/MappedFile.h"
+
 namespace OpenPGP {
 
 const std::map <uint8_t, std::string> Key::Public_Key_Type = {
@@ -29,14 +31,14 @@ Key::Key(const std::string & data)
 {
     // got binary data
     if (type == UNKNOWN) {
-        if (packets.size() < 2) {
+        if (size() < 2) {
             throw std::runtime_error("Error: Not enough packets in given key");
         }
 
-        if (packets[0] -> get_tag() == Packet::PUBLIC_KEY) {
+        if (get_tag(0) == Packet::PUBLIC_KEY) {
             type = PUBLIC_KEY_BLOCK;
         }
-        else if (packets[0] -> get_tag() == Packet::SECRET_KEY) {
+        else if (get_tag(0) == Packet::SECRET_KEY) {
             type = PRIVATE_KEY_BLOCK;
         }
         else{
@@ -55,14 +57,14 @@ Key::Key(std::istream & stream)
 {
     // got binary data
     if (type == UNKNOWN) {
-        if (packets.size() < 2) {
+        if (size() < 2) {
             throw std::runtime_error("Error: Not enough packets in given key");
         }
 
-        if (packets[0] -> get_tag() == Packet::PUBLIC_KEY) {
+        if (get_tag(0) == Packet::PUBLIC_KEY) {
             type = PUBLIC_KEY_BLOCK;
         }
-        else if (packets[0] -> get_tag() == Packet::SECRET_KEY) {
+        else if (get_tag(0) == Packet::SECRET_KEY) {
             type = PRIVATE_KEY_BLOCK;
         }
         else{
@@ -76,6 +78,10 @@ Key::Key(std::istream & stream)
     }
 }
 
+Key Key::from_file(const std::string & path) {
+    return read_mapped <Key> (path);
+}
+
 Key::~Key() {}
 
 std::string Key::keyid() const {
@@ -83,7 +89,7 @@ std::string Key::keyid() const {
         throw std::runtime_error("Error: Bad Key.");
     }
 
-    return std::static_pointer_cast <Packet::Key> (packets[0]) -> get_keyid();
+    return std::static_pointer_cast <Packet::Key> (get_packet(0)) -> get_keyid();
 }
 
 std::string Key::fingerprint() const {
@@ -91,7 +97,7 @@ std::string Key::fingerprint() const {
         throw std::runtime_error("Error: Bad Key.");
     }
 
-    return std::static_pointer_cast <Packet::Key> (packets[0]) -> get_fingerprint();
+    return std::static_pointer_cast <Packet::Key> (get_packet(0)) -> get_fingerprint();
 }
 
 uint8_t Key::version() const {
@@ -99,7 +105,7 @@ uint8_t Key::version() const {
         throw std::runtime_error("Error: Bad Key.");
     }
 
-    return std::static_pointer_cast <Packet::Key> (packets[0]) -> get_version();
+    return std::static_pointer_cast <Packet::Key> (get_packet(0)) -> get_version();
 }
 
 // output style inspired by gpg and SKS Keyserver/pgp.mit.edu
@@ -113,7 +119,7 @@ std::string Key::list_keys(const std::size_t indents, const std::size_t indent_s
 
     // print Key and User packets
     std::stringstream out;
-    for(Packet::Tag::Ptr const & p : packets) {
+    for(Packet::Tag::Ptr const & p : get_packets()) {
         // primary key/subkey
         if (Packet::is_key_packet(p -> get_tag())) {
             const Packet::Key::Ptr key = std::static_pointer_cast <Packet::Key> (p);
@@ -194,6 +200,7 @@ Key::pkey Key::get_pkey() const {
     if (!meaningful()) {
         throw std::runtime_error("Error: Bad Key.");
     }
+    const Packets & packets = get_packets();
     pkey pk;
     pk.key = packets[0];
     Packet::Tag::Ptr lastUser_userAtt = nullptr;
@@ -259,27 +266,27 @@ bool Key::meaningful(const PGP & pgp) {
         return false;
     }
 
-    const Packets & packets = pgp.get_packets();
+    // only the primary key and the signatures are parsed; the rest is checked by tag
 
     // minimum 2 packets: Primary Key + User ID
-    if (packets.size() < 2) {
+    if (pgp.size() < 2) {
         // "Error: Not enough packets (minimum 2).\n";
         return false;
     }
 
     //   - One Public/Secret-Key packet
-    if (packets[0] -> get_tag() != key) {
+    if (pgp.get_tag(0) != key) {
         // "Error: First packet is not a " + Packet::NAME.at(key) + ".\n";
         return false;
     }
 
     // get version of primary key
-    const uint8_t primary_key_version = std::static_pointer_cast <Packet::Key> (packets[0]) -> get_version();
+    const uint8_t primary_key_version = std::static_pointer_cast <Packet::Key> (pgp.get_packet(0)) -> get_version();
 
     //   - Zero or more revocation signatures
     unsigned int i = 1;
-    while ((i < packets.size()) && (packets[i] -> get_tag() == Packet::SIGNATURE)) {
-        if (std::static_pointer_cast <Packet::Tag2> (packets[i]) -> get_type() == Signature_Type::KEY_REVOCATION_SIGNATURE) {
+    while ((i < pgp.size()) && (pgp.get_tag(i) == Packet::SIGNATURE)) {
+        if (std::static_pointer_cast <Packet::Tag2> (pgp.get_packet(i)) -> get_type() == Signature_Type::KEY_REVOCATION_SIGNATURE) {
             // "Warning: Revocation Signature found on primary key.\n";
             i++;
         }
@@ -304,18 +311,18 @@ bool Key::meaningful(const PGP & pgp) {
     // User Attribute packets and User ID packets may be freely intermixed
     // in this section, so long as the signatures that follow them are
     // maintained on the proper User Attribute or User ID packet.
-    Packet::Tag13::Ptr user_id = nullptr;
+    bool user_id = false;
     do{
         // make sure there is a User packet
-        if ((packets[i] -> get_tag() != Packet::USER_ID)       &&
-            (packets[i] -> get_tag() != Packet::USER_ATTRIBUTE)) {
+        if ((pgp.get_tag(i) != Packet::USER_ID)       &&
+            (pgp.get_tag(i) != Packet::USER_ATTRIBUTE)) {
             // "Error: Packet is not a User ID or User Attribute Packet.\n";
             return false;
         }
 
-        const Packet::User::Ptr user = std::static_pointer_cast <Packet::User> (packets[i]);
-        if (user -> get_tag() == Packet::USER_ID) {
-            user_id = std::static_pointer_cast <Packet::Tag13> (user);
+        const uint8_t user = pgp.get_tag(i);
+        if (user == Packet::USER_ID) {
+            user_id = true;
         }
 
         // go to next packet
@@ -334,11 +341,11 @@ bool Key::meaningful(const PGP & pgp) {
         // Attribute packet is followed by zero or more Signature packets
         // calculated on the immediately preceding User Attribute packet and the
         // initial Public-Key packet.
-        while ((i < packets.size()) && (packets[i] -> get_tag() == Packet::SIGNATURE)) {
-            const Packet::Tag2::Ptr sig = std::static_pointer_cast <Packet::Tag2> (packets[i]);
+        while ((i < pgp.size()) && (pgp.get_tag(i) == Packet::SIGNATURE)) {
+            const Packet::Tag2::Ptr sig = std::static_pointer_cast <Packet::Tag2> (pgp.get_packet(i));
             if (!Signature_Type::is_certification(sig -> get_type())) {
                 // User IDs can have revocation signatures
-                if ((user -> get_tag() == Packet::USER_ID) &&
+                if ((user == Packet::USER_ID) &&
                     (sig -> get_type() == Signature_Type::CERTIFICATION_REVOCATION_SIGNATURE)) {
                     // "Warning: Revocation Signature found on UID.\n";
                 }
@@ -350,8 +357,8 @@ bool Key::meaningful(const PGP & pgp) {
 
             i++;
         }
-    } while ((i < packets.size()) &&
-             (Packet::is_user(packets[i] -> get_tag())));
+    } while ((i < pgp.size()) &&
+             (Packet::is_user(pgp.get_tag(i))));
 
     // need at least one User ID packet
     if (!user_id) {
@@ -360,8 +367,8 @@ bool Key::meaningful(const PGP & pgp) {
     }
 
     //    - Zero or more Subkey packets
-    while (i < packets.size()) {
-        if  (packets[i] -> get_tag() != subkey) {
+    while (i < pgp.size()) {
+        if  (pgp.get_tag(i) != subkey) {
             // "Error: Bad subkey packet.\n";
             return false;
         }
@@ -387,9 +394,9 @@ bool Key::meaningful(const PGP & pgp) {
 
         //    - After each Subkey packet, one Signature packet, plus optionally a revocation
         bool subkey_binding = false;
-        while ((i < packets.size()) &&
-               (packets[i] -> get_tag() == Packet::SIGNATURE)) {
-            const Packet::Tag2::Ptr sig = std::static_pointer_cast <Packet::Tag2> (packets[i]);
+        while ((i < pgp.size()) &&
+               (pgp.get_tag(i) == Packet::SIGNATURE)) {
+            const Packet::Tag2::Ptr sig = std::static_pointer_cast <Packet::Tag2> (pgp.get_packet(i));
             if (sig -> get_type() == Signature_Type::SUBKEY_REVOCATION_SIGNATURE) {
                 // "Warning: Revocation Signature found on subkey.\n";
             }
@@ -408,7 +415,7 @@ bool Key::meaningful(const PGP & pgp) {
     }
 
     // the index should be at the end of the packets
-    return (i == packets.size());
+    return (i == pgp.size());
 }
 
 bool Key::meaningful() const {
@@ -551,6 +558,10 @@ PublicKey::PublicKey(std::istream & stream)
     : Key(stream)
 {}
 
+PublicKey PublicKey::from_file(const std::string & path) {
+    return read_mapped <PublicKey> (path);
+}
+
 PublicKey::PublicKey(const SecretKey & sec)
     : PublicKey(sec.get_public())
 {}
@@ -567,15 +578,7 @@ bool PublicKey::meaningful() const {
 }
 
 PublicKey & PublicKey::operator=(const PublicKey & pub) {
-    armored = pub.armored;
-    type = pub.type;
-    keys = pub.keys;
-    packets = pub.packets;
-
-    for(Packet::Tag::Ptr & p : packets) {
-        p = p -> clone();
-    }
-
+    PGP::operator=(pub);
     return *this;
 }
 
@@ -614,6 +617,10 @@ SecretKey::SecretKey(std::istream & stream)
     : Key(stream)
 {}
 
+SecretKey SecretKey::from_file(const std::string & path) {
+    return read_mapped <SecretKey> (path);
+}
+
 SecretKey::~SecretKey() {}
 
 PublicKey SecretKey::get_public() const {
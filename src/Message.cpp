@@ -1,6 +1,7 @@
 #include "Message.h"
 
 #include "Misc/CRC-24.h"
+#include "common/MappedFile.h"
 
 namespace OpenPGP {
 
@@ -115,9 +116,9 @@ bool Message::SignedMessage(std::list <Token>::iterator it, std::list <Token> &
 
 bool Message::decompress() {
     // check if compressed
-    if ((packets.size() == 1) && (packets[0] -> get_tag() == Packet::COMPRESSED_DATA)) {
+    if ((size() == 1) && (get_tag(0) == Packet::COMPRESSED_DATA)) {
         comp.reset();
-        comp = std::static_pointer_cast <Packet::Tag8> (packets[0]);
+        comp = std::static_pointer_cast <Packet::Tag8> (get_packet(0));
         const std::string data = comp -> get_data();
         comp -> set_data("");
         comp -> set_partial(comp -> get_partial());
@@ -191,6 +192,10 @@ Message::Message(std::istream & stream)
     }
 }
 
+Message Message::from_file(const std::string & path) {
+    return read_mapped <Message> (path);
+}
+
 Message::~Message() {}
 
 void Message::read_raw(const std::string & data) {
@@ -256,14 +261,19 @@ std::string Message::write(const PGP::Armored armor, Status * status, const bool
         return packet_string;
     }
 
-    std::string out = ASCII_Armor_Begin + ASCII_Armor_Header[MESSAGE] + ASCII_Armor_5_Dashes + "\n";
+    const std::string body = format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH);
+
+    std::string out;
+    out.reserve(body.size() + 256);
+    out += ASCII_Armor_Begin + ASCII_Armor_Header[MESSAGE] + ASCII_Armor_5_Dashes + "\n";
     for(Armor_Key const & key : keys) {
         out += key.first + ": " + key.second + "\n";
     }
     out += "\n";
-    return out + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH)
-        + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) +  "\n"
-        + ASCII_Armor_End + ASCII_Armor_Header[MESSAGE] + ASCII_Armor_5_Dashes;
+    out += body;
+    out += "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) + "\n";
+    out += ASCII_Armor_End + ASCII_Armor_Header[MESSAGE] + ASCII_Armor_5_Dashes;
+    return out;
 }
 
 uint8_t Message::get_comp() const {
@@ -287,7 +297,7 @@ bool Message::match(const PGP & pgp, const Message::Token & token) {
         return false;
     }
 
-    if (!pgp.get_packets().size()) {
+    if (!pgp.size()) {
         // "Error: No packets found.\n";
         return false;
     }
@@ -304,9 +314,9 @@ bool Message::match(const PGP & pgp, const Message::Token & token) {
 
     // get list of packets and convert them to Token
     std::list <Token> s;
-    for(Packet::Tag::Ptr const & p : pgp.get_packets()) {
+    for(Packets::size_type i = 0; i < pgp.size(); i++) {
         Token push;
-        switch (p -> get_tag()) {
+        switch (pgp.get_tag(i)) {
             case Packet::COMPRESSED_DATA:
                 push = CDP;
                 break;
@@ -1,7 +1,5 @@
 #include "Misc/Length.h"
 
-#include <list>
-
 #include "Packets/Partial.h"
 #include "common/includes.h"
 
@@ -15,7 +13,7 @@ std::size_t read_one_octet_lengths(const std::string & data, std::string::size_t
 
 std::size_t read_two_octet_lengths(const std::string & data, std::string::size_type & pos, std::size_t & length, const Packet::HeaderFormat format) {
     if (format == Packet::HeaderFormat::OLD) {
-        length = toint(data.substr(pos, 2), 256);
+        length = toint(data, pos, 2);
     }
     else {
         length = ((((uint8_t) data[pos]) - 192) << 8) + ((uint8_t) data[pos + 1]) + 192;
@@ -25,7 +23,7 @@ std::size_t read_two_octet_lengths(const std::string & data, std::string::size_t
 }
 
 std::size_t read_five_octet_lengths(const std::string & data, std::string::size_type & pos, std::size_t & length, const Packet::HeaderFormat) {
-    length = toint(data.substr(pos + 1, 4), 256);
+    length = toint(data, pos + 1, 4);
     pos += 5;
     return 5;
 }
@@ -34,133 +32,177 @@ std::size_t read_partialBodyLen(uint8_t first_octet, const Packet::HeaderFormat)
     return 1ULL << (first_octet & 0x1fU);
 }
 
-// returns formatted length string
-// partial takes precedence over octets
-std::string write_old_length(const uint8_t tag, const std::string & data, const Packet::PartialBodyLength part, uint8_t octets) {
-    std::string::size_type length = data.size();
-    std::string out(1, 0x80 | (tag << 2)); // old header: 10TT TTLL
-    if (part == Packet::PARTIAL) {         // partial
-        out[0] |= 3;
-    }
-    else{
-        // try to use user requested octet length
-        if (octets == 1) {
-            if (length > 255) {
-                octets = 0;
-            }
-        }
-        else if (octets == 2) {
-            if (length > 65535) {
-                octets = 0;
-            }
+// number of length octets an old format header uses: 1, 2, or 4
+// octets is what the caller asked for; it is ignored if the length does not fit
+static uint8_t old_length_octets(const std::size_t length, uint8_t octets) {
+    if (octets == 1) {
+        if (length > 255) {
+            octets = 0;
         }
-        else if ((octets == 3) ||
-                 (octets == 4) ||
-                 (octets >  5)) {
+    }
+    else if (octets == 2) {
+        if (length > 65535) {
             octets = 0;
         }
+    }
+    else if ((octets == 3) ||
+             (octets == 4) ||
+             (octets >  5)) {
+        octets = 0;
+    }
 
-        // 1 octet
-        if ((octets == 1)   ||             // user requested
-            ((octets == 0)  &&             // default
-             (length < 256))) {
-            out[0] |= 0;
-            out += std::string(1, length);
+    if ((octets == 1)   ||          // user requested
+        ((octets == 0)  &&          // default
+         (length < 256))) {
+        return 1;
+    }
+    else if ((octets == 2)     ||   // user requested
+             ((octets == 0)    &&   // default
+              (length < 65536))) {
+        return 2;
+    }
+    return 4;
+}
+
+// number of length octets a new format header uses: 1, 2, or 5
+static uint8_t new_length_octets(const std::size_t length, uint8_t octets) {
+    if (octets == 1) {
+        if (length > 191) {
+            octets = 0;
         }
-        // 2 octest
-        else if ((octets == 2)     ||      // user requested
-                 ((octets == 0)    &&      // default
-                  (256 <= length)  &&
-                  (length < 65536))) {
-            out[0] |= 1;
-            out += unhexlify(makehex(length, 4));
+    }
+    else if (octets == 2) {
+        if (length > 8382) {
+            octets = 0;
         }
-        // 5 octets
-        else if ((octets == 5)      ||     // use requested
-                 ((octets == 0)     &&     // default
-                  (65536 <= length))) {
-            out[0] |= 2;
-            out += unhexlify(makehex(length, 8));
+    }
+    else if ((octets == 3) ||
+             (octets == 4) ||
+             (octets >  5)) {
+        octets = 0;
+    }
+
+    if ((octets == 1)     ||        // user requested
+        ((octets == 0)    &&        // default
+         (length <= 191))) {
+        return 1;
+    }
+    else if ((octets == 2)     ||   // user requested
+             ((octets == 0)    &&   // default
+              (length <= 8383))) {
+        return 2;
+    }
+    return 5;
+}
+
+void write_new_length_octets(std::size_t length, std::string & out, const uint8_t octets) {
+    switch (new_length_octets(length, octets)) {
+        case 1:
+            out += static_cast <char> (length);
+            break;
+        case 2:
+            length -= 0xc0;
+            out += static_cast <char> ((length >> 8) + 0xc0);
+            out += static_cast <char> (length & 0xff);
+            break;
+        default:
+            out += '\xff';
+            for(uint16_t i = 4; i > 0; i--) {
+                out += static_cast <char> (byte(length, i - 1));
+            }
+            break;
+    }
+}
+
+// the last set bits of a partial length, which are written as one non-partial header
+static const std::size_t PARTIAL_REMAINDER = 511;
+
+void write_old_header(const uint8_t tag, const std::size_t length, std::string & out, uint8_t octets) {
+    octets = old_length_octets(length, octets);
+    out += static_cast <char> (0x80 | (tag << 2) | (octets >> 1));  // old header: 10TT TTLL
+    for(uint16_t i = octets; i > 0; i--) {
+        out += static_cast <char> (byte(length, i - 1));
+    }
+}
+
+void write_new_header(const uint8_t tag, const std::size_t length, std::string & out, uint8_t octets) {
+    out += static_cast <char> (0xc0 | tag);                         // new header: 11TT TTTT
+    write_new_length_octets(length, out, octets);
+}
+
+std::size_t old_length_size(const std::size_t length, const Packet::PartialBodyLength part, uint8_t octets) {
+    if (part == Packet::PARTIAL) {
+        return 1;
+    }
+    return 1 + old_length_octets(length, octets);
+}
+
+std::size_t new_length_size(const std::size_t length, const Packet::PartialBodyLength part, uint8_t octets) {
+    if (part == Packet::PARTIAL) {
+        // tag, one octet per partial piece, and the last header
+        std::size_t size = 1 + new_length_octets(length & PARTIAL_REMAINDER, 0);
+        for(uint8_t i = 9; i < 31; i++) {
+            if (length & (1u << i)) {
+                size++;
+            }
         }
+        return size;
     }
-    return out + data;
+    return 1 + new_length_octets(length, octets);
+}
+
+// returns formatted length string
+// partial takes precedence over octets
+std::string write_old_length(const uint8_t tag, const std::string & data, const Packet::PartialBodyLength part, uint8_t octets) {
+    std::string out;
+    out.reserve(old_length_size(data.size(), part, octets) + data.size());
+    if (part == Packet::PARTIAL) {                                  // partial
+        out += static_cast <char> (0x80 | (tag << 2) | 3);
+    }
+    else{
+        write_old_header(tag, data.size(), out, octets);
+    }
+    out += data;
+    return out;
 }
 
 // returns formatted length string
 // partial takes precedence over octets
 std::string write_new_length(const uint8_t tag, const std::string & data, const Packet::PartialBodyLength part, uint8_t octets) {
     std::string::size_type length = data.size();
-    std::string out(1, 0xc0 | tag);                         // new header: 11TT TTTT
+    std::string out;
+    out.reserve(new_length_size(length, part, octets) + length);
     if (part == Packet::PARTIAL) {                          // partial
         if (length < 512) {
             throw std::runtime_error("The first partial length MUST be at least 512 octets long.");
         }
 
+        out += static_cast <char> (0xc0 | tag);             // new header: 11TT TTTT
+
         // get the lowest 9 bits worth of octets to use as the last body length header
-        const uint32_t non_partial = length & 511;
+        const uint32_t non_partial = length & PARTIAL_REMAINDER;
 
         // zero out the lowest 9 bits
-        length &= ~511;
+        length &= ~PARTIAL_REMAINDER;
 
-        // get the remaining bits that are set
-        std::list <uint8_t> set_bits;
-        for(uint8_t i = 9; i < 31; i++) {
-            if (length & (1u << i)) {
-                set_bits.push_front(i);
-            }
-        }
-
-        // write partial body lengths
+        // write partial body lengths, largest first
         uint32_t pos = 0;
-        for(uint8_t const bit : set_bits) {
-            const uint32_t partial_length = 1 << bit;
-            out += std::string(1, bit | 0xe0);              // length with mask
-            out += data.substr(pos, partial_length);        // data
-            pos += partial_length;                          // increment offset
+        for(uint8_t bit = 31; bit-- > 9;) {
+            if (length & (1u << bit)) {
+                const uint32_t partial_length = 1 << bit;
+                out += static_cast <char> (bit | 0xe0);     // length with mask
+                out.append(data, pos, partial_length);      // data
+                pos += partial_length;                      // increment offset
+            }
         }
 
         // write the last length header, which should not be a partial body length header
-        out += write_new_length(tag, data.substr(pos, non_partial), Packet::NOT_PARTIAL);
+        // (it continues the same packet, so the tag octet is not repeated)
+        write_new_length_octets(non_partial, out, 0);
+        out.append(data, pos, non_partial);
     }
     else{
-        // try to use user requested octet length
-        if (octets == 1) {
-            if (length > 191) {
-                octets = 0;
-            }
-        }
-        else if (octets == 2) {
-            if (length > 8382) {
-                octets = 0;
-            }
-        }
-        else if ((octets == 3) ||
-                 (octets == 4) ||
-                 (octets >  5)) {
-            octets = 0;
-        }
-
-        // 1 octet
-        if ((octets == 1)     ||          // user requested
-            ((octets == 0)    &&          // default
-             (length <= 191))) {
-            out += std::string(1, length);
-        }
-        // 2 octets
-        else if ((octets == 2)        ||  // user requested
-                 ((octets == 0)       &&  // default
-                  ((192 <= length)    &&
-                   (length <= 8383)))) {
-            length -= 0xc0;
-            out += std::string(1, (length >> 8) + 0xc0) + std::string(1, length & 0xff);
-        }
-        // 5 octets
-        else if ((octets == 5)     ||     // user requested
-                 ((octets == 0)    &&     // default
-                  (length > 8383))) {
-            out += std::string(1, '\xff') + unhexlify(makehex(length, 8));
-        }
-
+        write_new_header(tag, length, out, octets);
         out += data;
     }
 
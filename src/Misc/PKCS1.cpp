@@ -7,19 +7,21 @@
 namespace OpenPGP {
 
 std::string EME_PKCS1v1_5_ENCODE(const std::string & m, const unsigned int & k) {
-    if (m.size() > (k - 11)) {
+    if ((k < 11) || (m.size() > (k - 11))) {
         // "Error: EME-PKCS1 Message too long.\n";
         return "";
     }
 
-    std::string EM = zero + "\x02";
-    while (EM.size() < k - m.size() - 1) {
-        if (const unsigned char c = RNG::RNG().rand_bytes(1)[0]) { // non-zero octets only
-            EM += std::string(1, c);
+    RNG::RNG rng;
+    std::string PS(k - m.size() - 3, 0);
+    rng.rand_bytes(&PS[0], PS.size());
+    for(char & c : PS) {
+        while (!c) {                    // non-zero octets only
+            rng.rand_bytes(&c, 1);
         }
     }
 
-    return EM + zero + m;
+    return zero + "\x02" + PS + zero + m;
 }
 
 std::string EME_PKCS1v1_5_DECODE(const std::string & m) {
@@ -39,8 +41,12 @@ std::string EME_PKCS1v1_5_DECODE(const std::string & m) {
     return "";
 }
 
+std::string EMSA_PKCS1_v1_5_prefix(const uint8_t & hash, const unsigned int & keylength) {
+    return zero + "\x01" + std::string(keylength - (Hash::ASN1_DER.at(hash).size() >> 1) - 3 - (Hash::LENGTH.at(hash) >> 3), (char) 0xffU) + zero + unhexlify(Hash::ASN1_DER.at(hash));
+}
+
 std::string EMSA_PKCS1_v1_5(const uint8_t & hash, const std::string & hashed_data, const unsigned int & keylength) {
-    return zero + "\x01" + std::string(keylength - (Hash::ASN1_DER.at(hash).size() >> 1) - 3 - (Hash::LENGTH.at(hash) >> 3), (char) 0xffU) + zero + unhexlify(Hash::ASN1_DER.at(hash)) + hashed_data;
+    return EMSA_PKCS1_v1_5_prefix(hash, keylength) + hashed_data;
 }
 
 }
@@ -0,0 +1,349 @@
+#include "Misc/montgomery.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace OpenPGP {
+
+#if GMP_NAIL_BITS != 0
+#error "Montgomery arithmetic requires a GMP build without nails"
+#endif
+
+// sliding window recoding of exp
+// digits[i] is the odd value of the window whose lowest bit is bit i, or 0
+static std::vector <uint8_t> recode(const MPI & exp, const unsigned int w) {
+    const std::size_t bits = (exp == 0)?0:mpz_sizeinbase(exp.get_mpz_t(), 2);
+    std::vector <uint8_t> digits(bits, 0);
+
+    std::size_t i = bits;
+    while (i) {
+        const std::size_t top = i - 1;
+        if (!mpz_tstbit(exp.get_mpz_t(), top)) {
+            i--;
+            continue;
+        }
+
+        // window is bits [low, top], ending on a set bit
+        std::size_t low = (top + 1 >= w)?(top + 1 - w):0;
+        while (!mpz_tstbit(exp.get_mpz_t(), low)) {
+            low++;
+        }
+
+        uint8_t value = 0;
+        for(std::size_t j = top + 1; j > low; j--) {
+            value = (value << 1) | mpz_tstbit(exp.get_mpz_t(), j - 1);
+        }
+
+        digits[low] = value;
+        i = low;
+    }
+
+    return digits;
+}
+
+void Montgomery::redc(mp_limb_t * out, mp_limb_t * t) const {
+    // clear one low limb at a time, keeping each carry in the cleared limb
+    for(mp_size_t i = 0; i < n; i++) {
+        const mp_limb_t u = t[i] * minv;
+        t[i] = mpn_addmul_1(t + i, m.data(), n, u);
+    }
+
+    // add the carries into the high half; the result is less than 2 * mod
+    const mp_limb_t carry  = mpn_add_n(t + n, t + n, t, n);
+    const mp_limb_t borrow = mpn_sub_n(t, t + n, m.data(), n);
+
+    // keep the difference if there was a carry out or no borrow
+    const mp_limb_t mask = -static_cast <mp_limb_t> (carry | (borrow ^ 1));
+    for(mp_size_t i = 0; i < n; i++) {
+        out[i] = (t[i] & mask) | (t[n + i] & ~mask);
+    }
+}
+
+Montgomery::Montgomery(const MPI & modulus)
+    : mod(modulus),
+      m(),
+      n(mpz_size(modulus.get_mpz_t())),
+      minv(0)
+{
+    if ((modulus < 3) || !mpz_odd_p(modulus.get_mpz_t())) {
+        throw std::runtime_error("Error: Montgomery modulus must be odd and greater than 1.");
+    }
+
+    m.resize(n, 0);
+    mpz_export(m.data(), nullptr, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, modulus.get_mpz_t());
+
+    // Newton iteration for mod^-1 mod 2^GMP_NUMB_BITS; each step doubles the number of correct bits
+    mp_limb_t inv = 1;
+    for(unsigned int bits = 1; bits < GMP_NUMB_BITS; bits <<= 1) {
+        inv *= 2 - m[0] * inv;
+    }
+    minv = -inv;
+}
+
+const MPI & Montgomery::get_mod() const {
+    return mod;
+}
+
+mp_size_t Montgomery::size() const {
+    return n;
+}
+
+Montgomery::Residue Montgomery::to(const MPI & a) const {
+    MPI r = a % mod;
+    if (r < 0) {
+        r += mod;
+    }
+    r <<= n * GMP_NUMB_BITS;
+    r %= mod;
+
+    Residue out(n, 0);
+    mpz_export(out.data(), nullptr, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, r.get_mpz_t());
+    return out;
+}
+
+MPI Montgomery::from(const Residue & a) const {
+    Residue t(n << 1, 0);
+    std::copy(a.begin(), a.end(), t.begin());
+    redc(t.data(), t.data());
+
+    MPI out;
+    mpz_import(out.get_mpz_t(), n, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, t.data());
+    return out;
+}
+
+Montgomery::Residue Montgomery::one() const {
+    return to(1);
+}
+
+void Montgomery::mul(mp_limb_t * out, const mp_limb_t * a, const mp_limb_t * b, mp_limb_t * scratch) const {
+    mpn_mul_n(scratch, a, b, n);
+    redc(out, scratch);
+}
+
+void Montgomery::sqr(mp_limb_t * out, const mp_limb_t * a, mp_limb_t * scratch) const {
+    mpn_sqr(scratch, a, n);
+    redc(out, scratch);
+}
+
+WindowTable::WindowTable(const MPI & base, const MPI & mod, const unsigned int w)
+    : WindowTable(base, Montgomery(mod), w)
+{}
+
+WindowTable::WindowTable(const MPI & base, const Montgomery & mont, const unsigned int w)
+    : ctx(mont),
+      window(std::min(std::max(w, 1U), 8U)),
+      odd(1U << (window - 1))
+{
+    Montgomery::Residue scratch(ctx.size() << 1);
+
+    odd[0] = ctx.to(base);
+
+    Montgomery::Residue square(ctx.size());
+    ctx.sqr(square.data(), odd[0].data(), scratch.data());
+
+    for(std::size_t i = 1; i < odd.size(); i++) {
+        odd[i].resize(ctx.size());
+        ctx.mul(odd[i].data(), odd[i - 1].data(), square.data(), scratch.data());
+    }
+}
+
+const Montgomery & WindowTable::get_ctx() const {
+    return ctx;
+}
+
+unsigned int WindowTable::get_window() const {
+    return window;
+}
+
+const Montgomery::Residue & WindowTable::get(const unsigned int digit) const {
+    return odd[digit >> 1];
+}
+
+CombTable::CombTable(const MPI & base, const MPI & mod, const std::size_t bits, const unsigned int teeth)
+    : CombTable(base, Montgomery(mod), bits, teeth)
+{}
+
+CombTable::CombTable(const MPI & base, const Montgomery & mont, const std::size_t bits, const unsigned int teeth)
+    : ctx(mont),
+      bits(std::max(bits, static_cast <std::size_t> (1))),
+      teeth(std::min(std::max(teeth, 1U), 10U)),
+      spacing(0),
+      table(1U << this -> teeth)
+{
+    spacing = (this -> bits + this -> teeth - 1) / this -> teeth;
+
+    Montgomery::Residue scratch(ctx.size() << 1);
+
+    // b^(2^(i * spacing))
+    std::vector <Montgomery::Residue> powers(this -> teeth);
+    powers[0] = ctx.to(base);
+    for(unsigned int i = 1; i < this -> teeth; i++) {
+        powers[i] = powers[i - 1];
+        for(std::size_t j = 0; j < spacing; j++) {
+            ctx.sqr(powers[i].data(), powers[i].data(), scratch.data());
+        }
+    }
+
+    table[0] = ctx.one();
+    for(std::size_t j = 1; j < table.size(); j++) {
+        // highest set bit of j
+        unsigned int top = 0;
+        while ((j >> (top + 1)) != 0) {
+            top++;
+        }
+
+        table[j].resize(ctx.size());
+        ctx.mul(table[j].data(), table[j ^ (1U << top)].data(), powers[top].data(), scratch.data());
+    }
+}
+
+const Montgomery & CombTable::get_ctx() const {
+    return ctx;
+}
+
+std::size_t CombTable::get_bits() const {
+    return bits;
+}
+
+unsigned int CombTable::get_teeth() const {
+    return teeth;
+}
+
+std::size_t CombTable::get_spacing() const {
+    return spacing;
+}
+
+void CombTable::select(mp_limb_t * out, const std::size_t index) const {
+    const mp_size_t n = ctx.size();
+    std::fill(out, out + n, 0);
+    for(std::size_t i = 0; i < table.size(); i++) {
+        const mp_limb_t mask = -static_cast <mp_limb_t> (i == index);
+        for(mp_size_t j = 0; j < n; j++) {
+            out[j] |= table[i][j] & mask;
+        }
+    }
+}
+
+unsigned int window_size(const std::size_t bits) {
+    if (bits > 671) {
+        return 6;
+    }
+    if (bits > 239) {
+        return 5;
+    }
+    if (bits > 79) {
+        return 4;
+    }
+    if (bits > 23) {
+        return 3;
+    }
+    if (bits > 7) {
+        return 2;
+    }
+    return 1;
+}
+
+MPI powm(const WindowTable & base, const MPI & exp) {
+    const Montgomery & ctx = base.get_ctx();
+    const std::vector <uint8_t> digits = recode(exp, base.get_window());
+
+    Montgomery::Residue acc = ctx.one();
+    Montgomery::Residue scratch(ctx.size() << 1);
+    bool started = false;
+
+    for(std::size_t i = digits.size(); i > 0; i--) {
+        if (started) {
+            ctx.sqr(acc.data(), acc.data(), scratch.data());
+        }
+
+        if (digits[i - 1]) {
+            if (started) {
+                ctx.mul(acc.data(), acc.data(), base.get(digits[i - 1]).data(), scratch.data());
+            }
+            else {
+                acc = base.get(digits[i - 1]);
+                started = true;
+            }
+        }
+    }
+
+    return ctx.from(acc);
+}
+
+MPI powm(const WindowTable & a, const MPI & x, const WindowTable & b, const MPI & y) {
+    const Montgomery & ctx = a.get_ctx();
+    if (ctx.get_mod() != b.get_ctx().get_mod()) {
+        throw std::runtime_error("Error: Window tables have different moduli.");
+    }
+
+    std::vector <uint8_t> xd = recode(x, a.get_window());
+    std::vector <uint8_t> yd = recode(y, b.get_window());
+    const std::size_t bits = std::max(xd.size(), yd.size());
+    xd.resize(bits, 0);
+    yd.resize(bits, 0);
+
+    Montgomery::Residue acc = ctx.one();
+    Montgomery::Residue scratch(ctx.size() << 1);
+    bool started = false;
+
+    for(std::size_t i = bits; i > 0; i--) {
+        if (started) {
+            ctx.sqr(acc.data(), acc.data(), scratch.data());
+        }
+
+        if (xd[i - 1]) {
+            if (started) {
+                ctx.mul(acc.data(), acc.data(), a.get(xd[i - 1]).data(), scratch.data());
+            }
+            else {
+                acc = a.get(xd[i - 1]);
+                started = true;
+            }
+        }
+
+        if (yd[i - 1]) {
+            if (started) {
+                ctx.mul(acc.data(), acc.data(), b.get(yd[i - 1]).data(), scratch.data());
+            }
+            else {
+                acc = b.get(yd[i - 1]);
+                started = true;
+            }
+        }
+    }
+
+    return ctx.from(acc);
+}
+
+MPI powm_sec(const CombTable & base, const MPI & exp) {
+    const std::size_t bits = base.get_teeth() * base.get_spacing();
+    if ((exp < 0) || (mpz_sizeinbase(exp.get_mpz_t(), 2) > base.get_bits())) {
+        throw std::runtime_error("Error: Exponent is too large for comb table.");
+    }
+
+    // fixed length copy of the exponent so that reading bits does not depend on its size
+    std::vector <mp_limb_t> e((bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS, 0);
+    mpz_export(e.data(), nullptr, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, exp.get_mpz_t());
+
+    const Montgomery & ctx = base.get_ctx();
+    Montgomery::Residue acc = ctx.one();
+    Montgomery::Residue entry(ctx.size());
+    Montgomery::Residue scratch(ctx.size() << 1);
+
+    for(std::size_t k = base.get_spacing(); k > 0; k--) {
+        ctx.sqr(acc.data(), acc.data(), scratch.data());
+
+        std::size_t index = 0;
+        for(unsigned int i = 0; i < base.get_teeth(); i++) {
+            const std::size_t pos = i * base.get_spacing() + k - 1;
+            index |= static_cast <std::size_t> ((e[pos / GMP_NUMB_BITS] >> (pos % GMP_NUMB_BITS)) & 1) << i;
+        }
+
+        base.select(entry.data(), index);
+        ctx.mul(acc.data(), acc.data(), entry.data(), scratch.data());
+    }
+
+    return ctx.from(acc);
+}
+
+}
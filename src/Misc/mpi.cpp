@@ -1,5 +1,8 @@
 #include "Misc/mpi.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "Misc/pgptime.h"
 #include "RNG/RNGs.h"
 #include "common/includes.h"
@@ -19,7 +22,13 @@ MPI bintompi(const std::string & bin) {
 }
 
 MPI rawtompi(const std::string & raw) {
-    return hextompi(hexlify(raw));
+    return rawtompi(raw.data(), raw.size());
+}
+
+MPI rawtompi(const char * raw, const std::size_t size) {
+    MPI out;
+    mpz_import(out.get_mpz_t(), size, 1, 1, 1, 0, raw);
+    return out;
 }
 
 std::string mpitohex(const MPI & a) {
@@ -39,7 +48,16 @@ std::string mpitobin(const MPI & a) {
 }
 
 std::string mpitoraw(const MPI & a) {
-    return unhexlify(mpitohex(a));
+    std::string out(bytesize(a), 0);
+    mpitoraw(a, &out[0]);
+    return out;
+}
+
+std::size_t mpitoraw(const MPI & a, char * out) {
+    // 0 is written as a single zero octet, but mpz_export does not write anything for it
+    out[0] = 0;
+    mpz_export(out, nullptr, 1, 1, 1, 0, a.get_mpz_t());
+    return bytesize(a);
 }
 
 unsigned long mpitoulong(const MPI & a) {
@@ -47,7 +65,11 @@ unsigned long mpitoulong(const MPI & a) {
 }
 
 std::size_t bitsize(const MPI &a) {
-    return mpitobin(a).size();
+    return mpz_sizeinbase(a.get_mpz_t(), 2);
+}
+
+std::size_t bytesize(const MPI & a) {
+    return (bitsize(a) + 7) >> 3;
 }
 
 bool knuth_prime_test(const MPI & a, int test) {
@@ -83,33 +105,47 @@ MPI invert(const MPI &a, const MPI &b) {
 }
 
 MPI random(unsigned int bits) {
-    return bintompi(RNG::RNG().rand_bits(bits));
+    return RNG::random_mpi(bits);
 }
 
 // given some value, return the formatted mpi
 std::string write_MPI(const MPI & data) {
-    const std::string out = mpitoraw(data);
-    return unhexlify(makehex(bitsize(data), 4)) + out;
+    std::string out;
+    write_MPI(data, out);
+    return out;
+}
+
+void write_MPI(const MPI & data, std::string & out) {
+    const std::string::size_type pos = out.size();
+    out.resize(pos + 2 + bytesize(data));
+    write_MPI(data, &out[pos]);
+}
+
+std::size_t write_MPI(const MPI & data, char * out) {
+    const std::size_t bits = bitsize(data);
+    out[0] = (bits >> 8) & 0xff;
+    out[1] =  bits       & 0xff;
+    return 2 + mpitoraw(data, out + 2);
 }
 
 // Read mpi from data, returning mpi value. The position will be updated to the octet after the end of the mpi value
 MPI read_MPI(const std::string & data, std::string::size_type & pos) {
     // get number of bits
-    uint16_t size = (static_cast <uint8_t> (data[pos]) << 8) |
-                     static_cast <uint8_t> (data[pos + 1]);
+    const uint16_t bits = (static_cast <uint8_t> (data[pos]) << 8) |
+                           static_cast <uint8_t> (data[pos + 1]);
     // update position
     pos += 2;
 
-    // pad to nearest 8 bits
-    while (size & 7) {
-        size++;
+    // do not read past the end of the data
+    if (pos > data.size()) {
+        throw std::out_of_range("Error: MPI starts past the end of the data.");
     }
 
     // get number of octets
-    size >>= 3;
+    const std::string::size_type size = std::min((static_cast <std::string::size_type> (bits) + 7) >> 3, data.size() - pos);
 
     // turn to mpz_class
-    const MPI out = rawtompi(data.substr(pos, size));
+    const MPI out = rawtompi(data.data() + pos, size);
     pos += size;
     return out;
 }
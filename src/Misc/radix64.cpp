@@ -1,82 +1,133 @@
 #include "Misc/radix64.h"
 
-#include "common/includes.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
 namespace OpenPGP {
 
-std::string ascii2radix64(std::string str, const unsigned char char62, const unsigned char char63) {
-    std::string out = "", bin = "", pad = "";
-    while (str.size() % 3) {
-        str += zero;
-        pad += "=";
-    }
+static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
 
-    for(char const c : str) {
-        bin += makebin(c, 8);
-    }
+// marks characters that are not in the alphabet
+// every valid value fits in 6 bits, so this bit can be checked once per group
+static const uint8_t INVALID = 0x80;
 
-    std::string::size_type x = 0;
-    while (x < bin.size()) {
-        out += ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" + std::string(1, char62) + std::string(1, char63))[toint(bin.substr(x, 6), 2)];
-        x += 6;
+typedef std::array <uint8_t, 256> DecodeTable;
+
+// decoding table for the 62 fixed characters; char62 and char63 are filled in per call
+static DecodeTable base_decode_table() {
+    DecodeTable table;
+    table.fill(INVALID);
+    for(uint8_t i = 0; i < 62; i++) {
+        table[static_cast <unsigned char> (ALPHABET[i])] = i;
     }
+    return table;
+}
 
-    if (pad.size() == 2) {                       // string length % 3 == 1
-        out.pop_back();
-        out.pop_back();
+static const DecodeTable BASE_DECODE = base_decode_table();
+
+std::string ascii2radix64(const std::string & str, const unsigned char char62, const unsigned char char63) {
+    char table[64];
+    std::copy(ALPHABET, ALPHABET + 62, table);
+    table[62] = char62;
+    table[63] = char63;
+
+    const std::string::size_type full = str.size() - (str.size() % 3);
+    std::string out(((str.size() + 2) / 3) * 4, '=');
+
+    const unsigned char * in = reinterpret_cast <const unsigned char *> (str.data());
+    char * dst = &out[0];
+    for(std::string::size_type i = 0; i < full; i += 3) {
+        const uint32_t group = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        *dst++ = table[(group >> 18) & 0x3f];
+        *dst++ = table[(group >> 12) & 0x3f];
+        *dst++ = table[(group >>  6) & 0x3f];
+        *dst++ = table[ group        & 0x3f];
     }
 
-    if (pad.size() == 1) {                       // string length % 3 == 2
-        out.pop_back();
+    // last group is zero filled; the rest of the output is already padding
+    if (full < str.size()) {
+        uint32_t group = in[full] << 16;
+        if (full + 1 < str.size()) {
+            group |= in[full + 1] << 8;
+        }
+
+        *dst++ = table[(group >> 18) & 0x3f];
+        *dst++ = table[(group >> 12) & 0x3f];
+        if (full + 1 < str.size()) {
+            *dst++ = table[(group >> 6) & 0x3f];
+        }
     }
 
-    return out + pad;
+    return out;
 }
 
-std::string radix642ascii(std::string str, const unsigned char char62, const unsigned char char63) {
+std::string radix642ascii(const std::string & str, const unsigned char char62, const unsigned char char63) {
     if (str.size() & 3) {
         // throw std::runtime_error("Error: Input string length is not a multiple of 4."
         return "";
     }
 
-    std::string bin = "";
-
     // count padding
+    std::string::size_type length = str.size();
     uint8_t unpad = 0;
-    while (str[str.size() - 1] == '=') {
+    while (length && (str[length - 1] == '=')) {
         unpad++;
-        str = str.substr(0, str.size() - 1);
+        length--;
     }
 
-    for(unsigned char c : str) {
-        if (('A' <= c) && (c <= 'Z')) {
-            bin += makebin(c - 'A', 6);
-        }
-        else if (('a' <= c) && (c <= 'z')) {
-            bin += makebin(c - 'G', 6);
-        }
-        else if (('0' <= c) && (c <= '9')) {
-            bin += makebin(c + 4, 6);
-        }
-        else if (c == char62) {
-            bin += "111110";
-        }
-        else if (c == char63) {
-            bin += "111111";
+    DecodeTable table = BASE_DECODE;
+    table[char62] = 62;
+    table[char63] = 63;
+
+    const unsigned char * in = reinterpret_cast <const unsigned char *> (str.data());
+
+    // find the character that made a group invalid
+    auto invalid = [&](const std::string::size_type start) {
+        for(std::string::size_type i = start; i < length; i++) {
+            if (table[in[i]] & INVALID) {
+                throw std::runtime_error("Error: Invalid Radix64 character found: " + std::string(1, in[i]));
+            }
         }
-        else{
-            throw std::runtime_error("Error: Invalid Radix64 character found: " + std::string(1, c));
+    };
+
+    const std::string::size_type full = length & ~static_cast <std::string::size_type> (3);
+    std::string out((str.size() / 4) * 3, 0);
+    char * dst = &out[0];
+    for(std::string::size_type i = 0; i < full; i += 4) {
+        const uint8_t a = table[in[i]];
+        const uint8_t b = table[in[i + 1]];
+        const uint8_t c = table[in[i + 2]];
+        const uint8_t d = table[in[i + 3]];
+        if ((a | b | c | d) & INVALID) {
+            invalid(i);
         }
+
+        const uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+        *dst++ = static_cast <char> (group >> 16);
+        *dst++ = static_cast <char> (group >>  8);
+        *dst++ = static_cast <char> (group);
     }
 
-    bin += std::string(unpad * 6, '0');
+    // last group had padding removed; decode what is left as if it were zero filled
+    if (full < length) {
+        uint32_t group = 0;
+        for(std::string::size_type i = full; i < length; i++) {
+            const uint8_t value = table[in[i]];
+            if (value & INVALID) {
+                invalid(i);
+            }
+            group |= value << (18 - 6 * (i - full));
+        }
 
-    str = "";
-    for(unsigned int x = 0; x < bin.size(); x += 8) {
-        str += std::string(1, static_cast <unsigned char> (toint(bin.substr(x, 8), 2)));
+        *dst++ = static_cast <char> (group >> 16);
+        *dst++ = static_cast <char> (group >>  8);
+        *dst++ = static_cast <char> (group);
     }
 
-    return str.substr(0, str.size() - unpad);   // remove padding when returning
+    // remove padding when returning
+    out.resize((unpad < out.size())?(out.size() - unpad):0);
+    return out;
 }
 
 }
@@ -7,6 +7,8 @@
 #include "Misc/CRC-24.h"
 #include "Misc/Length.h"
 #include "Packets/Packets.h"
+#include "common/Arena.h"
+#include "common/MappedFile.h"
 #include "common/includes.h"
 
 namespace OpenPGP {
@@ -74,8 +76,58 @@ uint8_t PGP::read_packet_header(const std::string & data, std::string::size_type
     return tag;
 }
 
+typedef std::pair <std::string::size_type, std::size_t> Piece;
+typedef std::vector <Piece> Pieces;
+
+// walks a body split over Partial Body Lengths, starting at its first length header
+// the (start, length) of each piece is added to pieces (if given) without copying anything
+// total is set to the length of the body and pos is moved past the last piece
+// returns false if the data ended before a final, non-partial length header
+static bool partial_pieces(const std::string & data, std::string::size_type & pos, const Packet::HeaderFormat format, Pieces * pieces, std::size_t & total) {
+    total = 0;
+    while ((pos < data.size())                                        &&
+           (Packet::PARTIAL_BODY_LENGTH_START <= (uint8_t) data[pos]) &&
+           ((uint8_t) data[pos] <= Packet::PARTIAL_BODY_LENGTH_END)) {
+        const std::size_t length = read_partialBodyLen(data[pos], format);
+        pos++;
+        if (pieces) {
+            pieces -> push_back(Piece(pos, length));
+        }
+        pos += length;
+        total += length;
+    }
+
+    // 4.2.2.4.  Partial Body Lengths
+    //
+    //     The last length header in the packet MUST NOT be a Partial Body Length header.
+    if (pos >= data.size()) {
+        return false;
+    }
+
+    std::size_t length = 0;
+    const uint8_t first_octet = data[pos];
+    if (first_octet < 192) {
+        read_one_octet_lengths(data, pos, length, format);
+    }
+    else if (first_octet < 224) {
+        read_two_octet_lengths(data, pos, length, format);
+    }
+    else {
+        read_five_octet_lengths(data, pos, length, format);
+    }
+
+    if (pieces) {
+        pieces -> push_back(Piece(pos, length));
+    }
+    pos += length;
+    total += length;
+
+    return true;
+}
+
 // reads the length of the packet data and extracts the start and length of the packet data
-// if partial returns Packet::PARTIAL, the partial_data variable should be used instead of data
+// if partial returns Packet::PARTIAL and partial_data is not empty, partial_data holds the
+// joined body and should be used instead of data; otherwise the body is still inside data
 // format should have been set to OLD or NEW
 // pos should be on the first octet of the packet header length
 Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderFormat format,
@@ -107,7 +159,7 @@ Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderForma
             packet_length = data.size() - pos;                                // header is one octet long
             hl = 0;
             pos += hl;
-            partial_data = data.substr(pos, packet_length);
+            packet_start = pos;                                               // the body is contiguous, so it is not copied out
             pos += packet_length;
             partial = Packet::PARTIAL;
         }
@@ -131,41 +183,22 @@ Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderForma
             pos += packet_length;
         }
         else if (Packet::PARTIAL_BODY_LENGTH_START <= first_octet) {         // unknown; When the length of the packet body is not known in advance by the issuer, Partial Body Length headers encode a packet of indeterminate length, effectively making it a stream.
-            // get the first partial body length
-            packet_length = read_partialBodyLen(first_octet, format);
-
             // warn if RFC 4880 sec 4.2.2.4 is not followed
-            if (packet_length < 512) {
-                std::cerr << "Warning: The first partial length MUST be at least 512 octets long (Got " << packet_length << ")" << std::endl;
+            const std::size_t first_length = read_partialBodyLen(first_octet, format);
+            if (first_length < 512) {
+                std::cerr << "Warning: The first partial length MUST be at least 512 octets long (Got " << first_length << ")" << std::endl;
             }
 
-            hl = 1;
-            pos += hl;
-            partial_data = data.substr(pos, packet_length);
-            pos += packet_length;
-
-            // get the rest of them
-            while ((Packet::PARTIAL_BODY_LENGTH_START <= (uint8_t) data[pos]) &&
-                   ((uint8_t) data[pos] <= Packet::PARTIAL_BODY_LENGTH_END)) {
-                packet_length = read_partialBodyLen(data[pos], format);
-                pos += hl;
-                partial_data += data.substr(pos, packet_length);
-                pos += packet_length;
-            }
-
-            // 4.2.2.4.  Partial Body Lengths
-            //
-            //     The last length header in the packet MUST NOT be a Partial Body Length header.
-            std::string::size_type final_start = 0;
-            std::string::size_type final_length = 0;
-            std::string not_used;
-            if (read_packet_unformatted(format, ctb, data, pos, final_start, final_length, not_used) == Packet::PARTIAL) {
+            // find all of the pieces first so that they are copied exactly once
+            Pieces pieces;
+            std::size_t total = 0;
+            if (!partial_pieces(data, pos, format, &pieces, total)) {
                 std::cerr << "Warning: Reached end of data, but did not complete partial packet sequence" << std::endl;
             }
-            else {
-                // add the final piece
-                partial_data += data.substr(final_start, final_length);
-                pos += final_length;
+
+            partial_data.reserve(partial_data.size() + total);
+            for(Piece const & piece : pieces) {
+                partial_data.append(data, piece.first, piece.second);
             }
 
             packet_start = 0;
@@ -177,81 +210,85 @@ Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderForma
     return partial;
 }
 
-Packet::Tag::Ptr PGP::read_packet_raw(const std::string & data, std::string::size_type & pos, const std::string::size_type & length, const uint8_t tag, const Packet::HeaderFormat format, const Packet::PartialBodyLength & partial) const {
+static void check_partial(const uint8_t tag, const Packet::PartialBodyLength & partial) {
     if ((partial == Packet::PARTIAL) &&
         !Packet::can_have_partial_length(tag)) {
         throw std::runtime_error("An implementation MAY use Partial Body Lengths for data packets, be "
                                  "they literal, compressed, or encrypted. ... Partial Body Lengths MUST NOT be "
                                  "used for any other packet types.");
     }
+}
+
+Packet::Tag::Ptr PGP::read_packet_raw(const std::string & data, std::string::size_type & pos, const std::string::size_type & length, const uint8_t tag, const Packet::HeaderFormat format, const Packet::PartialBodyLength & partial) const {
+    check_partial(tag, partial);
 
     Packet::Tag::Ptr out = nullptr;
     switch (tag) {
         case Packet::RESERVED:
-            out = std::make_shared <Packet::Tag0> ();
+            out = make_shared_in_arena <Packet::Tag0> ();
             break;
         case Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY:
-            out = std::make_shared <Packet::Tag1> ();
+            out = make_shared_in_arena <Packet::Tag1> ();
             break;
         case Packet::SIGNATURE:
-            out = std::make_shared <Packet::Tag2> ();
+            out = make_shared_in_arena <Packet::Tag2> ();
             break;
         case Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY:
-            out = std::make_shared <Packet::Tag3> ();
+            out = make_shared_in_arena <Packet::Tag3> ();
             break;
         case Packet::ONE_PASS_SIGNATURE:
-            out = std::make_shared <Packet::Tag4> ();
+            out = make_shared_in_arena <Packet::Tag4> ();
             break;
         case Packet::SECRET_KEY:
-            out = std::make_shared <Packet::Tag5> ();
+            out = make_shared_in_arena <Packet::Tag5> ();
             break;
         case Packet::PUBLIC_KEY:
-            out = std::make_shared <Packet::Tag6> ();
+            out = make_shared_in_arena <Packet::Tag6> ();
             break;
         case Packet::SECRET_SUBKEY:
-            out = std::make_shared <Packet::Tag7> ();
+            out = make_shared_in_arena <Packet::Tag7> ();
             break;
         case Packet::COMPRESSED_DATA:
-            out = std::make_shared <Packet::Tag8> (partial);
+            out = make_shared_in_arena <Packet::Tag8> (partial);
             break;
         case Packet::SYMMETRICALLY_ENCRYPTED_DATA:
-            out = std::make_shared <Packet::Tag9> (partial);
+            out = make_shared_in_arena <Packet::Tag9> (partial);
             break;
         case Packet::MARKER_PACKET:
-            out = std::make_shared <Packet::Tag10> ();
+            out = make_shared_in_arena <Packet::Tag10> ();
             break;
         case Packet::LITERAL_DATA:
-            out = std::make_shared <Packet::Tag11> (partial);
+            out = make_shared_in_arena <Packet::Tag11> (partial);
             break;
         case Packet::TRUST:
-            out = std::make_shared <Packet::Tag12> ();
+            out = make_shared_in_arena <Packet::Tag12> ();
             break;
         case Packet::USER_ID:
-            out = std::make_shared <Packet::Tag13> ();
+            out = make_shared_in_arena <Packet::Tag13> ();
             break;
         case Packet::PUBLIC_SUBKEY:
-            out = std::make_shared <Packet::Tag14> ();
+            out = make_shared_in_arena <Packet::Tag14> ();
             break;
         case Packet::USER_ATTRIBUTE:
-            out = std::make_shared <Packet::Tag17> ();
+            out = make_shared_in_arena <Packet::Tag17> ();
             break;
         case Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:
-            out = std::make_shared <Packet::Tag18> (partial);
+            out = make_shared_in_arena <Packet::Tag18> (partial);
             break;
         case Packet::MODIFICATION_DETECTION_CODE:
-            out = std::make_shared <Packet::Tag19> ();
+            out = make_shared_in_arena <Packet::Tag19> ();
             break;
         case 60:
-            out = std::make_shared <Packet::Tag60> ();
+            out = make_shared_in_arena <Packet::Tag60> ();
             break;
         case 61:
-            out = std::make_shared <Packet::Tag61> ();
+            out = make_shared_in_arena <Packet::Tag61> ();
             break;
         case 62:
-            out = std::make_shared <Packet::Tag62> ();
+            out = make_shared_in_arena <Packet::Tag62> ();
             break;
         case 63:
-            out = std::make_shared <Packet::Tag63> ();
+            out = make_shared_in_arena <Packet::Tag63> ();
             break;
         default:
             throw std::runtime_error("Error: Tag not defined: " + std::to_string(tag) + ".");
@@ -281,10 +318,50 @@ Packet::Tag::Ptr PGP::read_packet(const std::string & data, std::string::size_ty
     std::string::size_type packet_start = 0;
     std::string::size_type packet_size = 0;
     std::string partial_data;
-    return (read_packet_unformatted(format, ctb, data, pos, packet_start, packet_size, partial_data) == Packet::NOT_PARTIAL)?
-        // convert the packet data into an object
-        read_packet_raw(data,         packet_start, packet_size, tag, format, Packet::NOT_PARTIAL):
-        read_packet_raw(partial_data, packet_start, packet_size, tag, format, Packet::PARTIAL);
+    const Packet::PartialBodyLength partial = read_packet_unformatted(format, ctb, data, pos, packet_start, packet_size, partial_data);
+
+    // convert the packet data into an object
+    // only a body split over several partial lengths had to be joined into a copy
+    return read_packet_raw(partial_data.size()?partial_data:data, packet_start, packet_size, tag, format, partial);
+}
+
+PGP::Index_Entry PGP::index_packet(const std::string & data, std::string::size_type & pos) const {
+    Index_Entry entry;
+    entry.offset = pos;
+
+    uint8_t ctb = 0;
+    read_packet_header(data, pos, ctb, entry.format, entry.tag);
+
+    std::string::size_type start = 0;
+    std::string not_used;
+    if ((entry.format == Packet::HeaderFormat::NEW)                       &&
+        (pos < data.size())                                               &&
+        (Packet::PARTIAL_BODY_LENGTH_START <= (uint8_t) data[pos])        &&
+        ((uint8_t) data[pos] <= Packet::PARTIAL_BODY_LENGTH_END)) {
+        // step over the pieces instead of joining them
+        partial_pieces(data, pos, entry.format, nullptr, entry.length);
+        entry.partial = Packet::PARTIAL;
+    }
+    else {
+        entry.partial = read_packet_unformatted(entry.format, ctb, data, pos, start, entry.length, not_used);
+    }
+
+    check_partial(entry.tag, entry.partial);
+
+    return entry;
+}
+
+void PGP::parse_all() const {
+    if (!source) {
+        return;
+    }
+
+    for(Packets::size_type i = 0; i < packets.size(); i++) {
+        get_packet(i);
+    }
+
+    // every packet has its own copy of its body now
+    source.reset();
 }
 
 std::string PGP::format_string(const std::string & data, const uint8_t line_length) const {
@@ -292,7 +369,8 @@ std::string PGP::format_string(const std::string & data, const uint8_t line_leng
     const std::div_t res = div(data.size(), line_length);
     out.reserve((res.quot + static_cast <bool> (res.rem)) * (line_length + 1));
     for(unsigned int i = 0; i < data.size(); i += line_length) {
-        out += data.substr(i, line_length) + "\n";
+        out.append(data, i, line_length);
+        out += '\n';
     }
     return out;
 }
@@ -301,15 +379,32 @@ PGP::PGP()
     : armored(Armored::YES),
       type(UNKNOWN),
       keys(),
-      packets()
+      packets(),
+      lazy(false),
+      index(),
+      source(),
+      use_arena(false),
+      arena()
 {}
 
 PGP::PGP(const PGP & copy)
     : armored(copy.armored),
       type(copy.type),
       keys(copy.keys),
-      packets(copy.get_packets_clone())
-{}
+      packets(copy.packets),
+      lazy(copy.lazy),
+      index(copy.index),
+      source(copy.source),
+      use_arena(copy.use_arena),
+      arena()
+{
+    // packets that have not been parsed yet share the unmodified source
+    for(Packet::Tag::Ptr & p : packets) {
+        if (p) {
+            p = p -> clone();
+        }
+    }
+}
 
 PGP::PGP(const std::string & data)
     : PGP()
@@ -325,8 +420,14 @@ PGP::PGP(std::istream & stream)
 
 PGP::~PGP() {}
 
+PGP PGP::from_file(const std::string & path) {
+    return read_mapped <PGP> (path);
+}
+
 void PGP::read(const std::string & data) {
-    std::stringstream s(data);
+    // read the string in place instead of copying it into a std::stringstream
+    MemoryBuffer buf(data.data(), data.size());
+    std::istream s(&buf);
     read(s);
 }
 
@@ -468,13 +569,37 @@ void PGP::read(std::istream & stream) {
 
 void PGP::read_raw(const std::string & data) {
     packets.clear();
+    index.clear();
+    source.reset();
+
+    // every read gets its own arena; packets from earlier reads keep theirs alive
+    // lazy reads create it when the first packet is parsed
+    arena.reset();
+    if (use_arena && !lazy) {
+        arena = std::make_shared <Arena> ();
+    }
 
-    // read each packet
     std::string::size_type pos = 0;
-    while (pos < data.size()) {
-        Packet::Tag::Ptr packet = read_packet(data, pos);
-        if (packet) {
-            packets.push_back(packet);
+    if (lazy) {
+        // only find the packet boundaries; packets are parsed when accessed
+        while (pos < data.size()) {
+            index.push_back(index_packet(data, pos));
+        }
+
+        packets.resize(index.size());
+        if (index.size()) {
+            source = std::make_shared <const std::string> (data);
+        }
+    }
+    else {
+        const Arena::Scope scope(arena?arena:Arena::current());
+
+        // read each packet
+        while (pos < data.size()) {
+            Packet::Tag::Ptr packet = read_packet(data, pos);
+            if (packet) {
+                packets.push_back(packet);
+            }
         }
     }
 
@@ -483,6 +608,20 @@ void PGP::read_raw(const std::string & data) {
 }
 
 void PGP::read_raw(std::istream & stream) {
+    // read the rest of the stream in one go if its size can be found
+    const std::istream::pos_type start = stream.tellg();
+    if ((start != std::istream::pos_type(-1)) && stream.seekg(0, std::ios::end)) {
+        const std::istream::pos_type end = stream.tellg();
+        stream.seekg(start);
+
+        std::string data(end - start, 0);
+        stream.read(&data[0], data.size());
+        data.resize(stream.gcount());
+        read_raw(data);
+        return;
+    }
+
+    stream.clear();
     read_raw(std::string(std::istreambuf_iterator <char> (stream), {}));
 }
 
@@ -493,19 +632,27 @@ std::string PGP::show(const std::size_t indents, const std::size_t indent_size)
 }
 
 void PGP::show(HumanReadable & hr) const {
-    for(Packet::Tag::Ptr const & p : packets) {
+    for(Packet::Tag::Ptr const & p : get_packets()) {
         p -> show(hr);
     }
 }
 
 std::string PGP::raw(Status * status, const bool check_mpi) const {
-    std::string out = "";
-    for(Packet::Tag::Ptr const & p : packets) {
+    // size everything first so the packets are written straight into one buffer
+    const Packets & all = get_packets();
+    std::size_t size = 0;
+    for(Packet::Tag::Ptr const & p : all) {
         if (status && (*status = p -> valid(check_mpi)) != Status::SUCCESS) {
             return "";
         }
 
-        out += p -> write();
+        size += p -> write_size();
+    }
+
+    std::string out;
+    out.reserve(size);
+    for(Packet::Tag::Ptr const & p : all) {
+        p -> write_into(out);
     }
     return out;
 }
@@ -521,12 +668,19 @@ std::string PGP::write(const PGP::Armored armor, Status * status, const bool che
         return packet_string;
     }
 
-    std::string out = PGP::ASCII_Armor_Begin + ASCII_Armor_Header[type] + PGP::ASCII_Armor_5_Dashes + "\n";
+    const std::string body = format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH);
+
+    std::string out;
+    out.reserve(body.size() + 256);
+    out += PGP::ASCII_Armor_Begin + ASCII_Armor_Header[type] + PGP::ASCII_Armor_5_Dashes + "\n";
     for(Armor_Key const & key : keys) {
         out += key.first + ": " + key.second + "\n";
     }
-
-    return out + "\n" + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH) + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) + "\n" + PGP::ASCII_Armor_End + ASCII_Armor_Header[type] + PGP::ASCII_Armor_5_Dashes;
+    out += "\n";
+    out += body;
+    out += "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) + "\n";
+    out += PGP::ASCII_Armor_End + ASCII_Armor_Header[type] + PGP::ASCII_Armor_5_Dashes;
+    return out;
 }
 
 bool PGP::get_armored() const {
@@ -541,12 +695,55 @@ const PGP::Armor_Keys & PGP::get_keys() const {
     return keys;
 }
 
+bool PGP::get_lazy() const {
+    return lazy;
+}
+
+bool PGP::get_use_arena() const {
+    return use_arena;
+}
+
+Arena::Ptr PGP::get_arena() const {
+    return arena;
+}
+
+const PGP::Index & PGP::get_index() const {
+    return index;
+}
+
+PGP::Packets::size_type PGP::size() const {
+    return packets.size();
+}
+
+uint8_t PGP::get_tag(const PGP::Packets::size_type i) const {
+    if (index.size()) {
+        return index[i].tag;
+    }
+
+    return packets[i] -> get_tag();
+}
+
+const Packet::Tag::Ptr & PGP::get_packet(const PGP::Packets::size_type i) const {
+    if (!packets[i] && source) {
+        if (use_arena && !arena) {
+            arena = std::make_shared <Arena> ();
+        }
+
+        const Arena::Scope scope(arena?arena:Arena::current());
+        std::string::size_type pos = index[i].offset;
+        packets[i] = read_packet(*source, pos);
+    }
+
+    return packets[i];
+}
+
 const PGP::Packets & PGP::get_packets() const {
+    parse_all();
     return packets;
 }
 
 PGP::Packets PGP::get_packets_clone() const {
-    Packets out = packets;
+    Packets out = get_packets();
     for(Packet::Tag::Ptr & p : out) {
         p = p -> clone();
     }
@@ -557,6 +754,14 @@ void PGP::set_armored(const bool a) {
     armored = a;
 }
 
+void PGP::set_lazy(const bool l) {
+    lazy = l;
+}
+
+void PGP::set_use_arena(const bool a) {
+    use_arena = a;
+}
+
 void PGP::set_type(const PGP::Type_t t) {
     type = t;
 }
@@ -567,10 +772,14 @@ void PGP::set_keys(const PGP::Armor_Keys & k) {
 
 void PGP::set_packets(const PGP::Packets & p) {
     packets = p;
+    index.clear();
+    source.reset();
 }
 
 void PGP::set_packets_clone(const PGP::Packets & p) {
     packets = p;
+    index.clear();
+    source.reset();
     for(Packet::Tag::Ptr & p : packets) {
         p = p -> clone();
     }
@@ -585,13 +794,13 @@ bool PGP::operator==(const PGP & rhs) const {
     //     return false;
     // }
 
-    if (packets.size() != rhs.packets.size()) {
+    if (size() != rhs.size()) {
         return false;
     }
 
     // compare strings for now, until Packets and Subpackets get operator==
-    for(std::size_t i = 0; i < packets.size(); i++) {
-        if (!packets[i] || !rhs.packets[i]) {
+    for(std::size_t i = 0; i < size(); i++) {
+        if (!get_packet(i) || !rhs.get_packet(i)) {
             return false;
         }
 
@@ -607,7 +816,17 @@ PGP & PGP::operator=(const PGP & copy) {
     armored = copy.armored;
     type = copy.type;
     keys = copy.keys;
-    packets = copy.get_packets_clone();
+    packets = copy.packets;
+    lazy = copy.lazy;
+    index = copy.index;
+    source = copy.source;
+    use_arena = copy.use_arena;
+    arena.reset();
+    for(Packet::Tag::Ptr & p : packets) {
+        if (p) {
+            p = p -> clone();
+        }
+    }
     return *this;
 }
 
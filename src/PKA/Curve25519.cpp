@@ -0,0 +1,896 @@
+#include "PKA/Curve25519.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gmpxx.h>
+
+#include "Hashes/Hashes.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace Curve25519 {
+
+// double width products for the field arithmetic
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_t;
+
+static inline uint128_t mul64(const uint64_t a, const uint64_t b) {
+    return static_cast <uint128_t> (a) * b;
+}
+
+static inline uint64_t lo64(const uint128_t x) {
+    return static_cast <uint64_t> (x);
+}
+
+static inline uint64_t shr51(const uint128_t x) {
+    return static_cast <uint64_t> (x >> 51);
+}
+#else
+// targets without a 128 bit type (32 bit platforms) build the products out of 32 bit halves
+struct uint128_t {
+    uint64_t lo, hi;
+};
+
+static inline uint128_t mul64(const uint64_t a, const uint64_t b) {
+    const uint64_t a0 = a & 0xffffffff, a1 = a >> 32;
+    const uint64_t b0 = b & 0xffffffff, b1 = b >> 32;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    return uint128_t{(mid << 32) | (p00 & 0xffffffff), p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32)};
+}
+
+static inline uint128_t operator+(const uint128_t & a, const uint128_t & b) {
+    const uint64_t lo = a.lo + b.lo;
+    return uint128_t{lo, a.hi + b.hi + (lo < a.lo)};
+}
+
+static inline uint128_t & operator+=(uint128_t & a, const uint64_t b) {
+    a.lo += b;
+    a.hi += (a.lo < b);
+    return a;
+}
+
+static inline uint64_t lo64(const uint128_t x) {
+    return x.lo;
+}
+
+static inline uint64_t shr51(const uint128_t x) {
+    return (x.lo >> 51) | (x.hi << 13);
+}
+#endif
+
+static const uint64_t MASK51 = (static_cast <uint64_t> (1) << 51) - 1;
+
+// -121665 / 121666
+static const uint8_t D_BYTES[SIZE] = {
+    0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+    0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52,
+};
+
+// 2^((p - 1) / 4)
+static const uint8_t SQRTM1_BYTES[SIZE] = {
+    0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b,
+};
+
+// base point (x, 4/5) with positive x
+static const uint8_t BASE_BYTES[SIZE] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+};
+
+// group order 2^252 + 27742317777372353535851937790883648493
+static const uint8_t L_BYTES[SIZE] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+// window widths of the variable time multi-scalar multiplication
+static const int BASE_WINDOW = 8;
+static const int POINT_WINDOW = 5;
+
+// element of GF(2^255 - 19) as 5 limbs of 51 bits
+// limbs may exceed 51 bits by a few bits between operations
+struct Fe {
+    uint64_t v[5];
+};
+
+static Fe fe(const uint64_t x) {
+    return Fe{{x, 0, 0, 0, 0}};
+}
+
+static uint64_t load64(const uint8_t * s) {
+    uint64_t out = 0;
+    for(int i = 7; i >= 0; i--) {
+        out = (out << 8) | s[i];
+    }
+    return out;
+}
+
+static void store64(uint8_t * s, uint64_t x) {
+    for(int i = 0; i < 8; i++) {
+        s[i] = x & 0xff;
+        x >>= 8;
+    }
+}
+
+// ignores the top bit
+static Fe fe_frombytes(const uint8_t * s) {
+    return Fe{{
+        load64(s)              & MASK51,
+        (load64(s +  6) >>  3) & MASK51,
+        (load64(s + 12) >>  6) & MASK51,
+        (load64(s + 19) >>  1) & MASK51,
+        (load64(s + 24) >> 12) & MASK51,
+    }};
+}
+
+static void fe_carry(Fe & h) {
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= MASK51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= MASK51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= MASK51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= MASK51; h.v[4] += c;
+    c = h.v[4] >> 51; h.v[4] &= MASK51; h.v[0] += c * 19;
+}
+
+// canonical encoding, fully reduced mod p
+static void fe_tobytes(uint8_t * s, const Fe & f) {
+    Fe t = f;
+    fe_carry(t);
+    fe_carry(t);
+
+    // q = 1 if t >= p
+    uint64_t q = (t.v[0] + 19) >> 51;
+    q = (t.v[1] + q) >> 51;
+    q = (t.v[2] + q) >> 51;
+    q = (t.v[3] + q) >> 51;
+    q = (t.v[4] + q) >> 51;
+
+    t.v[0] += 19 * q;
+    t.v[1] += t.v[0] >> 51; t.v[0] &= MASK51;
+    t.v[2] += t.v[1] >> 51; t.v[1] &= MASK51;
+    t.v[3] += t.v[2] >> 51; t.v[2] &= MASK51;
+    t.v[4] += t.v[3] >> 51; t.v[3] &= MASK51;
+                            t.v[4] &= MASK51;
+
+    store64(s +  0, t.v[0]        | (t.v[1] << 51));
+    store64(s +  8, (t.v[1] >> 13) | (t.v[2] << 38));
+    store64(s + 16, (t.v[2] >> 26) | (t.v[3] << 25));
+    store64(s + 24, (t.v[3] >> 39) | (t.v[4] << 12));
+}
+
+static Fe fe_add(const Fe & f, const Fe & g) {
+    Fe h;
+    for(int i = 0; i < 5; i++) {
+        h.v[i] = f.v[i] + g.v[i];
+    }
+    fe_carry(h);
+    return h;
+}
+
+// f + 4p - g
+static Fe fe_sub(const Fe & f, const Fe & g) {
+    Fe h;
+    h.v[0] = (f.v[0] + 0x1fffffffffffb4ULL) - g.v[0];
+    for(int i = 1; i < 5; i++) {
+        h.v[i] = (f.v[i] + 0x1ffffffffffffcULL) - g.v[i];
+    }
+    fe_carry(h);
+    return h;
+}
+
+static Fe fe_neg(const Fe & f) {
+    return fe_sub(fe(0), f);
+}
+
+static Fe fe_mul(const Fe & f, const Fe & g) {
+    const uint64_t f0 = f.v[0], f1 = f.v[1], f2 = f.v[2], f3 = f.v[3], f4 = f.v[4];
+    const uint64_t g0 = g.v[0], g1 = g.v[1], g2 = g.v[2], g3 = g.v[3], g4 = g.v[4];
+    const uint64_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+
+    uint128_t r0 = mul64(f0, g0) + mul64(f1, g4_19) + mul64(f2, g3_19) + mul64(f3, g2_19) + mul64(f4, g1_19);
+    uint128_t r1 = mul64(f0, g1) + mul64(f1, g0)    + mul64(f2, g4_19) + mul64(f3, g3_19) + mul64(f4, g2_19);
+    uint128_t r2 = mul64(f0, g2) + mul64(f1, g1)    + mul64(f2, g0)    + mul64(f3, g4_19) + mul64(f4, g3_19);
+    uint128_t r3 = mul64(f0, g3) + mul64(f1, g2)    + mul64(f2, g1)    + mul64(f3, g0)    + mul64(f4, g4_19);
+    uint128_t r4 = mul64(f0, g4) + mul64(f1, g3)    + mul64(f2, g2)    + mul64(f3, g1)    + mul64(f4, g0);
+
+    Fe h;
+    r1 += shr51(r0); h.v[0] = lo64(r0) & MASK51;
+    r2 += shr51(r1); h.v[1] = lo64(r1) & MASK51;
+    r3 += shr51(r2); h.v[2] = lo64(r2) & MASK51;
+    r4 += shr51(r3); h.v[3] = lo64(r3) & MASK51;
+    const uint64_t c = shr51(r4); h.v[4] = lo64(r4) & MASK51;
+    h.v[0] += c * 19;
+    h.v[1] += h.v[0] >> 51;
+    h.v[0] &= MASK51;
+    return h;
+}
+
+static Fe fe_sqr(const Fe & f) {
+    const uint64_t f0 = f.v[0], f1 = f.v[1], f2 = f.v[2], f3 = f.v[3], f4 = f.v[4];
+    const uint64_t f0_2 = 2 * f0, f1_2 = 2 * f1, f2_2 = 2 * f2, f3_2 = 2 * f3;
+    const uint64_t f3_19 = 19 * f3, f4_19 = 19 * f4;
+
+    uint128_t r0 = mul64(f0,   f0) + mul64(f1_2, f4_19) + mul64(f2_2, f3_19);
+    uint128_t r1 = mul64(f0_2, f1) + mul64(f2_2, f4_19) + mul64(f3,   f3_19);
+    uint128_t r2 = mul64(f0_2, f2) + mul64(f1,   f1)    + mul64(f3_2, f4_19);
+    uint128_t r3 = mul64(f0_2, f3) + mul64(f1_2, f2)    + mul64(f4,   f4_19);
+    uint128_t r4 = mul64(f0_2, f4) + mul64(f1_2, f3)    + mul64(f2,   f2);
+
+    Fe h;
+    r1 += shr51(r0); h.v[0] = lo64(r0) & MASK51;
+    r2 += shr51(r1); h.v[1] = lo64(r1) & MASK51;
+    r3 += shr51(r2); h.v[2] = lo64(r2) & MASK51;
+    r4 += shr51(r3); h.v[3] = lo64(r3) & MASK51;
+    const uint64_t c = shr51(r4); h.v[4] = lo64(r4) & MASK51;
+    h.v[0] += c * 19;
+    h.v[1] += h.v[0] >> 51;
+    h.v[0] &= MASK51;
+    return h;
+}
+
+static Fe fe_sqr(Fe f, int n) {
+    while (n--) {
+        f = fe_sqr(f);
+    }
+    return f;
+}
+
+// z^(2^250 - 1) and z^11, shared by inversion and square roots
+static Fe fe_pow250(const Fe & z, Fe & z11) {
+    const Fe z2 = fe_sqr(z);
+    const Fe z9 = fe_mul(fe_sqr(z2, 2), z);
+    z11 = fe_mul(z9, z2);
+    const Fe z2_5_0 = fe_mul(fe_sqr(z11), z9);
+    const Fe z2_10_0 = fe_mul(fe_sqr(z2_5_0, 5), z2_5_0);
+    const Fe z2_20_0 = fe_mul(fe_sqr(z2_10_0, 10), z2_10_0);
+    const Fe z2_40_0 = fe_mul(fe_sqr(z2_20_0, 20), z2_20_0);
+    const Fe z2_50_0 = fe_mul(fe_sqr(z2_40_0, 10), z2_10_0);
+    const Fe z2_100_0 = fe_mul(fe_sqr(z2_50_0, 50), z2_50_0);
+    const Fe z2_200_0 = fe_mul(fe_sqr(z2_100_0, 100), z2_100_0);
+    return fe_mul(fe_sqr(z2_200_0, 50), z2_50_0);
+}
+
+// z^(p - 2)
+static Fe fe_invert(const Fe & z) {
+    Fe z11;
+    const Fe z2_250_0 = fe_pow250(z, z11);
+    return fe_mul(fe_sqr(z2_250_0, 5), z11);
+}
+
+// z^((p - 5) / 8)
+static Fe fe_pow22523(const Fe & z) {
+    Fe z11;
+    const Fe z2_250_0 = fe_pow250(z, z11);
+    return fe_mul(fe_sqr(z2_250_0, 2), z);
+}
+
+// f = g if flag is 1
+static void fe_cmov(Fe & f, const Fe & g, const uint64_t flag) {
+    const uint64_t mask = -flag;
+    for(int i = 0; i < 5; i++) {
+        f.v[i] ^= mask & (f.v[i] ^ g.v[i]);
+    }
+}
+
+static void fe_cswap(Fe & f, Fe & g, const uint64_t flag) {
+    const uint64_t mask = -flag;
+    for(int i = 0; i < 5; i++) {
+        const uint64_t x = mask & (f.v[i] ^ g.v[i]);
+        f.v[i] ^= x;
+        g.v[i] ^= x;
+    }
+}
+
+static bool fe_iszero(const Fe & f) {
+    uint8_t s[SIZE];
+    fe_tobytes(s, f);
+    uint8_t acc = 0;
+    for(uint8_t const c : s) {
+        acc |= c;
+    }
+    return !acc;
+}
+
+static uint8_t fe_isnegative(const Fe & f) {
+    uint8_t s[SIZE];
+    fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+// point in extended coordinates: x = X / Z, y = Y / Z, xy = T / Z
+struct Point {
+    Fe X, Y, Z, T;
+};
+
+// point prepared for addition
+struct Cached {
+    Fe YplusX, YminusX, Z2, T2d;
+};
+
+struct Constants {
+    Fe d, d2, sqrtm1;
+};
+
+static const Constants & constants() {
+    static const Constants c = {
+        fe_frombytes(D_BYTES),
+        fe_add(fe_frombytes(D_BYTES), fe_frombytes(D_BYTES)),
+        fe_frombytes(SQRTM1_BYTES),
+    };
+    return c;
+}
+
+static Point identity() {
+    return Point{fe(0), fe(1), fe(1), fe(0)};
+}
+
+static Cached cached_identity() {
+    return Cached{fe(1), fe(1), fe(2), fe(0)};
+}
+
+static Cached to_cached(const Point & p) {
+    return Cached{fe_add(p.Y, p.X), fe_sub(p.Y, p.X), fe_add(p.Z, p.Z), fe_mul(p.T, constants().d2)};
+}
+
+static Point negate(const Point & p) {
+    return Point{fe_neg(p.X), p.Y, p.Z, fe_neg(p.T)};
+}
+
+// add-2008-hwcd-3; complete, so it also doubles and adds the identity
+static Point add(const Point & p, const Cached & q) {
+    const Fe A = fe_mul(fe_sub(p.Y, p.X), q.YminusX);
+    const Fe B = fe_mul(fe_add(p.Y, p.X), q.YplusX);
+    const Fe C = fe_mul(p.T, q.T2d);
+    const Fe D = fe_mul(p.Z, q.Z2);
+    const Fe E = fe_sub(B, A);
+    const Fe F = fe_sub(D, C);
+    const Fe G = fe_add(D, C);
+    const Fe H = fe_add(B, A);
+    return Point{fe_mul(E, F), fe_mul(G, H), fe_mul(F, G), fe_mul(E, H)};
+}
+
+static Point sub(const Point & p, const Cached & q) {
+    const Fe A = fe_mul(fe_sub(p.Y, p.X), q.YplusX);
+    const Fe B = fe_mul(fe_add(p.Y, p.X), q.YminusX);
+    const Fe C = fe_mul(p.T, q.T2d);
+    const Fe D = fe_mul(p.Z, q.Z2);
+    const Fe E = fe_sub(B, A);
+    const Fe F = fe_add(D, C);
+    const Fe G = fe_sub(D, C);
+    const Fe H = fe_add(B, A);
+    return Point{fe_mul(E, F), fe_mul(G, H), fe_mul(F, G), fe_mul(E, H)};
+}
+
+// dbl-2008-hwcd with a = -1
+static Point dbl(const Point & p) {
+    const Fe A = fe_sqr(p.X);
+    const Fe B = fe_sqr(p.Y);
+    const Fe C = fe_add(fe_sqr(p.Z), fe_sqr(p.Z));
+    const Fe H = fe_add(A, B);
+    const Fe E = fe_sub(H, fe_sqr(fe_add(p.X, p.Y)));
+    const Fe G = fe_sub(A, B);
+    const Fe F = fe_add(C, G);
+    return Point{fe_mul(E, F), fe_mul(G, H), fe_mul(F, G), fe_mul(E, H)};
+}
+
+static bool is_identity(const Point & p) {
+    return fe_iszero(p.X) && fe_iszero(fe_sub(p.Y, p.Z));
+}
+
+static void encode(uint8_t * s, const Point & p) {
+    const Fe zinv = fe_invert(p.Z);
+    fe_tobytes(s, fe_mul(p.Y, zinv));
+    s[31] ^= fe_isnegative(fe_mul(p.X, zinv)) << 7;
+}
+
+// RFC 8032 5.1.3; rejects non-canonical y
+static bool decode(Point & p, const uint8_t * s) {
+    const Fe y = fe_frombytes(s);
+
+    uint8_t check[SIZE];
+    fe_tobytes(check, y);
+    check[31] |= s[31] & 0x80;
+    for(std::size_t i = 0; i < SIZE; i++) {
+        if (check[i] != s[i]) {
+            return false;
+        }
+    }
+
+    const Fe yy = fe_sqr(y);
+    const Fe u = fe_sub(yy, fe(1));
+    const Fe v = fe_add(fe_mul(constants().d, yy), fe(1));
+    const Fe v3 = fe_mul(fe_sqr(v), v);
+    const Fe v7 = fe_mul(fe_sqr(v3), v);
+    Fe x = fe_mul(fe_mul(u, v3), fe_pow22523(fe_mul(u, v7)));
+
+    const Fe vxx = fe_mul(v, fe_sqr(x));
+    if (!fe_iszero(fe_sub(vxx, u))) {
+        if (!fe_iszero(fe_add(vxx, u))) {
+            return false;
+        }
+        x = fe_mul(x, constants().sqrtm1);
+    }
+
+    const uint8_t sign = s[31] >> 7;
+    if (fe_iszero(x) && sign) {
+        return false;
+    }
+
+    if (fe_isnegative(x) != sign) {
+        x = fe_neg(x);
+    }
+
+    p = Point{x, y, fe(1), fe_mul(x, y)};
+    return true;
+}
+
+// odd multiples P, 3P, 5P, ...
+static std::vector <Cached> odd_multiples(const Point & p, const std::size_t count) {
+    std::vector <Cached> out(count);
+    const Cached p2 = to_cached(dbl(p));
+    Point current = p;
+    out[0] = to_cached(current);
+    for(std::size_t i = 1; i < count; i++) {
+        current = add(current, p2);
+        out[i] = to_cached(current);
+    }
+    return out;
+}
+
+struct Tables {
+    Point base;
+    Cached comb[64][8];             // comb[i][j] = (j + 1) * 16^i * B
+    std::vector <Cached> odd;       // B, 3B, 5B, ..., for verification
+};
+
+static Tables * build_tables() {
+    Tables * t = new Tables;
+    decode(t -> base, BASE_BYTES);
+
+    Point p = t -> base;
+    for(int i = 0; i < 64; i++) {
+        const Cached c = to_cached(p);
+        Point q = p;
+        t -> comb[i][0] = c;
+        for(int j = 1; j < 8; j++) {
+            q = add(q, c);
+            t -> comb[i][j] = to_cached(q);
+        }
+
+        for(int j = 0; j < 4; j++) {
+            p = dbl(p);
+        }
+    }
+
+    t -> odd = odd_multiples(t -> base, static_cast <std::size_t> (1) << (BASE_WINDOW - 2));
+    return t;
+}
+
+static const Tables & tables() {
+    static const std::unique_ptr <const Tables> t(build_tables());
+    return *t;
+}
+
+// 1 if b == c
+static uint8_t equal(const uint8_t b, const uint8_t c) {
+    uint32_t x = b ^ c;
+    x -= 1;
+    return x >> 31;
+}
+
+static void cached_cmov(Cached & t, const Cached & u, const uint8_t flag) {
+    fe_cmov(t.YplusX, u.YplusX, flag);
+    fe_cmov(t.YminusX, u.YminusX, flag);
+    fe_cmov(t.Z2, u.Z2, flag);
+    fe_cmov(t.T2d, u.T2d, flag);
+}
+
+// b * table[0] for b in [-8, 8] without branching on b
+static Cached select(const Cached * table, const int8_t b) {
+    const uint8_t negative = static_cast <uint8_t> (b) >> 7;
+    const uint8_t babs = b - ((static_cast <uint8_t> (-negative) & b) << 1);
+
+    Cached t = cached_identity();
+    for(int i = 0; i < 8; i++) {
+        cached_cmov(t, table[i], equal(babs, i + 1));
+    }
+
+    const Cached minus = {t.YminusX, t.YplusX, t.Z2, fe_neg(t.T2d)};
+    cached_cmov(t, minus, negative);
+    return t;
+}
+
+// [a]B in constant time for a < 2^255 using signed radix 16 digits
+static Point base_mult(const uint8_t * a) {
+    int8_t e[64];
+    for(int i = 0; i < 32; i++) {
+        e[2 * i + 0] = a[i] & 15;
+        e[2 * i + 1] = (a[i] >> 4) & 15;
+    }
+
+    int8_t carry = 0;
+    for(int i = 0; i < 63; i++) {
+        e[i] += carry;
+        carry = (e[i] + 8) >> 4;
+        e[i] -= carry << 4;
+    }
+    e[63] += carry;
+
+    const Tables & t = tables();
+    Point r = identity();
+    for(int i = 0; i < 64; i++) {
+        r = add(r, select(t.comb[i], e[i]));
+    }
+    return r;
+}
+
+// scalar arithmetic mod L in constant time with GMP's mpn_sec functions (GMP 6.0.0 or later)
+// limbs may be 32 or 64 bits, but must fill whole octets with no nail bits
+static_assert((GMP_NAIL_BITS == 0) && !(SIZE % sizeof(mp_limb_t)), "Error: GMP limbs must be whole octets without nail bits.");
+static const std::size_t SCALAR_LIMBS = SIZE / sizeof(mp_limb_t);
+
+static void to_limbs(mp_limb_t * out, const uint8_t * in, const std::size_t size) {
+    for(std::size_t i = 0; i < size / sizeof(mp_limb_t); i++) {
+        out[i] = 0;
+    }
+    for(std::size_t i = 0; i < size; i++) {
+        out[i / sizeof(mp_limb_t)] |= static_cast <mp_limb_t> (in[i]) << (8 * (i % sizeof(mp_limb_t)));
+    }
+}
+
+static void from_limbs(uint8_t * out, const mp_limb_t * in) {
+    for(std::size_t i = 0; i < SIZE; i++) {
+        out[i] = (in[i / sizeof(mp_limb_t)] >> (8 * (i % sizeof(mp_limb_t)))) & 0xff;
+    }
+}
+
+// out = in mod L; size is a multiple of the limb size and at least 32
+static void sc_reduce(uint8_t * out, const uint8_t * in, const std::size_t size) {
+    mp_limb_t l[SCALAR_LIMBS];
+    to_limbs(l, L_BYTES, SIZE);
+
+    const mp_size_t n = size / sizeof(mp_limb_t);
+    std::vector <mp_limb_t> x(n);
+    to_limbs(x.data(), in, size);
+
+    std::vector <mp_limb_t> scratch(mpn_sec_div_r_itch(n, SCALAR_LIMBS));
+    mpn_sec_div_r(x.data(), n, l, SCALAR_LIMBS, scratch.data());
+    from_limbs(out, x.data());
+}
+
+// out = (a * b + c) mod L
+static void sc_muladd(uint8_t * out, const uint8_t * a, const uint8_t * b, const uint8_t * c) {
+    mp_limb_t al[SCALAR_LIMBS], bl[SCALAR_LIMBS], cl[2 * SCALAR_LIMBS];
+    to_limbs(al, a, SIZE);
+    to_limbs(bl, b, SIZE);
+    to_limbs(cl, c, SIZE);
+    for(std::size_t i = SCALAR_LIMBS; i < 2 * SCALAR_LIMBS; i++) {
+        cl[i] = 0;
+    }
+
+    mp_limb_t product[2 * SCALAR_LIMBS];
+    std::vector <mp_limb_t> scratch(mpn_sec_mul_itch(SCALAR_LIMBS, SCALAR_LIMBS));
+    mpn_sec_mul(product, al, SCALAR_LIMBS, bl, SCALAR_LIMBS, scratch.data());
+    mpn_add_n(product, product, cl, 2 * SCALAR_LIMBS); // cannot carry out
+
+    uint8_t bytes[2 * SIZE];
+    for(std::size_t i = 0; i < 2 * SIZE; i++) {
+        bytes[i] = (product[i / sizeof(mp_limb_t)] >> (8 * (i % sizeof(mp_limb_t)))) & 0xff;
+    }
+    sc_reduce(out, bytes, 2 * SIZE);
+}
+
+// variable time scalars for verification
+static mpz_class scalar(const uint8_t * in, const std::size_t size) {
+    mpz_class out;
+    mpz_import(out.get_mpz_t(), size, -1, 1, 0, 0, in);
+    return out;
+}
+
+static const mpz_class & order() {
+    static const mpz_class l = scalar(L_BYTES, SIZE);
+    return l;
+}
+
+// width-w non-adjacent form of a < 2^255
+static std::vector <int8_t> wnaf(const mpz_class & a, const int w) {
+    uint64_t x[5] = {0, 0, 0, 0, 0};
+    uint8_t bytes[SIZE] = {0};
+    mpz_export(bytes, nullptr, -1, 1, 0, 0, a.get_mpz_t());
+    for(int i = 0; i < 4; i++) {
+        x[i] = load64(bytes + 8 * i);
+    }
+
+    std::vector <int8_t> naf(256, 0);
+    const uint64_t width = static_cast <uint64_t> (1) << w;
+    const uint64_t mask = width - 1;
+
+    std::size_t pos = 0;
+    uint64_t carry = 0;
+    while (pos < 256) {
+        const std::size_t idx = pos / 64;
+        const std::size_t bit = pos % 64;
+        uint64_t buf = x[idx] >> bit;
+        if (bit > 64 - static_cast <std::size_t> (w)) {
+            buf |= x[idx + 1] << (64 - bit);
+        }
+
+        const uint64_t window = carry + (buf & mask);
+        if (!(window & 1)) {
+            pos++;
+            continue;
+        }
+
+        if (window < (width >> 1)) {
+            carry = 0;
+            naf[pos] = static_cast <int8_t> (window);
+        }
+        else {
+            carry = 1;
+            naf[pos] = static_cast <int8_t> (static_cast <int> (window) - static_cast <int> (width));
+        }
+
+        pos += w;
+    }
+
+    return naf;
+}
+
+// sum of [scalar_i]P_i given odd multiples of each P_i and the scalars in
+// non-adjacent form; the doublings are shared by all terms (Straus)
+static Point multiscalar(const std::vector <const Cached *> & odd, const std::vector <std::vector <int8_t> > & nafs) {
+    int top = 255;
+    while (top >= 0) {
+        bool nonzero = false;
+        for(std::vector <int8_t> const & naf : nafs) {
+            nonzero |= (naf[top] != 0);
+        }
+        if (nonzero) {
+            break;
+        }
+        top--;
+    }
+
+    Point r = identity();
+    for(int i = top; i >= 0; i--) {
+        r = dbl(r);
+        for(std::size_t j = 0; j < nafs.size(); j++) {
+            const int8_t d = nafs[j][i];
+            if (d > 0) {
+                r = add(r, odd[j][d >> 1]);
+            }
+            else if (d < 0) {
+                r = sub(r, odd[j][(-d) >> 1]);
+            }
+        }
+    }
+
+    return r;
+}
+
+// clamped scalar and prefix of a seed
+static void expand(uint8_t * s, uint8_t * prefix, const std::string & seed) {
+    const std::string h = Hash::use(Hash::ID::SHA512, seed);
+    for(std::size_t i = 0; i < SIZE; i++) {
+        s[i] = h[i];
+        prefix[i] = h[SIZE + i];
+    }
+    s[0] &= 248;
+    s[31] &= 127;
+    s[31] |= 64;
+}
+
+static std::string to_string(const uint8_t * s) {
+    return std::string(reinterpret_cast <const char *> (s), SIZE);
+}
+
+static const uint8_t * bytes(const std::string & s) {
+    return reinterpret_cast <const uint8_t *> (s.data());
+}
+
+std::string x25519(const std::string & scalar, const std::string & u) {
+    if ((scalar.size() != SIZE) || (u.size() != SIZE)) {
+        // "Error: X25519 inputs must be 32 octets.\n";
+        return "";
+    }
+
+    uint8_t k[SIZE];
+    for(std::size_t i = 0; i < SIZE; i++) {
+        k[i] = scalar[i];
+    }
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    // RFC 7748 5. Montgomery ladder
+    const Fe x1 = fe_frombytes(bytes(u));
+    const Fe a24 = fe(121665);
+    Fe x2 = fe(1), z2 = fe(0), x3 = x1, z3 = fe(1);
+    uint64_t swap = 0;
+    for(int t = 254; t >= 0; t--) {
+        const uint64_t bit = (k[t >> 3] >> (t & 7)) & 1;
+        swap ^= bit;
+        fe_cswap(x2, x3, swap);
+        fe_cswap(z2, z3, swap);
+        swap = bit;
+
+        const Fe A  = fe_add(x2, z2);
+        const Fe AA = fe_sqr(A);
+        const Fe B  = fe_sub(x2, z2);
+        const Fe BB = fe_sqr(B);
+        const Fe E  = fe_sub(AA, BB);
+        const Fe C  = fe_add(x3, z3);
+        const Fe D  = fe_sub(x3, z3);
+        const Fe DA = fe_mul(D, A);
+        const Fe CB = fe_mul(C, B);
+        x3 = fe_sqr(fe_add(DA, CB));
+        z3 = fe_mul(x1, fe_sqr(fe_sub(DA, CB)));
+        x2 = fe_mul(AA, BB);
+        z2 = fe_mul(E, fe_add(AA, fe_mul(a24, E)));
+    }
+    fe_cswap(x2, x3, swap);
+    fe_cswap(z2, z3, swap);
+
+    uint8_t out[SIZE];
+    fe_tobytes(out, fe_mul(x2, fe_invert(z2)));
+
+    uint8_t acc = 0;
+    for(uint8_t const c : out) {
+        acc |= c;
+    }
+    if (!acc) {
+        // "Error: X25519 produced the all-zero value.\n";
+        return "";
+    }
+
+    return to_string(out);
+}
+
+std::string x25519_base(const std::string & scalar) {
+    if (scalar.size() != SIZE) {
+        // "Error: X25519 scalar must be 32 octets.\n";
+        return "";
+    }
+
+    uint8_t k[SIZE];
+    for(std::size_t i = 0; i < SIZE; i++) {
+        k[i] = scalar[i];
+    }
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    // the Edwards base point maps to u = 9, so use the comb table
+    // and the birational map u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y)
+    const Point p = base_mult(k);
+    uint8_t out[SIZE];
+    fe_tobytes(out, fe_mul(fe_add(p.Z, p.Y), fe_invert(fe_sub(p.Z, p.Y))));
+    return to_string(out);
+}
+
+std::string ed25519_public(const std::string & seed) {
+    if (seed.size() != SIZE) {
+        // "Error: Ed25519 private key must be 32 octets.\n";
+        return "";
+    }
+
+    uint8_t s[SIZE], prefix[SIZE], A[SIZE];
+    expand(s, prefix, seed);
+    encode(A, base_mult(s));
+    return to_string(A);
+}
+
+std::string ed25519_sign(const std::string & message, const std::string & seed, const std::string & pub) {
+    if ((seed.size() != SIZE) || (pub.size() != SIZE)) {
+        // "Error: Ed25519 keys must be 32 octets.\n";
+        return "";
+    }
+
+    uint8_t s[SIZE], prefix[SIZE], A[SIZE];
+    expand(s, prefix, seed);
+    encode(A, base_mult(s));
+
+    // signing with a public key that does not belong to the seed leaks the seed
+    if (to_string(A) != pub) {
+        // "Error: Ed25519 public key does not match private key.\n";
+        return "";
+    }
+
+    uint8_t r[SIZE], R[SIZE], k[SIZE], S[SIZE];
+    sc_reduce(r, bytes(Hash::use(Hash::ID::SHA512, to_string(prefix) + message)), 2 * SIZE);
+    encode(R, base_mult(r));
+    sc_reduce(k, bytes(Hash::use(Hash::ID::SHA512, to_string(R) + pub + message)), 2 * SIZE);
+    sc_muladd(S, k, s, r);
+
+    return to_string(R) + to_string(S);
+}
+
+bool ed25519_verify(const std::string & message, const std::string & sig, const std::string & pub) {
+    return ed25519_verify(std::vector <std::string> (1, message), std::vector <std::string> (1, sig), std::vector <std::string> (1, pub));
+}
+
+bool ed25519_verify(const std::vector <std::string> & messages, const std::vector <std::string> & sigs, const std::vector <std::string> & pubs) {
+    const std::size_t n = messages.size();
+    if ((sigs.size() != n) || (pubs.size() != n)) {
+        // "Error: Mismatched batch sizes.\n";
+        return false;
+    }
+
+    if (!n) {
+        return true;
+    }
+
+    // coefficients so that invalid signatures cannot cancel out, drawn from
+    // a hash of the whole batch as in BIP 340 so that they cannot be chosen
+    // in advance; a single signature does not need one
+    std::string seed;
+    if (n > 1) {
+        std::string batch;
+        for(std::size_t i = 0; i < n; i++) {
+            batch += sigs[i] + pubs[i] + Hash::use(Hash::ID::SHA512, messages[i]);
+        }
+        seed = Hash::use(Hash::ID::SHA512, batch);
+    }
+
+    // [8]([sum z_i S_i]B - sum [z_i]R_i - sum [z_i k_i]A_i) = 0
+    std::vector <std::vector <Cached> > points;
+    std::vector <std::vector <int8_t> > nafs;
+    points.reserve(2 * n);
+    nafs.reserve(2 * n + 1);
+
+    mpz_class sum = 0;
+    for(std::size_t i = 0; i < n; i++) {
+        if ((sigs[i].size() != 2 * SIZE) || (pubs[i].size() != SIZE)) {
+            // "Error: Bad Ed25519 signature or public key length.\n";
+            return false;
+        }
+
+        Point A, R;
+        if (!decode(A, bytes(pubs[i])) || !decode(R, bytes(sigs[i]))) {
+            return false;
+        }
+
+        const mpz_class S = scalar(bytes(sigs[i]) + SIZE, SIZE);
+        if (S >= order()) {
+            return false;
+        }
+
+        const std::string h = Hash::use(Hash::ID::SHA512, sigs[i].substr(0, SIZE) + pubs[i] + messages[i]);
+        const mpz_class k = scalar(bytes(h), h.size()) % order();
+
+        mpz_class z = 1;
+        if (n > 1) {
+            const std::string zi = Hash::use(Hash::ID::SHA512, seed + std::to_string(i));
+            z = scalar(bytes(zi), 16);
+        }
+
+        sum += z * S;
+
+        const std::size_t count = static_cast <std::size_t> (1) << (POINT_WINDOW - 2);
+        points.push_back(odd_multiples(negate(R), count));
+        nafs.push_back(wnaf(z, POINT_WINDOW));
+        points.push_back(odd_multiples(negate(A), count));
+        nafs.push_back(wnaf((z * k) % order(), POINT_WINDOW));
+    }
+
+    std::vector <const Cached *> odd;
+    odd.push_back(tables().odd.data());
+    for(std::vector <Cached> const & t : points) {
+        odd.push_back(t.data());
+    }
+    nafs.insert(nafs.begin(), wnaf(sum % order(), BASE_WINDOW));
+
+    Point p = multiscalar(odd, nafs);
+    for(int i = 0; i < 3; i++) {
+        p = dbl(p);
+    }
+
+    return is_identity(p);
+}
+
+}
+}
+}
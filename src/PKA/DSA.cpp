@@ -1,24 +1,65 @@
 #include "PKA/DSA.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Misc/montgomery.h"
+#include "PKA/FixedBase.h"
+
 namespace OpenPGP {
 namespace PKA {
 namespace DSA {
 
+// number of domains whose generator tables are kept
+static const std::size_t DOMAIN_CACHE_SIZE = 16;
+
+// window size of the generator tables
+static const unsigned int DOMAIN_WINDOW = 6;
+
+std::shared_ptr <const WindowTable> domain_table(const MPI & p, const MPI & g) {
+    if ((p <= 2) || !mpz_odd_p(p.get_mpz_t())) {
+        return nullptr;
+    }
+
+    typedef std::map <std::pair <MPI, MPI>, std::shared_ptr <const WindowTable> > Cache;
+
+    static std::mutex mutex;
+    static Cache cache;
+
+    const std::pair <MPI, MPI> domain(p, g);
+
+    std::lock_guard <std::mutex> lock(mutex);
+    Cache::const_iterator it = cache.find(domain);
+    if (it != cache.end()) {
+        return it -> second;
+    }
+
+    if (cache.size() >= DOMAIN_CACHE_SIZE) {
+        cache.clear();
+    }
+
+    std::shared_ptr <const WindowTable> table = std::make_shared <WindowTable> (g, p, DOMAIN_WINDOW);
+    cache[domain] = table;
+    return table;
+}
+
 Values new_public(const uint32_t & L, const uint32_t & N) {
 //    L = 1024, N = 160
 //    L = 2048, N = 224
 //    L = 2048, N = 256
 //    L = 3072, N = 256
     // random prime q
-    MPI q = bintompi("1" + RNG::RNG().rand_bits(N - 1));
+    MPI q = RNG::random_mpi(N, RNG::TOP_BIT);
     q = nextprime(q);
     while (bitsize(q) > N) {
-        q = bintompi("1" + RNG::RNG().rand_bits(N - 1));
+        q = RNG::random_mpi(N, RNG::TOP_BIT);
         q = nextprime(q);
     }
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::RNG().rand_bits(L - 1));              // pick random starting point
+    MPI p = RNG::random_mpi(L, RNG::TOP_BIT);                         // pick random starting point
     p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
     while (!knuth_prime_test(p, 25)) {
         p += q;
@@ -35,14 +76,23 @@ Values new_public(const uint32_t & L, const uint32_t & N) {
     return {p, q, g};
 }
 
+Values standard_public(const uint32_t & L, const uint32_t & N) {
+    for(DomainParameters const & params : STANDARD_DOMAIN_PARAMETERS) {
+        if ((params.L == L) && (params.N == N)) {
+            return {hextompi(params.p), hextompi(params.q), hextompi(params.g)};
+        }
+    }
+
+    return {};
+}
+
 Values keygen(Values & pub) {
     MPI x = 0;
     std::string test = "testing testing 123"; // a string to test the key with, just in case the key doesn't work for some reason
-    unsigned int bits = bitsize(pub[1]) - 1;
     while (true) {
         // 0 < x < q
-        while ((x == 0) || (pub[1] <= x)) {
-            x = bintompi(RNG::RNG().rand_bits(bits));
+        while (x == 0) {
+            x = RNG::random_mpi(pub[1]);
         }
 
         // y = g^x mod p
@@ -74,12 +124,11 @@ Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k) {
     while ((r == 0) || (s == 0)) {
         // 0 < k < q
         if ( set_k ) {
-            k = bintompi(RNG::RNG().rand_bits(bitsize(pub[1])));
-            k %= pub[1];
+            k = RNG::random_mpi(pub[1]);
         }
 
         // r = (g^k mod p) mod q
-        r = powm(pub[2], k, pub[0]);
+        r = fixed_base_powm(pub[2], k, pub[0], bitsize(pub[1]));
         r %= pub[1];
 
         // if r == 0, don't bother calculating s
@@ -100,33 +149,111 @@ Values sign(const std::string & data, const Values & pri, const Values & pub, MP
     return sign(rawtompi(data), pri, pub, k);
 }
 
+Presignature presign(const Values & pub) {
+    const std::size_t bits = bitsize(pub[1]);
+
+    MPI k = 0;
+    Presignature pre;
+    pre.r = 0;
+    while (pre.r == 0) {
+        // 0 < k < q
+        k = RNG::random_mpi(pub[1]);
+        if (k == 0) {
+            continue;
+        }
+
+        // r = (g^k mod p) mod q
+        pre.r = fixed_base_powm(pub[2], k, pub[0], bits);
+        pre.r %= pub[1];
+    }
+
+    pre.kinv = invert(k, pub[1]);
+    return pre;
+}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, const Presignature & pre) {
+    // s = k^-1 (m + x * r) mod q
+    MPI s = pre.kinv * (data + pri[0] * pre.r);
+    s %= pub[1];
+
+    if (s == 0) {
+        return {};
+    }
+
+    return {pre.r, s};
+}
+
+PresignaturePool::PresignaturePool(const Values & pub, const std::size_t capacity)
+    : Pool <Presignature> ([pub]() { return presign(pub); }, capacity)
+{}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, PresignaturePool & pool) {
+    Values sig;
+    while (!sig.size()) {
+        sig = sign(data, pri, pub, pool.take());
+    }
+    return sig;
+}
+
+Values sign(const std::string & data, const Values & pri, const Values & pub, PresignaturePool & pool) {
+    return sign(rawtompi(data), pri, pub, pool);
+}
+
+// 0 < r < q and 0 < s < q
+static bool in_range(const Values & sig, const Values & pub) {
+    return ((sig.size() == 2)                   &&
+            (0 < sig[0]) && (sig[0] < pub[1])   &&
+            (0 < sig[1]) && (sig[1] < pub[1]));
+}
+
 bool verify(const MPI & data, const Values & sig, const Values & pub) {
-    // 0 < r < q or 0 < s < q
-    if (!((0 < sig[0]) && (sig[0] < pub[1])) & !((0 < sig[0]) && (sig[1] < pub[1]))) {
+    if (!in_range(sig, pub)) {
         return false;
     }
-    // w = s^-1 mod q
-    MPI w = invert(sig[1], pub[1]);
 
-    // u1 = H(m) * w mod q
-    MPI u1 = (data * w) % pub[1];
+    // all values are public, so g^u1 * y^u2 can be computed with
+    // one chain of squarings, reusing the precomputed powers of g
+    const std::shared_ptr <const WindowTable> g = domain_table(pub[0], pub[2]);
+    if (g) {
+        const WindowTable y(pub[3], g -> get_ctx(), window_size(bitsize(pub[1])));
+        return verify(data, sig, pub, *g, y);
+    }
 
-    // u2 = r * w mod q
-    MPI u2 = (sig[0] * w) % pub[1];
+    // w = s^-1 mod q
+    const MPI w = invert(sig[1], pub[1]);
 
     // v = ((g ^ u1 * y ^ u2) mod p) mod q
-    MPI g, y;
-    g = powm(pub[2], u1, pub[0]);
-    y = powm(pub[3], u2, pub[0]);
+    const MPI v = (powm(pub[2], (data * w) % pub[1], pub[0]) * powm(pub[3], (sig[0] * w) % pub[1], pub[0])) % pub[0];
 
     // check v == r
-    return ((((g * y) % pub[0]) % pub[1]) == sig[0]);
+    return ((v % pub[1]) == sig[0]);
 }
 
 bool verify(const std::string & data, const Values & sig, const Values & pub) {
     return verify(rawtompi(data), sig, pub);
 }
 
+bool verify(const MPI & data, const Values & sig, const Values & pub, const WindowTable & g, const WindowTable & y) {
+    if (!in_range(sig, pub)) {
+        return false;
+    }
+
+    // w = s^-1 mod q
+    const MPI w = invert(sig[1], pub[1]);
+
+    // u1 = H(m) * w mod q
+    const MPI u1 = (data * w) % pub[1];
+
+    // u2 = r * w mod q
+    const MPI u2 = (sig[0] * w) % pub[1];
+
+    // v = ((g ^ u1 * y ^ u2) mod p) mod q
+    const MPI v = powm(g, u1, y, u2);
+
+    // check v == r
+    return ((v % pub[1]) == sig[0]);
+}
+
 }
 }
 }
@@ -0,0 +1,208 @@
+#include "PKA/ECDH.h"
+
+#include <algorithm>
+
+#include "Encryptions/Encryptions.h"
+#include "Hashes/Hashes.h"
+#include "RNG/RNGs.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDH {
+
+// native point prefix
+static const char PREFIX = 0x40;
+
+// RFC 3394 2.2.3.1 default initial value
+static const std::string IV(8, '\xa6');
+
+// u from {0x40 || u}
+static std::string point(const MPI & m) {
+    const std::string raw = mpitoraw(m);
+    if ((raw.size() != Curve25519::SIZE + 1) || (raw[0] != PREFIX)) {
+        return "";
+    }
+
+    return raw.substr(1);
+}
+
+// little endian X25519 scalar from the big endian MPI
+static std::string scalar(const MPI & k) {
+    const std::string raw = (k == 0)?"":mpitoraw(k);
+    if (raw.size() > Curve25519::SIZE) {
+        return "";
+    }
+
+    std::string out = std::string(Curve25519::SIZE - raw.size(), 0) + raw;
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+// RFC 6637 7. Key Derivation Function
+static std::string kdf(const uint8_t hash, const uint8_t sym, const std::string & shared, const std::string & param) {
+    const std::size_t size = Sym::KEY_LENGTH.at(sym) >> 3;
+    const std::string digest = Hash::use(hash, std::string("\x00\x00\x00\x01", 4) + shared + param);
+    if (digest.size() < size) {
+        return "";
+    }
+
+    return digest.substr(0, size);
+}
+
+static std::string xor64(std::string a, const uint64_t t) {
+    for(int i = 7; i >= 0; i--) {
+        a[i] ^= static_cast <char> ((t >> (8 * (7 - i))) & 0xff);
+    }
+    return a;
+}
+
+Values keygen() {
+    std::string k = RNG::RNG().rand_bytes(Curve25519::SIZE);
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    const std::string u = Curve25519::x25519_base(k);
+    std::reverse(k.begin(), k.end());
+    return {rawtompi(std::string(1, PREFIX) + u), rawtompi(k)};
+}
+
+std::string kdf_param(const std::string & curve, const uint8_t hash, const uint8_t sym, const std::string & fingerprint) {
+    return std::string(1, curve.size()) + curve
+         + std::string(1, 18)                                   // public key algorithm ID (ECDH)
+         + std::string(1, 3) + std::string(1, 1)                // KDF parameters size and reserved octet
+         + std::string(1, hash) + std::string(1, sym)
+         + "Anonymous Sender    "
+         + fingerprint;
+}
+
+std::string key_wrap(const uint8_t sym, const std::string & kek, const std::string & data) {
+    if (!data.size() || (data.size() & 7)) {
+        // "Error: Key wrap data must be a multiple of 8 octets.\n";
+        return "";
+    }
+
+    const SymAlg::Ptr alg = Sym::setup(sym, kek);
+    const std::size_t n = data.size() >> 3;
+
+    std::string A = IV;
+    std::string R = data;
+    for(std::size_t j = 0; j < 6; j++) {
+        for(std::size_t i = 0; i < n; i++) {
+            const std::string B = alg -> encrypt(A + R.substr(i << 3, 8));
+            A = xor64(B.substr(0, 8), n * j + i + 1);
+            R.replace(i << 3, 8, B.substr(8, 8));
+        }
+    }
+
+    return A + R;
+}
+
+std::string key_unwrap(const uint8_t sym, const std::string & kek, const std::string & data) {
+    if ((data.size() < 16) || (data.size() & 7)) {
+        // "Error: Wrapped key must be a multiple of 8 octets.\n";
+        return "";
+    }
+
+    const SymAlg::Ptr alg = Sym::setup(sym, kek);
+    const std::size_t n = (data.size() >> 3) - 1;
+
+    std::string A = data.substr(0, 8);
+    std::string R = data.substr(8);
+    for(std::size_t j = 6; j-- > 0;) {
+        for(std::size_t i = n; i-- > 0;) {
+            const std::string B = alg -> decrypt(xor64(A, n * j + i + 1) + R.substr(i << 3, 8));
+            A = B.substr(0, 8);
+            R.replace(i << 3, 8, B.substr(8, 8));
+        }
+    }
+
+    if (A != IV) {
+        // "Error: Key unwrap integrity check failed.\n";
+        return "";
+    }
+
+    return R;
+}
+
+Values encrypt(const std::string & m, const Values & pub, const std::string & param, const uint8_t hash, const uint8_t sym, std::string & wrapped) {
+    if (pub.size() != 1) {
+        // "Error: Bad ECDH public key.\n";
+        return {};
+    }
+
+    const std::string R = point(pub[0]);
+    if (!R.size()) {
+        // "Error: Bad ECDH public key.\n";
+        return {};
+    }
+
+    // ephemeral key pair
+    const std::string v = RNG::RNG().rand_bytes(Curve25519::SIZE);
+    const std::string V = Curve25519::x25519_base(v);
+    const std::string shared = Curve25519::x25519(v, R);
+    if (!shared.size()) {
+        return {};
+    }
+
+    const std::string kek = kdf(hash, sym, shared, param);
+    if (!kek.size()) {
+        // "Error: KDF hash is too short for the key wrap algorithm.\n";
+        return {};
+    }
+
+    // RFC 6637 8. PKCS5 padding to a multiple of 8 octets
+    const std::size_t pad = 8 - (m.size() & 7);
+    wrapped = key_wrap(sym, kek, m + std::string(pad, pad));
+
+    return {rawtompi(std::string(1, PREFIX) + V)};
+}
+
+std::string decrypt(const MPI & ephemeral, const std::string & wrapped, const Values & pri, const std::string & param, const uint8_t hash, const uint8_t sym) {
+    if (pri.size() != 1) {
+        // "Error: Bad ECDH secret key.\n";
+        return "";
+    }
+
+    const std::string V = point(ephemeral);
+    const std::string k = scalar(pri[0]);
+    if (!V.size() || !k.size()) {
+        // "Error: Bad ECDH values.\n";
+        return "";
+    }
+
+    const std::string shared = Curve25519::x25519(k, V);
+    if (!shared.size()) {
+        return "";
+    }
+
+    const std::string kek = kdf(hash, sym, shared, param);
+    if (!kek.size()) {
+        return "";
+    }
+
+    const std::string m = key_unwrap(sym, kek, wrapped);
+    if (!m.size()) {
+        return "";
+    }
+
+    // remove PKCS5 padding
+    const std::size_t pad = static_cast <unsigned char> (m.back());
+    if (!pad || (pad > 8) || (pad > m.size())) {
+        // "Error: Bad session key padding.\n";
+        return "";
+    }
+
+    for(std::size_t i = m.size() - pad; i < m.size(); i++) {
+        if (static_cast <unsigned char> (m[i]) != pad) {
+            // "Error: Bad session key padding.\n";
+            return "";
+        }
+    }
+
+    return m.substr(0, m.size() - pad);
+}
+
+}
+}
+}
@@ -0,0 +1,734 @@
+#include "PKA/ECDSA.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include <gmp.h>
+
+#include "Misc/montgomery.h"
+#include "RNG/RNGs.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDSA {
+
+// uncompressed point prefix
+static const char PREFIX = 0x04;
+
+// limbs of the largest supported field
+static const mp_size_t MAX_LIMBS = (384 + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+
+// width of the non-adjacent form of public key scalars
+static const unsigned int POINT_WINDOW = 5;
+
+// element of GF(p) in Montgomery form, fully reduced
+// only the low Curve::limbs limbs are used
+struct Fe {
+    mp_limb_t v[MAX_LIMBS];
+};
+
+struct Affine {
+    Fe x, y;
+};
+
+// (X / Z^2, Y / Z^3); Z = 0 is the point at infinity
+struct Jacobian {
+    Fe X, Y, Z;
+};
+
+struct Curve {
+    std::string oid;
+    std::size_t bits;
+    std::size_t size;                           // octets of a coordinate
+    mp_size_t limbs;
+    MPI p, n;
+    Fe mod;                                     // limbs of p
+    Montgomery field;
+    Fe one, b;
+    Affine g;
+    std::vector <std::vector <Affine> > comb;   // comb[i][j] = (j + 1) * 16^i * G
+
+    Curve(const CurveParameters & params)
+        : oid(params.oid),
+          bits(params.bits),
+          size(params.bits >> 3),
+          limbs(0),
+          p(hextompi(params.p)),
+          n(hextompi(params.n)),
+          mod(),
+          field(p),
+          one(),
+          b(),
+          g(),
+          comb()
+    {
+        limbs = field.size();
+        mpz_export(mod.v, nullptr, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, p.get_mpz_t());
+    }
+};
+
+static Fe fe(const Curve & c, const MPI & a) {
+    const Montgomery::Residue r = c.field.to(a);
+    Fe out = {};
+    std::copy(r.begin(), r.end(), out.v);
+    return out;
+}
+
+static MPI fe_get(const Curve & c, const Fe & a) {
+    return c.field.from(Montgomery::Residue(a.v, a.v + c.limbs));
+}
+
+static Fe fe_add(const Curve & c, const Fe & a, const Fe & b) {
+    Fe out = {};
+    const mp_limb_t carry  = mpn_add_n(out.v, a.v, b.v, c.limbs);
+    const mp_limb_t borrow = mpn_sub_n(out.v, out.v, c.mod.v, c.limbs);
+
+    // the sum was already less than p
+    mpn_cnd_add_n(borrow & (carry ^ 1), out.v, out.v, c.mod.v, c.limbs);
+    return out;
+}
+
+static Fe fe_sub(const Curve & c, const Fe & a, const Fe & b) {
+    Fe out = {};
+    const mp_limb_t borrow = mpn_sub_n(out.v, a.v, b.v, c.limbs);
+    mpn_cnd_add_n(borrow, out.v, out.v, c.mod.v, c.limbs);
+    return out;
+}
+
+static Fe fe_neg(const Curve & c, const Fe & a) {
+    return fe_sub(c, Fe(), a);
+}
+
+static Fe fe_mul(const Curve & c, const Fe & a, const Fe & b) {
+    mp_limb_t scratch[2 * MAX_LIMBS];
+    Fe out = {};
+    c.field.mul(out.v, a.v, b.v, scratch);
+    return out;
+}
+
+static Fe fe_sqr(const Curve & c, const Fe & a) {
+    mp_limb_t scratch[2 * MAX_LIMBS];
+    Fe out = {};
+    c.field.sqr(out.v, a.v, scratch);
+    return out;
+}
+
+static bool fe_iszero(const Curve & c, const Fe & a) {
+    mp_limb_t x = 0;
+    for(mp_size_t i = 0; i < c.limbs; i++) {
+        x |= a.v[i];
+    }
+    return !x;
+}
+
+static bool fe_equal(const Curve & c, const Fe & a, const Fe & b) {
+    return !mpn_cmp(a.v, b.v, c.limbs);
+}
+
+static void fe_cmov(const Curve & c, Fe & out, const Fe & a, const uint8_t flag) {
+    const mp_limb_t mask = -static_cast <mp_limb_t> (flag);
+    for(mp_size_t i = 0; i < c.limbs; i++) {
+        out.v[i] ^= mask & (out.v[i] ^ a.v[i]);
+    }
+}
+
+// variable time inverse, for public values
+static Fe fe_invert(const Curve & c, const Fe & a) {
+    return fe(c, invert(fe_get(c, a), c.p));
+}
+
+// a^(p - 2); the sequence of operations only depends on p
+static Fe fe_invert_sec(const Curve & c, const Fe & a) {
+    const MPI e = c.p - 2;
+    Fe out = c.one;
+    for(std::size_t i = c.bits; i > 0; i--) {
+        out = fe_sqr(c, out);
+        if (mpz_tstbit(e.get_mpz_t(), i - 1)) {
+            out = fe_mul(c, out, a);
+        }
+    }
+    return out;
+}
+
+static Jacobian infinity(const Curve & c) {
+    return Jacobian{c.one, c.one, Fe()};
+}
+
+static bool is_infinity(const Curve & c, const Jacobian & p) {
+    return fe_iszero(c, p.Z);
+}
+
+static Jacobian lift(const Curve & c, const Affine & p) {
+    return Jacobian{p.x, p.y, c.one};
+}
+
+static Affine negate(const Curve & c, const Affine & p) {
+    return Affine{p.x, fe_neg(c, p.y)};
+}
+
+static void jacobian_cmov(const Curve & c, Jacobian & p, const Jacobian & q, const uint8_t flag) {
+    fe_cmov(c, p.X, q.X, flag);
+    fe_cmov(c, p.Y, q.Y, flag);
+    fe_cmov(c, p.Z, q.Z, flag);
+}
+
+// dbl-2001-b (a = -3); also correct for the point at infinity
+static Jacobian dbl(const Curve & c, const Jacobian & p) {
+    const Fe delta = fe_sqr(c, p.Z);
+    const Fe gamma = fe_sqr(c, p.Y);
+    const Fe beta  = fe_mul(c, p.X, gamma);
+    const Fe t     = fe_mul(c, fe_sub(c, p.X, delta), fe_add(c, p.X, delta));
+    const Fe alpha = fe_add(c, fe_add(c, t, t), t);
+    const Fe beta2 = fe_add(c, beta, beta);
+    const Fe beta4 = fe_add(c, beta2, beta2);
+    const Fe beta8 = fe_add(c, beta4, beta4);
+
+    Jacobian r;
+    r.X = fe_sub(c, fe_sqr(c, alpha), beta8);
+    r.Z = fe_sub(c, fe_sub(c, fe_sqr(c, fe_add(c, p.Y, p.Z)), gamma), delta);
+
+    const Fe gamma2 = fe_sqr(c, gamma);
+    const Fe gamma4 = fe_add(c, gamma2, gamma2);
+    const Fe gamma8 = fe_add(c, gamma4, gamma4);
+    r.Y = fe_sub(c, fe_mul(c, alpha, fe_sub(c, beta4, r.X)), fe_add(c, gamma8, gamma8));
+    return r;
+}
+
+// madd-2007-bl
+// Z3 = 2 * Z1 * (X2 * Z1^2 - X1), so the result is the point at infinity
+// if p is the point at infinity, p = q or p = -q; none of these are checked
+static Jacobian madd_unchecked(const Curve & c, const Jacobian & p, const Affine & q) {
+    const Fe Z1Z1 = fe_sqr(c, p.Z);
+    const Fe U2   = fe_mul(c, q.x, Z1Z1);
+    const Fe S2   = fe_mul(c, q.y, fe_mul(c, p.Z, Z1Z1));
+    const Fe H    = fe_sub(c, U2, p.X);
+    const Fe HH   = fe_sqr(c, H);
+    const Fe HH2  = fe_add(c, HH, HH);
+    const Fe I    = fe_add(c, HH2, HH2);
+    const Fe J    = fe_mul(c, H, I);
+    const Fe d    = fe_sub(c, S2, p.Y);
+    const Fe r    = fe_add(c, d, d);
+    const Fe V    = fe_mul(c, p.X, I);
+
+    Jacobian out;
+    out.X = fe_sub(c, fe_sub(c, fe_sqr(c, r), J), fe_add(c, V, V));
+    const Fe YJ = fe_mul(c, p.Y, J);
+    out.Y = fe_sub(c, fe_mul(c, r, fe_sub(c, V, out.X)), fe_add(c, YJ, YJ));
+    out.Z = fe_sub(c, fe_sub(c, fe_sqr(c, fe_add(c, p.Z, H)), Z1Z1), HH);
+    return out;
+}
+
+// p + q for public points
+static Jacobian madd(const Curve & c, const Jacobian & p, const Affine & q) {
+    if (is_infinity(c, p)) {
+        return lift(c, q);
+    }
+
+    const Jacobian r = madd_unchecked(c, p, q);
+    if (!is_infinity(c, r)) {
+        return r;
+    }
+
+    // x coordinates are equal
+    const Fe Z1Z1 = fe_sqr(c, p.Z);
+    if (fe_equal(c, fe_mul(c, q.y, fe_mul(c, p.Z, Z1Z1)), p.Y)) {
+        return dbl(c, p);
+    }
+    return infinity(c);
+}
+
+// add-2007-bl for public points
+static Jacobian add(const Curve & c, const Jacobian & p, const Jacobian & q) {
+    if (is_infinity(c, p)) {
+        return q;
+    }
+    if (is_infinity(c, q)) {
+        return p;
+    }
+
+    const Fe Z1Z1 = fe_sqr(c, p.Z);
+    const Fe Z2Z2 = fe_sqr(c, q.Z);
+    const Fe U1   = fe_mul(c, p.X, Z2Z2);
+    const Fe U2   = fe_mul(c, q.X, Z1Z1);
+    const Fe S1   = fe_mul(c, p.Y, fe_mul(c, q.Z, Z2Z2));
+    const Fe S2   = fe_mul(c, q.Y, fe_mul(c, p.Z, Z1Z1));
+    const Fe H    = fe_sub(c, U2, U1);
+
+    if (fe_iszero(c, H)) {
+        return fe_equal(c, S1, S2)?dbl(c, p):infinity(c);
+    }
+
+    const Fe H2   = fe_add(c, H, H);
+    const Fe I    = fe_sqr(c, H2);
+    const Fe J    = fe_mul(c, H, I);
+    const Fe d    = fe_sub(c, S2, S1);
+    const Fe r    = fe_add(c, d, d);
+    const Fe V    = fe_mul(c, U1, I);
+
+    Jacobian out;
+    out.X = fe_sub(c, fe_sub(c, fe_sqr(c, r), J), fe_add(c, V, V));
+    const Fe SJ = fe_mul(c, S1, J);
+    out.Y = fe_sub(c, fe_mul(c, r, fe_sub(c, V, out.X)), fe_add(c, SJ, SJ));
+    out.Z = fe_mul(c, fe_sub(c, fe_sub(c, fe_sqr(c, fe_add(c, p.Z, q.Z)), Z1Z1), Z2Z2), H);
+    return out;
+}
+
+// affine coordinates of many points with a single inversion (Montgomery's trick)
+// none of the points may be the point at infinity
+static std::vector <Affine> normalize(const Curve & c, const std::vector <Jacobian> & points) {
+    std::vector <Fe> prefix(points.size());
+    Fe acc = c.one;
+    for(std::size_t i = 0; i < points.size(); i++) {
+        prefix[i] = acc;
+        acc = fe_mul(c, acc, points[i].Z);
+    }
+
+    Fe inv = fe_invert(c, acc);
+    std::vector <Affine> out(points.size());
+    for(std::size_t i = points.size(); i > 0; i--) {
+        const Jacobian & p = points[i - 1];
+        const Fe zinv  = fe_mul(c, inv, prefix[i - 1]);
+        const Fe zinv2 = fe_sqr(c, zinv);
+        inv = fe_mul(c, inv, p.Z);
+
+        out[i - 1].x = fe_mul(c, p.X, zinv2);
+        out[i - 1].y = fe_mul(c, p.Y, fe_mul(c, zinv2, zinv));
+    }
+
+    return out;
+}
+
+// P, 3P, 5P, ..., (2^(POINT_WINDOW - 1) - 1)P
+static std::vector <Jacobian> odd_multiples(const Curve & c, const Affine & p) {
+    std::vector <Jacobian> out(static_cast <std::size_t> (1) << (POINT_WINDOW - 2));
+    const Jacobian p2 = dbl(c, lift(c, p));
+    out[0] = lift(c, p);
+    for(std::size_t i = 1; i < out.size(); i++) {
+        out[i] = add(c, out[i - 1], p2);
+    }
+    return out;
+}
+
+static Curve * build_curve(const CurveParameters & params) {
+    Curve * c = new Curve(params);
+    c -> one = fe(*c, 1);
+    c -> b = fe(*c, hextompi(params.b));
+    c -> g.x = fe(*c, hextompi(params.gx));
+    c -> g.y = fe(*c, hextompi(params.gy));
+
+    // one row per signed radix 16 digit, including the final carry
+    const std::size_t rows = (c -> size << 1) + 1;
+    std::vector <Jacobian> points;
+    points.reserve(rows << 3);
+
+    Jacobian p = lift(*c, c -> g);
+    for(std::size_t i = 0; i < rows; i++) {
+        Jacobian q = p;
+        points.push_back(q);
+        for(int j = 1; j < 8; j++) {
+            q = add(*c, q, p);
+            points.push_back(q);
+        }
+
+        for(int j = 0; j < 4; j++) {
+            p = dbl(*c, p);
+        }
+    }
+
+    const std::vector <Affine> affine = normalize(*c, points);
+    for(std::size_t i = 0; i < rows; i++) {
+        c -> comb.emplace_back(affine.begin() + (i << 3), affine.begin() + ((i + 1) << 3));
+    }
+
+    return c;
+}
+
+static std::vector <std::unique_ptr <const Curve> > build_curves() {
+    std::vector <std::unique_ptr <const Curve> > out;
+    for(CurveParameters const & params : CURVES) {
+        out.emplace_back(build_curve(params));
+    }
+    return out;
+}
+
+static const std::vector <std::unique_ptr <const Curve> > & curves() {
+    static const std::vector <std::unique_ptr <const Curve> > all = build_curves();
+    return all;
+}
+
+// 1 if b == c
+static uint8_t equal(const uint8_t b, const uint8_t c) {
+    uint32_t x = b ^ c;
+    x -= 1;
+    return x >> 31;
+}
+
+// signed radix 16 digits in [-8, 8] of 0 <= k < 2^bits, least significant first
+static std::vector <int8_t> radix16(const Curve & c, const MPI & k) {
+    std::vector <uint8_t> bytes(c.size, 0);
+    mpz_export(bytes.data(), nullptr, -1, 1, 0, 0, k.get_mpz_t());
+
+    std::vector <int8_t> e((c.size << 1) + 1, 0);
+    for(std::size_t i = 0; i < c.size; i++) {
+        e[2 * i + 0] = bytes[i] & 15;
+        e[2 * i + 1] = (bytes[i] >> 4) & 15;
+    }
+
+    int8_t carry = 0;
+    for(std::size_t i = 0; i + 1 < e.size(); i++) {
+        e[i] += carry;
+        carry = (e[i] + 8) >> 4;
+        e[i] -= carry << 4;
+    }
+    e.back() = carry;
+
+    return e;
+}
+
+// b * row[0] for b in [-8, 8] without branching on b; b = 0 gives garbage
+static Affine select(const Curve & c, const std::vector <Affine> & row, const int8_t b) {
+    const uint8_t negative = static_cast <uint8_t> (b) >> 7;
+    const uint8_t babs = b - ((static_cast <uint8_t> (-negative) & b) << 1);
+
+    Affine t = row[0];
+    for(int i = 1; i < 8; i++) {
+        fe_cmov(c, t.x, row[i].x, equal(babs, i + 1));
+        fe_cmov(c, t.y, row[i].y, equal(babs, i + 1));
+    }
+
+    fe_cmov(c, t.y, fe_neg(c, t.y), negative);
+    return t;
+}
+
+// [k]G for secret 0 < k < n
+// The additions never see equal points unless k was chosen to make
+// a partial sum collide with a table entry, which is negligible for
+// random k, so no branches or table lookups depend on k
+static Jacobian base_mult_sec(const Curve & c, const MPI & k) {
+    const std::vector <int8_t> e = radix16(c, k);
+
+    Jacobian r = infinity(c);
+    uint8_t at_infinity = 1;
+    for(std::size_t i = 0; i < e.size(); i++) {
+        const Affine t = select(c, c.comb[i], e[i]);
+        const uint8_t zero = equal(static_cast <uint8_t> (e[i]), 0);
+
+        Jacobian sum = madd_unchecked(c, r, t);
+        jacobian_cmov(c, sum, lift(c, t), at_infinity);
+        jacobian_cmov(c, r, sum, zero ^ 1);
+        at_infinity &= zero;
+    }
+
+    return r;
+}
+
+// width-w non-adjacent form of 0 <= a < 2^bits
+static std::vector <int8_t> wnaf(const MPI & a, const unsigned int w, const std::size_t bits) {
+    std::vector <mp_limb_t> x((bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS + 1, 0);
+    mpz_export(x.data(), nullptr, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, a.get_mpz_t());
+
+    // a negative digit near the top carries up to w positions past bits
+    std::vector <int8_t> naf(bits + w, 0);
+    const mp_limb_t width = static_cast <mp_limb_t> (1) << w;
+    const mp_limb_t mask = width - 1;
+
+    std::size_t pos = 0;
+    mp_limb_t carry = 0;
+    while (pos < naf.size()) {
+        const std::size_t idx = pos / GMP_NUMB_BITS;
+        const std::size_t bit = pos % GMP_NUMB_BITS;
+        mp_limb_t buf = (idx < x.size())?(x[idx] >> bit):0;
+        if ((bit > GMP_NUMB_BITS - w) && (idx + 1 < x.size())) {
+            buf |= x[idx + 1] << (GMP_NUMB_BITS - bit);
+        }
+
+        const mp_limb_t window = carry + (buf & mask);
+        if (!(window & 1)) {
+            pos++;
+            continue;
+        }
+
+        if (window < (width >> 1)) {
+            carry = 0;
+            naf[pos] = static_cast <int8_t> (window);
+        }
+        else {
+            carry = 1;
+            naf[pos] = static_cast <int8_t> (static_cast <int> (window) - static_cast <int> (width));
+        }
+
+        pos += w;
+    }
+
+    return naf;
+}
+
+// [u1]G + [u2]Q given the odd multiples of Q, in variable time
+// Q's part shares one chain of doublings; G's part only needs the additions of the comb
+static Jacobian combine(const Curve & c, const MPI & u1, const MPI & u2, const Affine * odd) {
+    const std::vector <int8_t> naf = wnaf(u2, POINT_WINDOW, c.bits);
+
+    std::size_t top = naf.size();
+    while (top && !naf[top - 1]) {
+        top--;
+    }
+
+    Jacobian r = infinity(c);
+    for(std::size_t i = top; i > 0; i--) {
+        r = dbl(c, r);
+        const int8_t d = naf[i - 1];
+        if (d > 0) {
+            r = madd(c, r, odd[d >> 1]);
+        }
+        else if (d < 0) {
+            r = madd(c, r, negate(c, odd[(-d) >> 1]));
+        }
+    }
+
+    const std::vector <int8_t> e = radix16(c, u1);
+    for(std::size_t i = 0; i < e.size(); i++) {
+        if (e[i] > 0) {
+            r = madd(c, r, c.comb[i][e[i] - 1]);
+        }
+        else if (e[i] < 0) {
+            r = madd(c, r, negate(c, c.comb[i][-e[i] - 1]));
+        }
+    }
+
+    return r;
+}
+
+// leftmost bits of the digest as an integer
+static MPI bits2int(const Curve & c, const std::string & digest) {
+    MPI e = digest.size()?rawtompi(digest):MPI(0);
+    if ((digest.size() << 3) > c.bits) {
+        e >>= (digest.size() << 3) - c.bits;
+    }
+    return e;
+}
+
+// MPI as a string of exactly size octets
+static std::string octets(const MPI & m, const std::size_t size) {
+    const std::string raw = (m == 0)?"":mpitoraw(m);
+    if (raw.size() > size) {
+        return "";
+    }
+    return std::string(size - raw.size(), 0) + raw;
+}
+
+static MPI encode(const Curve & c, const Affine & p) {
+    return rawtompi(std::string(1, PREFIX) + octets(fe_get(c, p.x), c.size) + octets(fe_get(c, p.y), c.size));
+}
+
+// curve and point of {0x04 || X || Y}, checked to be on the curve
+static const Curve * point(const Values & pub, Affine & q) {
+    if (pub.size() != 1) {
+        return nullptr;
+    }
+
+    const std::string raw = mpitoraw(pub[0]);
+    if (raw[0] != PREFIX) {
+        return nullptr;
+    }
+
+    for(std::unique_ptr <const Curve> const & ptr : curves()) {
+        const Curve & c = *ptr;
+        if (raw.size() != (c.size << 1) + 1) {
+            continue;
+        }
+
+        const MPI x = rawtompi(raw.substr(1, c.size));
+        const MPI y = rawtompi(raw.substr(1 + c.size, c.size));
+        if ((x >= c.p) || (y >= c.p)) {
+            return nullptr;
+        }
+
+        q.x = fe(c, x);
+        q.y = fe(c, y);
+
+        // y^2 = x^3 - 3x + b
+        const Fe x3 = fe_mul(c, fe_sqr(c, q.x), q.x);
+        const Fe x3b = fe_add(c, fe_sub(c, x3, fe_add(c, fe_add(c, q.x, q.x), q.x)), c.b);
+        if (!fe_equal(c, fe_sqr(c, q.y), x3b)) {
+            return nullptr;
+        }
+
+        return &c;
+    }
+
+    return nullptr;
+}
+
+// both values in [1, n - 1]
+static bool signature(const Curve & c, const Values & sig) {
+    return ((sig.size() == 2)              &&
+            (sig[0] > 0) && (sig[0] < c.n) &&
+            (sig[1] > 0) && (sig[1] < c.n));
+}
+
+// x([e * w]G + [r * w]Q) mod n == r, with w = s^-1 mod n
+// compared against X / Z^2 without inverting Z
+static bool check(const Curve & c, const MPI & e, const MPI & r, const MPI & w, const Affine * odd) {
+    const MPI u1 = (e * w) % c.n;
+    const MPI u2 = (r * w) % c.n;
+
+    const Jacobian R = combine(c, u1, u2, odd);
+    if (is_infinity(c, R)) {
+        return false;
+    }
+
+    const Fe Z2 = fe_sqr(c, R.Z);
+    if (fe_equal(c, fe_mul(c, fe(c, r), Z2), R.X)) {
+        return true;
+    }
+
+    // x may have been reduced modulo n
+    const MPI rn = r + c.n;
+    return ((rn < c.p) && fe_equal(c, fe_mul(c, fe(c, rn), Z2), R.X));
+}
+
+// replaces each value with its inverse modulo n using a single inversion
+static void invert_all(std::vector <MPI> & values, const MPI & n) {
+    std::vector <MPI> prefix(values.size());
+    MPI acc = 1;
+    for(std::size_t i = 0; i < values.size(); i++) {
+        prefix[i] = acc;
+        acc = (acc * values[i]) % n;
+    }
+
+    MPI inv = invert(acc, n);
+    for(std::size_t i = values.size(); i > 0; i--) {
+        const MPI value = values[i - 1];
+        values[i - 1] = (inv * prefix[i - 1]) % n;
+        inv = (inv * value) % n;
+    }
+}
+
+Values keygen(const std::string & curve) {
+    for(std::unique_ptr <const Curve> const & ptr : curves()) {
+        const Curve & c = *ptr;
+        if (c.oid != curve) {
+            continue;
+        }
+
+        // 0 < d < n (FIPS 186-4 B.4.2)
+        const MPI d = RNG::random_mpi(c.n - 1) + 1;
+
+        const Jacobian q = base_mult_sec(c, d);
+        return {encode(c, normalize(c, {q})[0]), d};
+    }
+
+    // "Error: Unsupported ECDSA curve.\n";
+    return {};
+}
+
+Values sign(const std::string & digest, const Values & pri, const Values & pub, MPI k) {
+    Affine q;
+    const Curve * curve = point(pub, q);
+    if (!curve) {
+        // "Error: Bad ECDSA public key.\n";
+        return {};
+    }
+    const Curve & c = *curve;
+
+    if ((pri.size() != 1) || (pri[0] <= 0) || (pri[0] >= c.n)) {
+        // "Error: Bad ECDSA secret key.\n";
+        return {};
+    }
+
+    const bool set_k = (k == 0);
+    if (!set_k && (k >= c.n)) {
+        return {};
+    }
+
+    const MPI e = bits2int(c, digest);
+
+    MPI r = 0, s = 0;
+    while ((r == 0) || (s == 0)) {
+        // 0 < k < n
+        if (set_k) {
+            k = RNG::random_mpi(c.n - 1) + 1;
+        }
+
+        // r = x([k]G) mod n
+        const Jacobian R = base_mult_sec(c, k);
+        const Fe zinv = fe_invert_sec(c, R.Z);
+        r = fe_get(c, fe_mul(c, R.X, fe_sqr(c, zinv))) % c.n;
+
+        // s = k^-1 (e + d * r) mod n
+        s = (invert(k, c.n) * (e + pri[0] * r)) % c.n;
+
+        if (!set_k && ((r == 0) || (s == 0))) {
+            return {};
+        }
+    }
+
+    return {r, s};
+}
+
+bool verify(const std::string & digest, const Values & sig, const Values & pub) {
+    Affine q;
+    const Curve * curve = point(pub, q);
+    if (!curve || !signature(*curve, sig)) {
+        return false;
+    }
+    const Curve & c = *curve;
+
+    const std::vector <Affine> odd = normalize(c, odd_multiples(c, q));
+    return check(c, bits2int(c, digest), sig[0], invert(sig[1], c.n), odd.data());
+}
+
+std::vector <bool> verify(const std::vector <std::string> & digests, const std::vector <Values> & sigs, const std::vector <Values> & pubs) {
+    const std::size_t count = digests.size();
+    if ((sigs.size() != count) || (pubs.size() != count)) {
+        // "Error: Mismatched batch sizes.\n";
+        return std::vector <bool> (count, false);
+    }
+
+    // malformed entries are left out
+    std::vector <bool> out(count, false);
+    std::vector <const Curve *> curve(count, nullptr);
+    std::vector <Affine> q(count);
+    for(std::size_t i = 0; i < count; i++) {
+        curve[i] = point(pubs[i], q[i]);
+        if (curve[i] && !signature(*curve[i], sigs[i])) {
+            curve[i] = nullptr;
+        }
+    }
+
+    // one pass per curve
+    const std::size_t rows = static_cast <std::size_t> (1) << (POINT_WINDOW - 2);
+    for(std::unique_ptr <const Curve> const & ptr : curves()) {
+        const Curve & c = *ptr;
+
+        std::vector <std::size_t> index;
+        std::vector <MPI> w;
+        std::vector <Jacobian> tables;
+        for(std::size_t i = 0; i < count; i++) {
+            if (curve[i] == &c) {
+                index.push_back(i);
+                w.push_back(sigs[i][1]);
+                const std::vector <Jacobian> odd = odd_multiples(c, q[i]);
+                tables.insert(tables.end(), odd.begin(), odd.end());
+            }
+        }
+
+        if (!index.size()) {
+            continue;
+        }
+
+        invert_all(w, c.n);
+        const std::vector <Affine> odd = normalize(c, tables);
+        for(std::size_t j = 0; j < index.size(); j++) {
+            const std::size_t i = index[j];
+            out[i] = check(c, bits2int(c, digests[i]), sigs[i][0], w[j], odd.data() + j * rows);
+        }
+    }
+
+    return out;
+}
+
+}
+}
+}
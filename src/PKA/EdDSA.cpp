@@ -0,0 +1,124 @@
+#include "PKA/EdDSA.h"
+
+#include "RNG/RNGs.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace EdDSA {
+
+// native point prefix
+static const char PREFIX = 0x40;
+
+// MPI as a string of exactly size octets
+static std::string octets(const MPI & m, const std::size_t size) {
+    const std::string raw = (m == 0)?"":mpitoraw(m);
+    if (raw.size() > size) {
+        return "";
+    }
+    return std::string(size - raw.size(), 0) + raw;
+}
+
+// A from {0x40 || A}
+static std::string point(const Values & pub) {
+    if (pub.size() != 1) {
+        return "";
+    }
+
+    const std::string raw = mpitoraw(pub[0]);
+    if ((raw.size() != Curve25519::SIZE + 1) || (raw[0] != PREFIX)) {
+        return "";
+    }
+
+    return raw.substr(1);
+}
+
+// R || S from {R, S}
+static std::string signature(const Values & sig) {
+    if (sig.size() != 2) {
+        return "";
+    }
+
+    const std::string R = octets(sig[0], Curve25519::SIZE);
+    const std::string S = octets(sig[1], Curve25519::SIZE);
+    if (!R.size() || !S.size()) {
+        return "";
+    }
+
+    return R + S;
+}
+
+Values keygen() {
+    const std::string seed = RNG::RNG().rand_bytes(Curve25519::SIZE);
+    return {rawtompi(std::string(1, PREFIX) + Curve25519::ed25519_public(seed)), rawtompi(seed)};
+}
+
+Values sign(const std::string & digest, const Values & pri, const Values & pub) {
+    if (pri.size() != 1) {
+        // "Error: Bad EdDSA secret key.\n";
+        return {};
+    }
+
+    const std::string A = point(pub);
+    const std::string seed = octets(pri[0], Curve25519::SIZE);
+    if (!A.size() || !seed.size()) {
+        // "Error: Bad EdDSA key.\n";
+        return {};
+    }
+
+    const std::string sig = Curve25519::ed25519_sign(digest, seed, A);
+    if (!sig.size()) {
+        return {};
+    }
+
+    return {rawtompi(sig.substr(0, Curve25519::SIZE)), rawtompi(sig.substr(Curve25519::SIZE))};
+}
+
+bool verify(const std::string & digest, const Values & sig, const Values & pub) {
+    const std::string A = point(pub);
+    const std::string RS = signature(sig);
+    if (!A.size() || !RS.size()) {
+        return false;
+    }
+
+    return Curve25519::ed25519_verify(digest, RS, A);
+}
+
+std::vector <bool> verify(const std::vector <std::string> & digests, const std::vector <Values> & sigs, const std::vector <Values> & pubs) {
+    const std::size_t n = digests.size();
+    if ((sigs.size() != n) || (pubs.size() != n)) {
+        // "Error: Mismatched batch sizes.\n";
+        return std::vector <bool> (n, false);
+    }
+
+    // malformed entries are left out of the combined check
+    std::vector <bool> out(n, false);
+    std::vector <std::size_t> index;
+    std::vector <std::string> messages, RS, A;
+    for(std::size_t i = 0; i < n; i++) {
+        const std::string a = point(pubs[i]);
+        const std::string rs = signature(sigs[i]);
+        if (a.size() && rs.size()) {
+            index.push_back(i);
+            messages.push_back(digests[i]);
+            RS.push_back(rs);
+            A.push_back(a);
+        }
+    }
+
+    if (Curve25519::ed25519_verify(messages, RS, A)) {
+        for(std::size_t const i : index) {
+            out[i] = true;
+        }
+    }
+    else{
+        for(std::size_t i = 0; i < index.size(); i++) {
+            out[index[i]] = Curve25519::ed25519_verify(messages[i], RS[i], A[i]);
+        }
+    }
+
+    return out;
+}
+
+}
+}
+}
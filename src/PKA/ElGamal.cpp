@@ -1,6 +1,7 @@
 #include "PKA/ElGamal.h"
 
 #include "Misc/pgptime.h"
+#include "PKA/FixedBase.h"
 #include "RNG/RNGs.h"
 #include "common/includes.h"
 
@@ -11,16 +12,16 @@ namespace ElGamal {
 Values keygen(unsigned int bits) {
     bits /= 5;
     // random prime q - only used for key generation
-    MPI q = bintompi(RNG::RNG().rand_bits(bits));
+    MPI q = RNG::random_mpi(bits);
     q = nextprime(q);
     while (bitsize(q) > bits) {
-        q = bintompi(RNG::RNG().rand_bits(bits));
+        q = RNG::random_mpi(bits);
         q = nextprime(q);
     }
     bits *= 5;
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::RNG().rand_bits(bits - 1));           // pick random starting point
+    MPI p = RNG::random_mpi(bits, RNG::TOP_BIT);                      // pick random starting point
     p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
     while (!knuth_prime_test(p, 25)) {
         p += q;
@@ -36,8 +37,8 @@ Values keygen(unsigned int bits) {
 
     // 0 < x < p
     MPI x = 0;
-    while ((x == 0) || (p <= x)) {
-        x = bintompi(RNG::RNG().rand_bits(bits));
+    while (x == 0) {
+        x = RNG::random_mpi(p);
     }
 
     // y = g^x mod p
@@ -47,19 +48,84 @@ Values keygen(unsigned int bits) {
     return {p, g, y, x};
 }
 
+Values standard_group(const unsigned int bits) {
+    for(Group const & group : MODP_GROUPS) {
+        if (group.bits == bits) {
+            return {hextompi(group.p), group.g};
+        }
+    }
+
+    return {};
+}
+
+Values keygen_standard(const unsigned int bits) {
+    const Values group = standard_group(bits);
+    if (!group.size()) {
+        return {};
+    }
+
+    const MPI & p = group[0];
+    const MPI & g = group[1];
+
+    // g generates the subgroup of order q = (p - 1) / 2
+    const MPI q = (p - 1) >> 1;
+
+    // 0 < x < q
+    MPI x = 0;
+    while (x == 0) {
+        x = RNG::random_mpi(q);
+    }
+
+    // y = g^x mod p
+    const MPI y = powm(g, x, p);
+
+    return {p, g, y, x};
+}
+
 Values encrypt(const MPI & data, const Values & pub) {
-    MPI k = bintompi(RNG::RNG().rand_bits(bitsize(pub[0])));
-    k %= pub[0];
-    MPI r, s;
-    r = powm(pub[1], k, pub[0]);
-    s = powm(pub[2], k, pub[0]);
-    return {r, (data * s) % pub[0]};
+    return encrypt(data, pub, ephemeral(pub));
 }
 
 Values encrypt(const std::string & data, const Values & pub) {
     return encrypt(rawtompi(data), pub);
 }
 
+Ephemeral ephemeral(const Values & pub) {
+    const std::size_t bits = bitsize(pub[0]);
+
+    const MPI k = RNG::random_mpi(pub[0]);
+
+    Ephemeral eph;
+    eph.gk = fixed_base_powm(pub[1], k, pub[0], bits);
+    eph.yk = fixed_base_powm(pub[2], k, pub[0], bits);
+    return eph;
+}
+
+Ephemeral ephemeral(const Values & pub, const CombTable & g, const CombTable & y) {
+    const MPI k = RNG::random_mpi(pub[0]);
+
+    Ephemeral eph;
+    eph.gk = powm_sec(g, k);
+    eph.yk = powm_sec(y, k);
+    return eph;
+}
+
+Values encrypt(const MPI & data, const Values & pub, const Ephemeral & eph) {
+    return {eph.gk, (data * eph.yk) % pub[0]};
+}
+
+EphemeralPool::EphemeralPool(const Values & pub, const std::size_t capacity)
+    : Pool <Ephemeral> ([pub]() { return ephemeral(pub); }, capacity)
+{}
+
+Values encrypt(const MPI & data, const Values & pub, EphemeralPool & pool) {
+    return encrypt(data, pub, pool.take());
+}
+
+Values encrypt(const std::string & data, const Values & pub, EphemeralPool & pool) {
+    return encrypt(rawtompi(data), pub, pool);
+}
+
 std::string decrypt(const Values & c, const Values & pri, const Values & pub) {
     MPI s, m;
     s = powm(c[0], pri[0], pub[0]);
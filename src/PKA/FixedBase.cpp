@@ -0,0 +1,76 @@
+#include "PKA/FixedBase.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace OpenPGP {
+namespace PKA {
+
+struct Entry {
+    std::size_t uses;
+    std::shared_ptr <const CombTable> table;
+};
+
+typedef std::tuple <MPI, MPI, std::size_t> Index; // base, mod, bits
+typedef std::map <Index, Entry> Cache;
+
+static std::mutex mutex;
+static Cache cache;
+
+std::shared_ptr <const CombTable> fixed_base(const MPI & base, const MPI & mod, const std::size_t bits) {
+    if ((mod < 3) || !mpz_odd_p(mod.get_mpz_t())) {
+        return nullptr;
+    }
+
+    const Index index(base, mod, bits);
+
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        Cache::iterator it = cache.find(index);
+        if (it == cache.end()) {
+            if (cache.size() >= FIXED_BASE_CACHE_SIZE) {
+                cache.clear();
+            }
+
+            cache[index] = Entry{1, nullptr};
+            return nullptr;
+        }
+
+        if (it -> second.table) {
+            return it -> second.table;
+        }
+
+        it -> second.uses++;
+    }
+
+    // build outside of the lock; if another thread builds the same table, either copy is fine
+    std::shared_ptr <const CombTable> table = std::make_shared <CombTable> (base, mod, bits);
+
+    std::lock_guard <std::mutex> lock(mutex);
+    Cache::iterator it = cache.find(index);
+    if (it != cache.end()) {
+        it -> second.table = table;
+    }
+
+    return table;
+}
+
+MPI fixed_base_powm(const MPI & base, const MPI & exp, const MPI & mod, const std::size_t bits) {
+    if ((exp >= 0) && (bitsize(exp) <= bits)) {
+        const std::shared_ptr <const CombTable> table = fixed_base(base, mod, bits);
+        if (table) {
+            return powm_sec(*table, exp);
+        }
+    }
+
+    return powm(base, exp, mod);
+}
+
+void clear_fixed_base() {
+    std::lock_guard <std::mutex> lock(mutex);
+    cache.clear();
+}
+
+}
+}
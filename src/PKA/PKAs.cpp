@@ -54,6 +54,11 @@ Params generate_params(const uint8_t pka, const std::size_t bits) {
 
             params.push_back((bits == 1024)?160:256);
             break;
+        #ifdef GPG_COMPATIBLE
+        case ID::ECDH:
+        case ID::EdDSA:
+            break;                                       // Curve25519 only; bits is ignored
+        #endif
         default:
             // "Error: Undefined or reserved PKA number: " + std::to_string(pka) + "\n";
             return {};
@@ -62,7 +67,7 @@ Params generate_params(const uint8_t pka, const std::size_t bits) {
     return params;
 }
 
-uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub) {
+uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub, const bool standard) {
     if (!params.size()) {
         // "Error: No PKA key generation configuration provided.\n";
         return 0;
@@ -84,14 +89,34 @@ uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri,
             pub.pop_back();                              // d
             break;
         case ID::ELGAMAL:
-            pub = ElGamal::keygen(params[0]);            // p, g, y, x
+            pub = standard?ElGamal::keygen_standard(params[0]):ElGamal::keygen(params[0]); // p, g, y, x
+            if (!pub.size()) {
+                // "Error: Bad ElGamal key generation values.\n";
+                return 0;
+            }
             pri = {pub[3]};                              // x
             pub.pop_back();                              // x
             break;
         case ID::DSA:
-            pub = DSA::new_public(params[0], params[1]); // p, q, g, y
+            pub = standard?DSA::standard_public(params[0], params[1]):DSA::new_public(params[0], params[1]); // p, q, g
+            if (!pub.size()) {
+                // "Error: Bad DSA parameters.\n";
+                return 0;
+            }
             pri = DSA::keygen(pub);                      // x
             break;
+        #ifdef GPG_COMPATIBLE
+        case ID::ECDH:
+            pub = ECDH::keygen();                        // 0x40 || u, k
+            pri = {pub[1]};                              // k
+            pub.pop_back();                              // k
+            break;
+        case ID::EdDSA:
+            pub = EdDSA::keygen();                       // 0x40 || A, seed
+            pri = {pub[1]};                              // seed
+            pub.pop_back();                              // seed
+            break;
+        #endif
         default:
             // "Error: Undefined or reserved PKA number: " + std::to_string(pka) + "\n";
             return 0;
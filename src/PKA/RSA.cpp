@@ -19,8 +19,8 @@ Values keygen(const uint32_t & bits) {
 
     MPI n;
     while (true) {
-        p = nextprime(bintompi("1" + RNG::RNG().rand_bits(bits - 1)));
-        q = nextprime(bintompi("1" + RNG::RNG().rand_bits(bits - 1)));
+        p = nextprime(RNG::random_mpi(bits, RNG::TOP_BIT));
+        q = nextprime(RNG::random_mpi(bits, RNG::TOP_BIT));
         n = p * q;
 
         const std::size_t nbits = bitsize(n);
@@ -31,8 +31,8 @@ Values keygen(const uint32_t & bits) {
     #else
     // don't check bitsize
     while (p == q) {
-        p = nextprime(bintompi(RNG::RNG().rand_bits(bits)));
-        q = nextprime(bintompi(RNG::RNG().rand_bits(bits)));
+        p = nextprime(RNG::random_mpi(bits));
+        q = nextprime(RNG::random_mpi(bits));
     }
     const MPI n = p * q;
     #endif
@@ -44,8 +44,7 @@ Values keygen(const uint32_t & bits) {
 
     const MPI tot = (p - 1) * (q - 1);
 
-    MPI e = bintompi(RNG::RNG().rand_bits(bits));
-    e += ((e & 1) == 0);
+    MPI e = RNG::random_mpi(bits, RNG::ODD);
     while (mpigcd(tot, e) != 1) {
         e += 2;
     }
@@ -0,0 +1,231 @@
+#include "PacketReader.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Misc/Length.h"
+#include "PGP.h"
+#include "common/includes.h"
+
+namespace OpenPGP {
+
+PacketReader::Body::int_type PacketReader::Body::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    const std::size_t got = reader.read(buffer.data(), buffer.size());
+    if (!got) {
+        return traits_type::eof();
+    }
+
+    setg(buffer.data(), buffer.data(), buffer.data() + got);
+    return traits_type::to_int_type(*gptr());
+}
+
+PacketReader::Body::Body(PacketReader & r, const std::size_t buffer_size)
+    : std::streambuf(),
+      reader(r),
+      buffer(buffer_size?buffer_size:1)
+{
+    reset();
+}
+
+void PacketReader::Body::reset() {
+    setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+uint8_t PacketReader::get() {
+    const std::istream::int_type c = in.get();
+    if (c == std::istream::traits_type::eof()) {
+        throw std::runtime_error("Error: Stream ended inside a packet header.");
+    }
+
+    offset++;
+    return c;
+}
+
+void PacketReader::read_old_length(const uint8_t ctb) {
+    last = true;
+    remaining = 0;
+    switch (ctb & 3) {
+        case 0:                                     // one-octet length
+            remaining = get();
+            break;
+        case 1:                                     // two-octet length
+            for(uint8_t i = 0; i < 2; i++) {
+                remaining = (remaining << 8) | get();
+            }
+            break;
+        case 2:                                     // four-octet length
+            for(uint8_t i = 0; i < 4; i++) {
+                remaining = (remaining << 8) | get();
+            }
+            break;
+        case 3:                                     // indeterminate length; the body is the rest of the stream
+            remaining = UINT64_MAX;
+            indeterminate = true;
+            partial = Packet::PARTIAL;
+            break;
+    }
+}
+
+void PacketReader::read_new_length() {
+    const uint8_t first_octet = get();
+
+    last = true;
+    if (first_octet < 192) {                        // one-octet length
+        remaining = first_octet;
+    }
+    else if (first_octet < 224) {                   // two-octet length
+        remaining = ((first_octet - 192) << 8) + 192;
+        remaining += get();
+    }
+    else if (first_octet == 255) {                  // five-octet length
+        remaining = 0;
+        for(uint8_t i = 0; i < 4; i++) {
+            remaining = (remaining << 8) | get();
+        }
+    }
+    else {                                          // partial body length; another length header follows this piece
+        remaining = read_partialBodyLen(first_octet, format);
+        last = false;
+        partial = Packet::PARTIAL;
+    }
+}
+
+PacketReader::PacketReader(std::istream & stream, const std::size_t buffer_size)
+    : in(stream),
+      offset(0),
+      started(false),
+      tag(Packet::RESERVED),
+      format(Packet::HeaderFormat::NEW),
+      partial(Packet::NOT_PARTIAL),
+      header_offset(0),
+      remaining(0),
+      last(true),
+      indeterminate(false),
+      buf(*this, buffer_size),
+      body_stream(&buf)
+{}
+
+bool PacketReader::next() {
+    // skip the unread part of the current body
+    if (started) {
+        char skip[4096];
+        while (read(skip, sizeof(skip))) {}
+    }
+
+    started = false;
+    buf.reset();
+    body_stream.clear();
+
+    const std::istream::int_type c = in.get();
+    if (c == std::istream::traits_type::eof()) {
+        return false;
+    }
+
+    header_offset = offset++;
+
+    const uint8_t ctb = c;
+    if (!(ctb & 0x80)) {
+        throw std::runtime_error("Error: First bit of packet header MUST be 1 (octet " + std::to_string(header_offset) + ": 0x" + makehex(ctb, 2) + ").");
+    }
+
+    partial = Packet::NOT_PARTIAL;
+    indeterminate = false;
+    if (ctb & 0x40) {                               // New length type RFC4880 sec 4.2.2
+        format = Packet::HeaderFormat::NEW;
+        tag = ctb & 0x3f;
+        read_new_length();
+    }
+    else {                                          // Old length type RFC4880 sec 4.2.1
+        format = Packet::HeaderFormat::OLD;
+        tag = (ctb >> 2) & 0xf;
+        read_old_length(ctb);
+    }
+
+    started = true;
+    return true;
+}
+
+uint8_t PacketReader::get_tag() const {
+    return tag;
+}
+
+Packet::HeaderFormat PacketReader::get_format() const {
+    return format;
+}
+
+Packet::PartialBodyLength PacketReader::get_partial() const {
+    return partial;
+}
+
+uint64_t PacketReader::get_offset() const {
+    return header_offset;
+}
+
+std::size_t PacketReader::read(char * out, const std::size_t size) {
+    std::size_t total = 0;
+    while (started && (total < size)) {
+        if (!remaining) {
+            if (last) {
+                break;
+            }
+
+            read_new_length();
+            continue;
+        }
+
+        const std::size_t want = std::min <uint64_t> (size - total, remaining);
+        in.read(out + total, want);
+        const std::size_t got = in.gcount();
+        offset += got;
+        total += got;
+        remaining -= got;
+
+        if (got < want) {
+            if (!indeterminate) {
+                throw std::runtime_error("Error: Stream ended inside a packet body.");
+            }
+
+            // reached the end of an indeterminate length body
+            remaining = 0;
+            in.clear(in.rdstate() & ~std::ios::failbit);
+            break;
+        }
+    }
+
+    return total;
+}
+
+std::istream & PacketReader::body() {
+    return body_stream;
+}
+
+std::string PacketReader::read_body() {
+    std::string out;
+    if (started && last && !indeterminate) {
+        out.reserve(remaining);
+    }
+
+    char chunk[4096];
+    std::size_t got = 0;
+    while ((got = read(chunk, sizeof(chunk)))) {
+        out.append(chunk, got);
+    }
+
+    return out;
+}
+
+Packet::Tag::Ptr PacketReader::packet() {
+    if (!started) {
+        return nullptr;
+    }
+
+    const std::string data = read_body();
+    std::string::size_type pos = 0;
+    return PGP().read_packet_raw(data, pos, data.size(), tag, format, partial);
+}
+
+}
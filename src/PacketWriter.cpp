@@ -0,0 +1,163 @@
+#include "PacketWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "Misc/Length.h"
+#include "Packets/Partial.h"
+
+namespace OpenPGP {
+
+PacketWriter::Body::int_type PacketWriter::Body::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return traits_type::not_eof(c);
+    }
+
+    const char octet = traits_type::to_char_type(c);
+    writer.write(&octet, 1);
+    return c;
+}
+
+std::streamsize PacketWriter::Body::xsputn(const char * s, std::streamsize n) {
+    writer.write(s, n);
+    return n;
+}
+
+int PacketWriter::Body::sync() {
+    // chunks can only be written once they are full, so only the underlying stream is flushed
+    writer.out.flush();
+    return writer.out?0:-1;
+}
+
+PacketWriter::Body::Body(PacketWriter & w)
+    : std::streambuf(),
+      writer(w)
+{}
+
+void PacketWriter::put(const char * data, const std::size_t size) {
+    if (!out.write(data, size)) {
+        throw std::runtime_error("Error: Could not write packet to stream.");
+    }
+}
+
+void PacketWriter::flush_chunk() {
+    const char header = static_cast <char> (0xe0 | chunk_bits);
+    put(&header, 1);
+    put(chunk.data(), used);
+    used = 0;
+    partial_written = true;
+}
+
+PacketWriter::PacketWriter(std::ostream & stream, const std::size_t chunk_size)
+    : out(stream),
+      started(false),
+      tag(Packet::RESERVED),
+      chunk_bits(9),
+      chunk(),
+      used(0),
+      partial_written(false),
+      length(0),
+      buf(*this),
+      body_stream(&buf)
+{
+    while ((chunk_bits < 30) && ((static_cast <std::size_t> (1) << (chunk_bits + 1)) <= chunk_size)) {
+        chunk_bits++;
+    }
+
+    chunk.resize(static_cast <std::size_t> (1) << chunk_bits);
+}
+
+PacketWriter::~PacketWriter() {
+    try {
+        finish();
+    }
+    catch (...) {}
+}
+
+void PacketWriter::begin(const uint8_t packet_tag) {
+    finish();
+
+    if (!Packet::Partial::can_have_partial_length(packet_tag)) {
+        throw std::runtime_error("Error: Packet type " + std::to_string(packet_tag) + " cannot have partial body lengths.");
+    }
+
+    // partial body lengths are only available with new format headers
+    const char ctb = static_cast <char> (0xc0 | packet_tag);
+    put(&ctb, 1);
+
+    started = true;
+    tag = packet_tag;
+    used = 0;
+    partial_written = false;
+    length = 0;
+    body_stream.clear();
+}
+
+void PacketWriter::write(const char * data, const std::size_t size) {
+    if (!started) {
+        throw std::runtime_error("Error: No packet has been started.");
+    }
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        // a full chunk is only written once more data shows up,
+        // since the last piece of the body must have a definite length
+        if (used == chunk.size()) {
+            flush_chunk();
+        }
+
+        const std::size_t count = std::min(size - pos, chunk.size() - used);
+        std::memcpy(chunk.data() + used, data + pos, count);
+        used += count;
+        pos += count;
+    }
+
+    length += size;
+}
+
+void PacketWriter::write(const std::string & data) {
+    write(data.data(), data.size());
+}
+
+std::ostream & PacketWriter::body() {
+    return body_stream;
+}
+
+void PacketWriter::finish() {
+    if (!started) {
+        return;
+    }
+
+    started = false;
+
+    // the tag octet was written by begin()
+    std::string header;
+    write_new_length_octets(used, header);
+    put(header.data(), header.size());
+    put(chunk.data(), used);
+    used = 0;
+}
+
+void PacketWriter::packet(const Packet::Tag::Ptr & packet) {
+    finish();
+
+    if (packet) {
+        const std::string data = packet -> write();
+        put(data.data(), data.size());
+    }
+}
+
+uint8_t PacketWriter::get_tag() const {
+    return tag;
+}
+
+uint64_t PacketWriter::get_length() const {
+    return length;
+}
+
+std::size_t PacketWriter::get_chunk_size() const {
+    return chunk.size();
+}
+
+}
@@ -1,10 +1,18 @@
 #include "Packets/Key.h"
 
+#include <algorithm>
+
 namespace OpenPGP {
 namespace Packet {
 
 Key::Key(const uint8_t tag)
     : Tag(tag),
+      common_cache(),
+      common_cached(false),
+      fingerprint(),
+      fingerprint_size(0),
+      keyid(0),
+      keyid_cached(false),
       time(),
       pka(),
       mpi(),
@@ -12,7 +20,7 @@ Key::Key(const uint8_t tag)
       #ifdef GPG_COMPATIBLE
       ,
       curve(),
-      kdf_size(),
+      kdf_size(3),      // only one set of KDF parameters is defined
       kdf_hash(),
       kdf_alg()
       #endif
@@ -30,6 +38,14 @@ std::string Key::actual_raw() const {
     return raw_common();
 }
 
+void Key::modified() {
+    Tag::modified();
+    common_cache.clear();
+    common_cached = false;
+    fingerprint_size = 0;
+    keyid_cached = false;
+}
+
 Key::Key()
     : Key(UNKNOWN)
 {}
@@ -43,8 +59,9 @@ Key::Key(const std::string & data)
 Key::~Key() {}
 
 void Key::read_common(const std::string & data, std::string::size_type & pos, const std::string::size_type &) {
+    const std::string::size_type start = pos;
     set_version(data[pos + 0]);
-    set_time(toint(data.substr(pos + 1, 4), 256));
+    set_time(toint(data, pos + 1, 4));
 
     if (version < 4) {
         set_expire((data[pos + 5] << 8) + data[pos + 6]);
@@ -106,6 +123,10 @@ void Key::read_common(const std::string & data, std::string::size_type & pos, co
             throw std::runtime_error("Algorithm not found");
         }
     }
+
+    // keep the public key octets as read; fingerprints and signatures are calculated over them
+    common_cache.assign(data, start, pos - start);
+    common_cached = true;
 }
 
 void Key::show_common(HumanReadable & hr) const {
@@ -156,6 +177,10 @@ void Key::show_common(HumanReadable & hr) const {
 }
 
 std::string Key::raw_common() const {
+    if (common_cached) {
+        return common_cache;
+    }
+
     std::string out = std::string(1, version) + unhexlify(makehex(time, 8));
     if (version < 4) { // to recreate older keys
         out += unhexlify(makehex(expire, 4));
@@ -171,19 +196,21 @@ std::string Key::raw_common() const {
     }
     #endif
 
-    for(MPI const m : mpi) {
-        out += write_MPI(m);
+    for(MPI const & m : mpi) {
+        write_MPI(m, out);
     }
 
     #ifdef GPG_COMPATIBLE
     if (pka == PKA::ID::ECDH) {
-        out += kdf_size; // Should be one
+        out += kdf_size;
         out += std::string(1, 1);
         out += kdf_hash;
         out += kdf_alg;
     }
     #endif
 
+    common_cache = out;
+    common_cached = true;
     return out;
 }
 
@@ -209,52 +236,89 @@ PKA::Values Key::get_mpi() const {
 }
 
 void Key::set_time(uint32_t t) {
+    modified();
     time = t;
 }
 
 void Key::set_expire(const uint32_t t) {
+    modified();
     expire = t;
 }
 
 void Key::set_pka(uint8_t p) {
+    modified();
     pka = p;
 }
 
 void Key::set_mpi(const PKA::Values & m) {
+    modified();
     mpi = m;
 }
 
 std::string Key::get_fingerprint() const {
-    if (version < 4) {
-        std::string data = "";
-        for(MPI const & i : mpi) {
-            std::string m = write_MPI(i);
-            data += m.substr(2, m.size() - 2);
-        }
-        return Hash::MD5(data).digest();
-    }
-    else if (version == 4) {
-        const std::string packet = raw_common();
-        return Hash::SHA1("\x99" + unhexlify(makehex(packet.size(), 4)) + packet).digest();
-    }
-    else{
-        throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
-    }
-    return ""; // should never reach here; mainly just to remove compiler warnings
+    const Fingerprint & fpr = get_fingerprint_array();
+    return std::string(fpr.begin(), fpr.begin() + fingerprint_size);
 }
 
 std::string Key::get_keyid() const {
-    if (version < 4) {
-        std::string data = write_MPI(mpi[0]);
-        return data.substr(data.size() - 8, 8);
+    const uint64_t id = get_keyid_int();
+    std::string out(8, 0);
+    for(uint16_t i = 0; i < 8; i++) {
+        out[i] = byte(id, 7 - i);
     }
-    else if (version == 4) {
-        return get_fingerprint().substr(12, 8);
+    return out;
+}
+
+const Key::Fingerprint & Key::get_fingerprint_array() const {
+    if (!fingerprint_size) {
+        std::string digest;
+        if (version < 4) {
+            std::string data = "";
+            for(MPI const & i : mpi) {
+                const std::string::size_type pos = data.size();
+                data.resize(pos + bytesize(i));
+                mpitoraw(i, &data[pos]);
+            }
+            digest = Hash::MD5(data).digest();
+        }
+        else if (version == 4) {
+            const std::string packet = raw_common();
+            digest = Hash::SHA1("\x99" + unhexlify(makehex(packet.size(), 4)) + packet).digest();
+        }
+        else{
+            throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
+        }
+
+        fingerprint.fill(0);
+        std::copy(digest.begin(), digest.end(), fingerprint.begin());
+        fingerprint_size = digest.size();
     }
-    else{
-        throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
+
+    return fingerprint;
+}
+
+uint64_t Key::get_keyid_int() const {
+    if (!keyid_cached) {
+        if (version < 4) {
+            const std::string data = mpitoraw(mpi[0]);
+            keyid = toint(data.substr(data.size() - 8, 8), 256);
+        }
+        else if (version == 4) {
+            // low 64 bits of the fingerprint
+            const Fingerprint & fpr = get_fingerprint_array();
+            keyid = 0;
+            for(std::size_t i = 12; i < 20; i++) {
+                keyid = (keyid << 8) | fpr[i];
+            }
+        }
+        else{
+            throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
+        }
+
+        keyid_cached = true;
     }
-    return ""; // should never reach here; mainly just to remove compiler warnings
+
+    return keyid;
 }
 
 #ifdef GPG_COMPATIBLE
@@ -262,18 +326,21 @@ std::string Key::get_curve() const {
     return curve;
 }
 void Key::set_curve(const std::string c) {
+    modified();
     curve = c;
 }
 uint8_t Key::get_kdf_hash() const {
     return kdf_hash;
 }
 void Key::set_kdf_hash(const uint8_t h) {
+    modified();
     kdf_hash = h;
 }
 uint8_t Key::get_kdf_alg() const {
     return kdf_alg;
 }
 void Key::set_kdf_alg(const uint8_t a) {
+    modified();
     kdf_alg = a;
 }
 #endif
@@ -73,8 +73,50 @@ Tag::Tag(const uint8_t t)
     : Tag(t, 0)
 {}
 
+bool Tag::keep_raw() const {
+    return true;
+}
+
+void Tag::modified() {
+    raw_cache.clear();
+    raw_cached = false;
+}
+
+const std::string & Tag::cached_raw() const {
+    if (!raw_cached) {
+        raw_cache = actual_raw();
+        raw_cached = true;
+    }
+
+    return raw_cache;
+}
+
+std::size_t Tag::raw_size() const {
+    if (keep_raw()) {
+        return cached_raw().size();
+    }
+    return actual_raw().size();
+}
+
+void Tag::append_raw(std::string & out) const {
+    if (keep_raw()) {
+        out += cached_raw();
+    }
+    else {
+        out += actual_raw();
+    }
+}
+
+// only data packets can have partial body lengths
+static PartialBodyLength get_partial(const Tag & tag) {
+    const Partial * partial = dynamic_cast <const Partial *> (&tag);
+    return partial?partial -> get_partial():NOT_PARTIAL;
+}
+
 Tag::Tag(const uint8_t t, uint8_t ver)
-    : tag(t),
+    : raw_cache(),
+      raw_cached(false),
+      tag(t),
       version(ver),
       header_format(HeaderFormat::NEW),
       size(0)
@@ -89,6 +131,7 @@ Tag::~Tag() {}
 void Tag::read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length, const bool check_end) {
     // set size first, in case the size variable is needed during actual_read
     // the size won't change during actual_read, so there is no need to reset it after
+    modified();
     set_size(length);
     if (size) {
         const std::string::size_type orig_pos = pos;
@@ -96,6 +139,12 @@ void Tag::read(const std::string & data, std::string::size_type & pos, const std
         if (check_end && (pos != (orig_pos + length))) {
             throw std::runtime_error("Bad read of Tag " + std::to_string(tag) + ": offset " + std::to_string(orig_pos) + " + " + std::to_string(length) + " octets; now at " + std::to_string(pos));
         }
+
+        // nothing has changed since the packet was written, so reuse those octets
+        if ((pos == (orig_pos + length)) && keep_raw()) {
+            raw_cache.assign(data, orig_pos, length);
+            raw_cached = true;
+        }
     }
 }
 
@@ -121,7 +170,7 @@ std::string Tag::raw(Status * status, const bool check_mpi) const {
         return "";
     }
 
-    return actual_raw();
+    return keep_raw()?cached_raw():actual_raw();
 }
 
 std::string Tag::write(Status * status, const bool check_mpi) const {
@@ -132,6 +181,32 @@ std::string Tag::write(Status * status, const bool check_mpi) const {
     return actual_write();
 }
 
+std::size_t Tag::write_size() const {
+    const std::size_t length = raw_size();
+    if ((header_format == HeaderFormat::NEW) || // specified new header
+        (tag > 15)) {                           // tag > 15, so new header is required
+        return new_length_size(length, get_partial(*this)) + length;
+    }
+    return old_length_size(length, get_partial(*this)) + length;
+}
+
+void Tag::write_into(std::string & out) const {
+    // partial body length headers are mixed in with the data
+    if (get_partial(*this) == PARTIAL) {
+        out += write();
+        return;
+    }
+
+    if ((header_format == HeaderFormat::NEW) || // specified new header
+        (tag > 15)) {                           // tag > 15, so new header is required
+        write_new_header(tag, raw_size(), out);
+    }
+    else {
+        write_old_header(tag, raw_size(), out);
+    }
+    append_raw(out);
+}
+
 Status Tag::valid(const bool check_mpi) const {
     return actual_valid(check_mpi);
 }
@@ -161,6 +236,7 @@ void Tag::set_header_format(const HeaderFormat hf) {
 }
 
 void Tag::set_version(const uint8_t v) {
+    modified();
     version = v;
 }
 
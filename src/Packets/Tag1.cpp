@@ -4,11 +4,24 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag1::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
+    const std::string::size_type end = pos + length;
     set_version(data[pos + 0]);
     set_keyid(data.substr(pos + 1, 8));
     set_pka(data[pos + 9]);
     pos += 10;
-    while (pos < length) {
+
+    #ifdef GPG_COMPATIBLE
+    // MPI of the ephemeral point followed by the length and the wrapped key
+    if (pka == PKA::ID::ECDH) {
+        mpi.push_back(read_MPI(data, pos));
+        const uint8_t size = data.at(pos);
+        wrapped = data.substr(pos + 1, size);
+        pos += 1 + size;
+        return;
+    }
+    #endif
+
+    while (pos < end) {
         mpi.push_back(read_MPI(data, pos));
     }
 }
@@ -24,13 +37,24 @@ void Tag1::show_contents(HumanReadable & hr) const {
         hr << "ELGAMAL g**k mod p (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
            << "ELGAMAL m * y**k mod p (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDH) {
+        hr << "ECDH ephemeral point: " + mpitohex(mpi[0])
+           << "ECDH wrapped key (" + std::to_string(wrapped.size()) + " octets): " + hexlify(wrapped);
+    }
+    #endif
 }
 
 std::string Tag1::actual_raw() const {
     std::string out = "\x03" + keyid + std::string(1, pka);
-    for(unsigned int x = 0; x < mpi.size(); x++) {
-        out += write_MPI(mpi[x]);
+    for(MPI const & i : mpi) {
+        write_MPI(i, out);
+    }
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH) {
+        out += std::string(1, wrapped.size()) + wrapped;
     }
+    #endif
     return out;
 }
 
@@ -63,7 +87,7 @@ Status Tag1::actual_valid(const bool check_mpi) const {
                 break;
             #ifdef GPG_COMPATIBLE
             case PKA::ID::ECDH:
-                valid_mpi = (mpi.size() == 1);
+                valid_mpi = (mpi.size() == 1) && wrapped.size();
                 break;
             #endif
             default:
@@ -83,6 +107,10 @@ Tag1::Tag1()
       keyid(),
       pka(),
       mpi()
+      #ifdef GPG_COMPATIBLE
+      ,
+      wrapped()
+      #endif
 {}
 
 Tag1::Tag1(const std::string & data)
@@ -103,18 +131,34 @@ PKA::Values Tag1::get_mpi() const {
     return mpi;
 }
 
+#ifdef GPG_COMPATIBLE
+std::string Tag1::get_wrapped() const {
+    return wrapped;
+}
+#endif
+
 void Tag1::set_keyid(const std::string & k) {
+    modified();
     keyid = k;
 }
 
 void Tag1::set_pka(const uint8_t p) {
+    modified();
     pka = p;
 }
 
 void Tag1::set_mpi(const PKA::Values & m) {
+    modified();
     mpi = m;
 }
 
+#ifdef GPG_COMPATIBLE
+void Tag1::set_wrapped(const std::string & w) {
+    modified();
+    wrapped = w;
+}
+#endif
+
 Tag::Ptr Tag1::clone() const {
     return std::make_shared <Packet::Tag1> (*this);
 }
@@ -6,7 +6,7 @@ namespace Packet {
 const std::string Tag10::body = "PGP";
 
 void Tag10::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_pgp(data.substr(pos, length));
+    pgp.assign(data, pos, length);
     pos += length;
 }
 
@@ -47,6 +47,7 @@ std::string Tag10::get_pgp() const {
 }
 
 void Tag10::set_pgp(const std::string & s) {
+    modified();
     pgp = s;
 }
 
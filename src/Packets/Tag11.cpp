@@ -15,9 +15,9 @@ bool Literal::valid(const uint8_t format) {
 void Tag11::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
     set_data_format(data[pos + 0]);
     const uint8_t len = data[pos + 1];
-    set_filename(data.substr(pos + 2, len));
-    set_time(toint(data.substr(pos + 2 + len, 4), 256));
-    set_literal(data.substr(pos + 2 + len + 4, length - 2 - len - 4));
+    filename.assign(data, pos + 2, len);
+    set_time(toint(data, pos + 2 + len, 4));
+    literal.assign(data, pos + 2 + len + 4, length - 2 - len - 4);
     pos += length;
 }
 
@@ -39,6 +39,25 @@ std::string Tag11::actual_raw() const {
     return std::string(1, data_format) + std::string(1, filename.size()) + filename + unhexlify(makehex(time, 8)) + literal;
 }
 
+// literal data is written out once, so caching it only costs memory
+bool Tag11::keep_raw() const {
+    return false;
+}
+
+std::size_t Tag11::raw_size() const {
+    return 2 + filename.size() + 4 + literal.size();
+}
+
+void Tag11::append_raw(std::string & out) const {
+    out += static_cast <char> (data_format);
+    out += static_cast <char> (filename.size());
+    out += filename;
+    for(uint16_t i = 4; i > 0; i--) {
+        out += static_cast <char> (byte(time, i - 1));
+    }
+    out += literal;
+}
+
 std::string Tag11::actual_write() const {
     return Partial::write(header_format, tag, raw());
 }
@@ -117,18 +136,22 @@ std::string Tag11::out(const bool writefile) {
 }
 
 void Tag11::set_data_format(const uint8_t f) {
+    modified();
     data_format = f;
 }
 
 void Tag11::set_filename(const std::string & f) {
+    modified();
     filename = f;
 }
 
 void Tag11::set_time(const uint32_t t) {
+    modified();
     time = t;
 }
 
 void Tag11::set_literal(const std::string & l) {
+    modified();
     literal = l;
 }
 
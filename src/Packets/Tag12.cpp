@@ -4,7 +4,7 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag12::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_trust(data.substr(pos, length));
+    trust.assign(data, pos, length);
     pos += length;
 }
 
@@ -41,6 +41,7 @@ std::string Tag12::get_trust() const {
 }
 
 void Tag12::set_trust(const std::string & t) {
+    modified();
     trust = t;
 }
 
@@ -4,7 +4,7 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag13::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_contents(data.substr(pos, length));
+    contents.assign(data, pos, length);
     pos += length;
 }
 
@@ -36,10 +36,12 @@ std::string Tag13::get_contents() const {
 }
 
 void Tag13::set_contents(const std::string & c) {
+    modified();
     contents = c;
 }
 
 void Tag13::set_info(const std::string & name, const std::string & comment, const std::string & email) {
+    modified();
     contents = name;
 
     if (comment != "") {
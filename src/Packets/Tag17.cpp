@@ -1,18 +1,21 @@
 #include "Packets/Tag17.h"
 
+#include "common/Arena.h"
+
 namespace OpenPGP {
 namespace Packet {
 
 void Tag17::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
     // read subpackets
-    while (pos < length) {
+    const std::string::size_type end = pos + length;
+    while (pos < end) {
         std::string::size_type sublength;
         Subpacket::Sub::read_subpacket(data, pos, sublength);
 
         Subpacket::Tag17::Sub::Ptr subpacket = nullptr;
         switch (const uint8_t type = data[pos]) {
             case Subpacket::Tag17::IMAGE_ATTRIBUTE:
-                subpacket = std::make_shared <Subpacket::Tag17::Sub1> ();
+                subpacket = make_shared_in_arena <Subpacket::Tag17::Sub1> ();
                 break;
             default:
                 throw std::runtime_error("Error: Tag 17 Subpacket tag not defined or reserved: " + std::to_string(type));
@@ -88,6 +91,7 @@ Tag17::Attributes Tag17::get_attributes_clone() const {
 }
 
 void Tag17::set_attributes(const Tag17::Attributes & a) {
+    modified();
     attributes.clear();
     for(Subpacket::Tag17::Sub::Ptr const & s : a) {
         attributes.push_back(s -> clone());
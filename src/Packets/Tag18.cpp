@@ -5,7 +5,7 @@ namespace Packet {
 
 void Tag18::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
     set_version(data[pos + 0]);
-    set_protected_data(data.substr(pos + 1, length - 1));
+    protected_data.assign(data, pos + 1, length - 1);
     pos += length;
 }
 
@@ -22,6 +22,20 @@ std::string Tag18::actual_raw() const {
     return std::string(1, version) + protected_data;
 }
 
+// do not hold a second copy of the protected data
+bool Tag18::keep_raw() const {
+    return false;
+}
+
+std::size_t Tag18::raw_size() const {
+    return 1 + protected_data.size();
+}
+
+void Tag18::append_raw(std::string & out) const {
+    out += static_cast <char> (version);
+    out += protected_data;
+}
+
 std::string Tag18::actual_write() const {
     return Partial::write(header_format, tag, raw());
 }
@@ -59,6 +73,7 @@ std::string Tag18::get_protected_data() const {
 }
 
 void Tag18::set_protected_data(const std::string & p) {
+    modified();
     protected_data = p;
 }
 
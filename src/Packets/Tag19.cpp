@@ -4,7 +4,7 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag19::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_hash(data.substr(pos, length));
+    hash.assign(data, pos, length);
     pos += length;
 }
 
@@ -42,6 +42,7 @@ std::string Tag19::get_hash() const {
 }
 
 void Tag19::set_hash(const std::string & h) {
+    modified();
     hash = h;
 }
 
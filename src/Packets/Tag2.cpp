@@ -2,111 +2,293 @@
 
 #include <stdexcept>
 
+#include "common/Arena.h"
+
 namespace OpenPGP {
 namespace Packet {
 
-void Tag2::read_subpackets(const std::string & data, Tag2::Subpackets & subpackets) {
-    subpackets.clear();
+Tag2::Subpacket_Area::Subpacket_Area()
+    : raw(),
+      index(),
+      decoded(false),
+      modified(false),
+      subpackets()
+{}
+
+// subpackets that have been parsed are cloned; the rest stay unparsed
+Tag2::Subpacket_Area::Subpacket_Area(const Tag2::Subpacket_Area & copy)
+    : raw(copy.raw),
+      index(copy.index),
+      decoded(copy.decoded),
+      modified(copy.modified),
+      subpackets(copy.decoded?clone_subpackets(copy.subpackets):Subpackets())
+{}
+
+Tag2::Subpacket_Area & Tag2::Subpacket_Area::operator=(const Tag2::Subpacket_Area & copy) {
+    Subpackets clones = copy.decoded?clone_subpackets(copy.subpackets):Subpackets();
+    raw = copy.raw;
+    index = copy.index;
+    decoded = copy.decoded;
+    modified = copy.modified;
+    subpackets.swap(clones);
+    return *this;
+}
+
+// subpacket types read_subpacket can parse
+static bool defined_subpacket(const uint8_t type) {
+    switch (type) {
+        case Subpacket::Tag2::SIGNATURE_CREATION_TIME:
+        case Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME:
+        case Subpacket::Tag2::EXPORTABLE_CERTIFICATION:
+        case Subpacket::Tag2::TRUST_SIGNATURE:
+        case Subpacket::Tag2::REGULAR_EXPRESSION:
+        case Subpacket::Tag2::REVOCABLE:
+        case Subpacket::Tag2::KEY_EXPIRATION_TIME:
+        case Subpacket::Tag2::PLACEHOLDER_FOR_BACKWARD_COMPATIBILITY:
+        case Subpacket::Tag2::PREFERRED_SYMMETRIC_ALGORITHMS:
+        case Subpacket::Tag2::REVOCATION_KEY:
+        case Subpacket::Tag2::ISSUER:
+        case Subpacket::Tag2::NOTATION_DATA:
+        case Subpacket::Tag2::PREFERRED_HASH_ALGORITHMS:
+        case Subpacket::Tag2::PREFERRED_COMPRESSION_ALGORITHMS:
+        case Subpacket::Tag2::KEY_SERVER_PREFERENCES:
+        case Subpacket::Tag2::PREFERRED_KEY_SERVER:
+        case Subpacket::Tag2::PRIMARY_USER_ID:
+        case Subpacket::Tag2::POLICY_URI:
+        case Subpacket::Tag2::KEY_FLAGS:
+        case Subpacket::Tag2::SIGNERS_USER_ID:
+        case Subpacket::Tag2::REASON_FOR_REVOCATION:
+        case Subpacket::Tag2::FEATURES:
+        case Subpacket::Tag2::SIGNATURE_TARGET:
+        case Subpacket::Tag2::EMBEDDED_SIGNATURE:
+        #ifdef GPG_COMPATIBLE
+        case Subpacket::Tag2::ISSUER_FINGERPRINT:
+        #endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+// copies the subpackets in [start, start + length) of data and records where each one is
+void Tag2::index_subpackets(const std::string & data, const std::string::size_type start, const std::string::size_type length, Tag2::Subpacket_Area & area) {
+    area.raw.assign(data, start, length);
+    area.index.clear();
+    area.decoded = false;
+    area.modified = false;
+    area.subpackets.clear();
+
     std::string::size_type pos = 0;
+    while (pos < area.raw.size()) {
+        // read subpacket header
+        std::string::size_type sub_length;
+        Subpacket::Sub::read_subpacket(area.raw, pos, sub_length);  // pos moved past header to [length + data]
 
-    while (pos < data.size()) {
-        // read subpacket data out
-        std::string::size_type length;
-        Subpacket::Sub::read_subpacket(data, pos, length);  // pos moved past header to [length + data]
+        if (!sub_length || (pos + sub_length > area.raw.size())) {
+            throw std::runtime_error("Error: Tag 2 Subpacket does not fit in subpacket data.");
+        }
 
         // first octet of data is subpacket type
         // ignore critical bit until later
-        Subpacket::Tag2::Sub::Ptr subpacket = nullptr;
-        switch (const uint8_t type = data[pos] & 0x7f) {
-            case Subpacket::Tag2::SIGNATURE_CREATION_TIME:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub2> ();
-                break;
-            case Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub3> ();
-                break;
-            case Subpacket::Tag2::EXPORTABLE_CERTIFICATION:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub4> ();
-                break;
-            case Subpacket::Tag2::TRUST_SIGNATURE:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub5> ();
-                break;
-            case Subpacket::Tag2::REGULAR_EXPRESSION:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub6> ();
-                break;
-            case Subpacket::Tag2::REVOCABLE:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub7> ();
-                break;
-            case Subpacket::Tag2::KEY_EXPIRATION_TIME:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub9> ();
-                break;
-            case Subpacket::Tag2::PLACEHOLDER_FOR_BACKWARD_COMPATIBILITY:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub10> ();
-                break;
-            case Subpacket::Tag2::PREFERRED_SYMMETRIC_ALGORITHMS:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub11> ();
-                break;
-            case Subpacket::Tag2::REVOCATION_KEY:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub12> ();
-                break;
-            case Subpacket::Tag2::ISSUER:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub16> ();
-                break;
-            case Subpacket::Tag2::NOTATION_DATA:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub20> ();
-                break;
-            case Subpacket::Tag2::PREFERRED_HASH_ALGORITHMS:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub21> ();
-                break;
-            case Subpacket::Tag2::PREFERRED_COMPRESSION_ALGORITHMS:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub22> ();
-                break;
-            case Subpacket::Tag2::KEY_SERVER_PREFERENCES:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub23> ();
-                break;
-            case Subpacket::Tag2::PREFERRED_KEY_SERVER:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub24> ();
-                break;
-            case Subpacket::Tag2::PRIMARY_USER_ID:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub25> ();
-                break;
-            case Subpacket::Tag2::POLICY_URI:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub26> ();
-                break;
-            case Subpacket::Tag2::KEY_FLAGS:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub27> ();
-                break;
-            case Subpacket::Tag2::SIGNERS_USER_ID:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub28> ();
-                break;
-            case Subpacket::Tag2::REASON_FOR_REVOCATION:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub29> ();
-                break;
-            case Subpacket::Tag2::FEATURES:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub30> ();
-                break;
-            case Subpacket::Tag2::SIGNATURE_TARGET:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub31> ();
-                break;
-            case Subpacket::Tag2::EMBEDDED_SIGNATURE:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub32> ();
-                break;
-            #ifdef GPG_COMPATIBLE
-            case Subpacket::Tag2::ISSUER_FINGERPRINT:
-                subpacket = std::make_shared <Subpacket::Tag2::Sub33> ();
-                break;
-            #endif
-            default:
-                throw std::runtime_error("Error: Tag 2 Subpacket tag not defined or reserved: " + std::to_string(type));
+        const uint8_t type = area.raw[pos] & 0x7f;
+        if (!defined_subpacket(type)) {
+            throw std::runtime_error("Error: Tag 2 Subpacket tag not defined or reserved: " + std::to_string(type));
         }
 
-        // subpacket guaranteed to be defined
-        subpacket -> read(data.substr(pos + 1, length - 1));
-        subpacket -> set_critical(data[pos] & 0x80);
-        subpackets.push_back(subpacket);
+        area.index.push_back({type, pos, sub_length});
 
         // go to end of current subpacket
-        pos += length;
+        pos += sub_length;
+    }
+}
+
+Subpacket::Tag2::Sub::Ptr Tag2::read_subpacket(const std::string & raw, const Tag2::Subpacket_Location & location) {
+    Subpacket::Tag2::Sub::Ptr subpacket = nullptr;
+    switch (location.type) {
+        case Subpacket::Tag2::SIGNATURE_CREATION_TIME:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub2> ();
+            break;
+        case Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub3> ();
+            break;
+        case Subpacket::Tag2::EXPORTABLE_CERTIFICATION:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub4> ();
+            break;
+        case Subpacket::Tag2::TRUST_SIGNATURE:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub5> ();
+            break;
+        case Subpacket::Tag2::REGULAR_EXPRESSION:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub6> ();
+            break;
+        case Subpacket::Tag2::REVOCABLE:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub7> ();
+            break;
+        case Subpacket::Tag2::KEY_EXPIRATION_TIME:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub9> ();
+            break;
+        case Subpacket::Tag2::PLACEHOLDER_FOR_BACKWARD_COMPATIBILITY:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub10> ();
+            break;
+        case Subpacket::Tag2::PREFERRED_SYMMETRIC_ALGORITHMS:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub11> ();
+            break;
+        case Subpacket::Tag2::REVOCATION_KEY:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub12> ();
+            break;
+        case Subpacket::Tag2::ISSUER:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub16> ();
+            break;
+        case Subpacket::Tag2::NOTATION_DATA:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub20> ();
+            break;
+        case Subpacket::Tag2::PREFERRED_HASH_ALGORITHMS:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub21> ();
+            break;
+        case Subpacket::Tag2::PREFERRED_COMPRESSION_ALGORITHMS:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub22> ();
+            break;
+        case Subpacket::Tag2::KEY_SERVER_PREFERENCES:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub23> ();
+            break;
+        case Subpacket::Tag2::PREFERRED_KEY_SERVER:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub24> ();
+            break;
+        case Subpacket::Tag2::PRIMARY_USER_ID:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub25> ();
+            break;
+        case Subpacket::Tag2::POLICY_URI:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub26> ();
+            break;
+        case Subpacket::Tag2::KEY_FLAGS:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub27> ();
+            break;
+        case Subpacket::Tag2::SIGNERS_USER_ID:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub28> ();
+            break;
+        case Subpacket::Tag2::REASON_FOR_REVOCATION:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub29> ();
+            break;
+        case Subpacket::Tag2::FEATURES:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub30> ();
+            break;
+        case Subpacket::Tag2::SIGNATURE_TARGET:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub31> ();
+            break;
+        case Subpacket::Tag2::EMBEDDED_SIGNATURE:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub32> ();
+            break;
+        #ifdef GPG_COMPATIBLE
+        case Subpacket::Tag2::ISSUER_FINGERPRINT:
+            subpacket = make_shared_in_arena <Subpacket::Tag2::Sub33> ();
+            break;
+        #endif
+        default:
+            throw std::runtime_error("Error: Tag 2 Subpacket tag not defined or reserved: " + std::to_string(location.type));
     }
+
+
+    // subpacket guaranteed to be defined
+    subpacket -> read(raw.substr(location.pos + 1, location.length - 1));
+    subpacket -> set_critical(raw[location.pos] & 0x80);
+    return subpacket;
+}
+
+const Tag2::Subpackets & Tag2::decode_subpackets(Tag2::Subpacket_Area & area) {
+    if (!area.decoded) {
+        area.subpackets.clear();
+        area.subpackets.reserve(area.index.size());
+        for(Subpacket_Location const & location : area.index) {
+            area.subpackets.push_back(read_subpacket(area.raw, location));
+        }
+        area.decoded = true;
+    }
+    return area.subpackets;
+}
+
+Tag2::Subpackets & Tag2::modify_subpackets(Tag2::Subpacket_Area & area) {
+    decode_subpackets(area);
+    area.raw.clear();
+    area.index.clear();
+    area.modified = true;
+    return area.subpackets;
+}
+
+Tag2::Subpackets Tag2::clone_subpackets(const Tag2::Subpackets & subpackets) {
+    Subpackets out;
+    out.reserve(subpackets.size());
+    for(Subpacket::Tag2::Sub::Ptr const & s : subpackets) {
+        out.push_back(s -> clone());
+    }
+    return out;
+}
+
+// checks parsed subpackets in place and parses the rest into temporaries,
+// so checking does not change the area
+Status Tag2::valid_subpackets(const Tag2::Subpacket_Area & area) {
+    if (area.decoded) {
+        for(Subpacket::Tag2::Sub::Ptr const & sub : area.subpackets) {
+            const Status err = sub -> valid();
+            if (err != Status::SUCCESS) {
+                return err;
+            }
+        }
+        return Status::SUCCESS;
+    }
+
+    for(Subpacket_Location const & location : area.index) {
+        Subpacket::Tag2::Sub::Ptr sub;
+        try {
+            sub = read_subpacket(area.raw, location);
+        }
+        catch (const std::exception &) {
+            return Status::INVALID_CONTENTS;
+        }
+
+        const Status err = sub -> valid();
+        if (err != Status::SUCCESS) {
+            return err;
+        }
+    }
+    return Status::SUCCESS;
+}
+
+std::string Tag2::write_subpackets(const Tag2::Subpacket_Area & area) {
+    if (!area.modified) {
+        return area.raw;
+    }
+
+    std::string out;
+    for(Subpacket::Tag2::Sub::Ptr const & s : area.subpackets) {
+        out += s -> write();
+    }
+    return out;
+}
+
+bool Tag2::find_contents(const Tag2::Subpacket_Area & area, const uint8_t type, const bool last, std::string & contents) {
+    bool found = false;
+    if (!area.modified) {
+        for(Subpacket_Location const & location : area.index) {
+            if (location.type == type) {
+                contents.assign(area.raw, location.pos + 1, location.length - 1);
+                found = true;
+                if (!last) {
+                    break;
+                }
+            }
+        }
+    }
+    else {
+        for(Subpacket::Tag2::Sub::Ptr const & s : area.subpackets) {
+            if (s -> get_type() == type) {
+                contents = s -> raw();
+                found = true;
+                if (!last) {
+                    break;
+                }
+            }
+        }
+    }
+    return found;
 }
 
 void Tag2::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type &) {
@@ -117,13 +299,13 @@ void Tag2::actual_read(const std::string & data, std::string::size_type & pos, c
             throw std::runtime_error("Error: Length of hashed material must be 5.");
         }
         set_type  (data[pos + 2]);
-        set_time  (toint(data.substr(pos + 3, 4), 256));
+        set_time  (toint(data, pos + 3, 4));
         set_keyid (data.substr(pos + 7, 8));
         set_pka   (data[pos + 15]);
         set_hash  (data[pos + 16]);
-        set_left16(data.substr(pos + 17, 2));
+        left16.assign(data, pos + 17, 2);
 
-        pos = 19;
+        pos += 19;
         if (PKA::is_RSA(pka)) {
             mpi.push_back(read_MPI(data, pos)); // RSA m**d mod n
         }
@@ -149,19 +331,19 @@ void Tag2::actual_read(const std::string & data, std::string::size_type & pos, c
         pos += 4;
 
         // hashed subpackets
-        const uint16_t hashed_size = toint(data.substr(pos, 2), 256);
+        const uint16_t hashed_size = toint(data, pos, 2);
         pos += 2;
-        read_subpackets(data.substr(pos, hashed_size), hashed_subpackets);
+        index_subpackets(data, pos, hashed_size, hashed_area);
         pos += hashed_size;
 
         // unhashed subpacketss
-        const uint16_t unhashed_size = toint(data.substr(pos, 2), 256);
+        const uint16_t unhashed_size = toint(data, pos, 2);
         pos += 2;
-        read_subpackets(data.substr(pos, unhashed_size), unhashed_subpackets);
+        index_subpackets(data, pos, unhashed_size, unhashed_area);
         pos += unhashed_size;
 
         // get left 16 bits
-        set_left16(data.substr(pos, 2));
+        left16.assign(data, pos, 2);
         pos += 2;
 
         // if (PKA::is_RSA(PKA))
@@ -200,6 +382,7 @@ void Tag2::show_contents(HumanReadable & hr) const {
            << "Public Key Algorithm: " + get_mapped(PKA::NAME, pka) + " (pka " + std::to_string(pka) + ")"
            << "Hash Algorithm: " + get_mapped(Hash::NAME, hash) + " (hash " + std::to_string(hash) + ")";
 
+        const Subpackets & hashed_subpackets = decode_subpackets(hashed_area);
         if (hashed_subpackets.size()) {
             uint32_t create_time = 0;
 
@@ -220,6 +403,7 @@ void Tag2::show_contents(HumanReadable & hr) const {
             hr << HumanReadable::UP;
         }
 
+        const Subpackets & unhashed_subpackets = decode_subpackets(unhashed_area);
         if (unhashed_subpackets.size()) {
             uint32_t create_time = 0;
 
@@ -268,18 +452,12 @@ std::string Tag2::actual_raw() const {
         out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
     }
     if (version == 4) {
-        std::string hashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-            hashed_str += s -> write();
-        }
-        std::string unhashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets) {
-            unhashed_str += s -> write();
-        }
+        const std::string hashed_str = write_subpackets(hashed_area);
+        const std::string unhashed_str = write_subpackets(unhashed_area);
         out += std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed_str.size(), 4)) + hashed_str + unhexlify(makehex(unhashed_str.size(), 4)) + unhashed_str + left16;
     }
     for(MPI const & i : mpi) {
-        out += write_MPI(i);
+        write_MPI(i, out);
     }
     return out;
 }
@@ -306,15 +484,8 @@ Status Tag2::actual_valid(const bool check_mpi) const {
     }
 
     if (version == 4) {
-        for(Subpacket::Tag2::Sub::Ptr const & sub : hashed_subpackets) {
-            const Status err = sub -> valid();
-            if (err != Status::SUCCESS) {
-                return err;
-            }
-        }
-
-        for(Subpacket::Tag2::Sub::Ptr const & sub : unhashed_subpackets) {
-            const Status err = sub -> valid();
+        for(Subpacket_Area const * area : {&hashed_area, &unhashed_area}) {
+            const Status err = valid_subpackets(*area);
             if (err != Status::SUCCESS) {
                 return err;
             }
@@ -362,8 +533,8 @@ Tag2::Tag2()
       left16(),
       time(0),
       keyid(),
-      hashed_subpackets(),
-      unhashed_subpackets()
+      hashed_area(),
+      unhashed_area()
 {}
 
 Tag2::Tag2(const Tag2 & copy)
@@ -375,8 +546,8 @@ Tag2::Tag2(const Tag2 & copy)
       left16(copy.left16),
       time(copy.time),
       keyid(copy.keyid),
-      hashed_subpackets(copy.get_hashed_subpackets_clone()),
-      unhashed_subpackets(copy.get_unhashed_subpackets_clone())
+      hashed_area(copy.hashed_area),
+      unhashed_area(copy.unhashed_area)
 {}
 
 Tag2::Tag2(const std::string & data)
@@ -386,8 +557,8 @@ Tag2::Tag2(const std::string & data)
 }
 
 Tag2::~Tag2() {
-    hashed_subpackets.clear();
-    unhashed_subpackets.clear();
+    hashed_area.subpackets.clear();
+    unhashed_area.subpackets.clear();
 }
 
 uint8_t Tag2::get_type() const {
@@ -416,29 +587,24 @@ std::array <uint32_t, 3> Tag2::get_times() const {
         times[0] = time;
     }
     else if (version == 4) {
-        // usually found in hashed subpackets
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-            // 5.2.3.4. Signature Creation Time
-            //    ...
-            //    MUST be present in the hashed area.
-            if (s -> get_type() == Subpacket::Tag2::SIGNATURE_CREATION_TIME) {
-                times[0] = std::static_pointer_cast <Subpacket::Tag2::Sub2> (s) -> get_time();
+        // 5.2.3.4. Signature Creation Time
+        //    ...
+        //    MUST be present in the hashed area.
+        //
+        // expiration times are usually found in hashed subpackets;
+        // the last one found wins
+        std::string contents;
+        if (find_contents(hashed_area, Subpacket::Tag2::SIGNATURE_CREATION_TIME, true, contents)) {
+            times[0] = toint(contents, 256);
+        }
+
+        for(Subpacket_Area const * area : {&hashed_area, &unhashed_area}) {
+            if (find_contents(*area, Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME, true, contents)) {
+                times[1] = toint(contents, 256);
             }
-            else if (s -> get_type() == Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME) {
-                times[1] = std::static_pointer_cast <Subpacket::Tag2::Sub3> (s) -> get_dt();
-            }
-            else if (s -> get_type() == Subpacket::Tag2::KEY_EXPIRATION_TIME) {
-                times[2] = std::static_pointer_cast <Subpacket::Tag2::Sub9> (s) -> get_dt();
-            }
-        }
 
-        // search unhashed subpackets
-        for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets) {
-            if (s -> get_type() == Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME) {
-                times[1] = std::static_pointer_cast <Subpacket::Tag2::Sub3> (s) -> get_dt();
-            }
-            else if (s -> get_type() == Subpacket::Tag2::KEY_EXPIRATION_TIME) {
-                times[2] = std::static_pointer_cast <Subpacket::Tag2::Sub9> (s) -> get_dt();
+            if (find_contents(*area, Subpacket::Tag2::KEY_EXPIRATION_TIME, true, contents)) {
+                times[2] = toint(contents, 256);
             }
         }
 
@@ -467,17 +633,14 @@ std::string Tag2::get_keyid() const {
     }
     else if (version == 4) {
         // usually found in unhashed subpackets
-        for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets) {
-            if (s -> get_type() == Subpacket::Tag2::ISSUER) {
-                return std::static_pointer_cast <Subpacket::Tag2::Sub16> (s) -> get_keyid();
-            }
+        std::string issuer;
+        if (find_contents(unhashed_area, Subpacket::Tag2::ISSUER, false, issuer)) {
+            return issuer;
         }
 
         // search hashed subpackets if necessary
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-            if (s -> get_type() == Subpacket::Tag2::ISSUER) {
-                return std::static_pointer_cast <Subpacket::Tag2::Sub16> (s) -> get_keyid();
-            }
+        if (find_contents(hashed_area, Subpacket::Tag2::ISSUER, false, issuer)) {
+            return issuer;
         }
     }
     else{
@@ -488,27 +651,19 @@ std::string Tag2::get_keyid() const {
 }
 
 Tag2::Subpackets Tag2::get_hashed_subpackets() const {
-    return hashed_subpackets;
+    return clone_subpackets(decode_subpackets(hashed_area));
 }
 
 Tag2::Subpackets Tag2::get_hashed_subpackets_clone() const {
-    Subpackets out;
-    for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-        out.push_back(s -> clone());
-    }
-    return out;
+    return get_hashed_subpackets();
 }
 
 Tag2::Subpackets Tag2::get_unhashed_subpackets() const {
-    return unhashed_subpackets;
+    return clone_subpackets(decode_subpackets(unhashed_area));
 }
 
 Tag2::Subpackets Tag2::get_unhashed_subpackets_clone() const {
-    Subpackets out;
-    for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets) {
-        out.push_back(s -> clone());
-    }
-    return out;
+    return get_unhashed_subpackets();
 }
 
 std::string Tag2::get_up_to_hashed() const {
@@ -516,10 +671,7 @@ std::string Tag2::get_up_to_hashed() const {
         return "\x03" + std::string(1, type) + unhexlify(makehex(time, 8));
     }
     else if (version == 4) {
-        std::string hashed = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-            hashed += s -> write();
-        }
+        const std::string hashed = write_subpackets(hashed_area);
         return "\x04" + std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed.size(), 4)) + hashed;
     }
     else{
@@ -534,43 +686,47 @@ std::string Tag2::get_without_unhashed() const {
         out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
     }
     if (version == 4) {
-        std::string hashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-            hashed_str += s -> write();
-        }
+        const std::string hashed_str = write_subpackets(hashed_area);
         out += std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed_str.size(), 4)) + hashed_str + zero + zero + left16;
     }
     for(MPI const & i : mpi) {
-        out += write_MPI(i);
+        write_MPI(i, out);
     }
     return out;
 }
 
 void Tag2::set_type(const uint8_t t) {
+    modified();
     type = t;
 }
 
 void Tag2::set_pka(const uint8_t p) {
+    modified();
     pka = p;
 }
 
 void Tag2::set_hash(const uint8_t h) {
+    modified();
     hash = h;
 }
 
 void Tag2::set_left16(const std::string & l) {
+    modified();
     left16 = l;
 }
 
 void Tag2::set_mpi(const PKA::Values & m) {
+    modified();
     mpi = m;
 }
 
 void Tag2::set_time(const uint32_t t) {
+    modified();
     if (version == 3) {
         time = t;
     }
     else if (version == 4) {
+        Subpackets & hashed_subpackets = modify_subpackets(hashed_area);
         unsigned int i;
         for(i = 0; i < hashed_subpackets.size(); i++) {
             if (hashed_subpackets[i] -> get_type() == 2) {
@@ -589,6 +745,7 @@ void Tag2::set_time(const uint32_t t) {
 }
 
 void Tag2::set_keyid(const std::string & k) {
+    modified();
     if (k.size() != 8) {
         throw std::runtime_error("Error: Key ID must be 8 octets.");
     }
@@ -597,6 +754,7 @@ void Tag2::set_keyid(const std::string & k) {
         keyid = k;
     }
     else if (version == 4) {
+        Subpackets & unhashed_subpackets = modify_subpackets(unhashed_area);
         unsigned int i;
         for(i = 0; i < unhashed_subpackets.size(); i++) {
             if (unhashed_subpackets[i] -> get_type() == 16) {
@@ -615,6 +773,8 @@ void Tag2::set_keyid(const std::string & k) {
 }
 
 void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h) {
+    modified();
+    Subpackets & hashed_subpackets = modify_subpackets(hashed_area);
     hashed_subpackets.clear();
     for(Subpacket::Tag2::Sub::Ptr const & s : h) {
         hashed_subpackets.push_back(s -> clone());
@@ -622,6 +782,8 @@ void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h) {
 }
 
 void Tag2::set_unhashed_subpackets(const Tag2::Subpackets & u) {
+    modified();
+    Subpackets & unhashed_subpackets = modify_subpackets(unhashed_area);
     unhashed_subpackets.clear();
     for(Subpacket::Tag2::Sub::Ptr const & s : u) {
         unhashed_subpackets.push_back(s -> clone());
@@ -639,27 +801,14 @@ std::string Tag2::find_subpacket(const uint8_t sub) const {
     //   more sense.
 
     std::string out;
-    for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets) {
-        if (s -> get_type() == sub) {
-            out = s -> raw();
-            break;
-        }
-    }
-    for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets) {
-        if (s -> get_type() == sub) {
-            out = s -> raw();
-            break;
-        }
-    }
+    find_contents(hashed_area, sub, false, out);
+    find_contents(unhashed_area, sub, false, out);
     return out;
 }
 
 
 Tag::Ptr Tag2::clone() const {
-    Ptr out = std::make_shared <Tag2> (*this);
-    out -> hashed_subpackets = get_hashed_subpackets_clone();
-    out -> unhashed_subpackets = get_unhashed_subpackets_clone();
-    return out;
+    return std::make_shared <Tag2> (*this);
 }
 
 Tag2 & Tag2::operator=(const Tag2 & tag2) {
@@ -671,8 +820,8 @@ Tag2 & Tag2::operator=(const Tag2 & tag2) {
     left16 = tag2.left16;
     time = tag2.time;
     keyid = tag2.keyid;
-    hashed_subpackets = tag2.get_hashed_subpackets_clone();
-    unhashed_subpackets = tag2.get_unhashed_subpackets_clone();
+    hashed_area = tag2.hashed_area;
+    unhashed_area = tag2.unhashed_area;
     return *this;
 }
 
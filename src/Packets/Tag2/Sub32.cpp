@@ -1,11 +1,13 @@
 #include "Packets/Tag2/Sub32.h"
 
+#include "common/Arena.h"
+
 namespace OpenPGP {
 namespace Subpacket {
 namespace Tag2 {
 
 void Sub32::actual_read(const std::string & data) {
-    set_embedded(std::make_shared <Packet::Tag2> (data), true);
+    set_embedded(make_shared_in_arena <Packet::Tag2> (data), true);
 }
 
 void Sub32::show_contents(HumanReadable & hr) const {
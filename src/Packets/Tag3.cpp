@@ -122,10 +122,12 @@ std::string Tag3::get_session_key(const std::string & pass) const {
 }
 
 void Tag3::set_sym(const uint8_t s) {
+    modified();
     sym = s;
 }
 
 void Tag3::set_s2k(const S2K::S2K::Ptr & s) {
+    modified();
     if (!s) {
         throw std::runtime_error("Error: No S2K provided.\n");
     }
@@ -139,16 +141,19 @@ void Tag3::set_s2k(const S2K::S2K::Ptr & s) {
 }
 
 void Tag3::set_esk(std::string * s) {
+    modified();
     if (s) {
         set_esk(*s);
     }
 }
 
 void Tag3::set_esk(const std::string & s) {
+    modified();
     esk = std::make_shared <std::string> (s);
 }
 
 void Tag3::set_session_key(const std::string & pass, const std::string & sk) {
+    modified();
     //sk should be [1 octet symmetric key algorithm] + [session key(s)]
     esk.reset();
     if (s2k && (sk.size() > 1)) {
@@ -84,18 +84,22 @@ uint8_t Tag4::get_last() const {
 }
 
 void Tag4::set_type(const uint8_t t) {
+    modified();
     type = t;
 }
 
 void Tag4::set_hash(const uint8_t h) {
+    modified();
     hash = h;
 }
 
 void Tag4::set_pka(const uint8_t p) {
+    modified();
     pka = p;
 }
 
 void Tag4::set_keyid(const std::string & k) {
+    modified();
     if (k.size() != 8) {
         throw std::runtime_error("Error: Key ID must be 8 octets.");
     }
@@ -103,6 +107,7 @@ void Tag4::set_keyid(const std::string & k) {
 }
 
 void Tag4::set_last(const uint8_t n) {
+    modified();
     last = n;
 }
 
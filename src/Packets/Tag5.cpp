@@ -51,7 +51,7 @@ void Tag5::actual_read(const std::string & data, std::string::size_type & pos, c
     }
 
     // plaintex or encrypted data
-    secret = data.substr(pos, length - (pos - orig_pos));
+    secret.assign(data, pos, length - (pos - orig_pos));
 
     pos = orig_pos + length;
 }
@@ -132,7 +132,7 @@ void Tag5::show_private(HumanReadable & hr) const {
             const MPI x = read_MPI(secret, pos);
             hr << "ECDSA x: (" + std::to_string(bitsize(x)) + ") bits: " + mpitohex(x);
         }
-        else if (pka == PKA::ID::DSA) {
+        else if (pka == PKA::ID::EdDSA) {
             const MPI x = read_MPI(secret, pos);
             hr << "EdDSA x: (" + std::to_string(bitsize(x)) + ") bits: " + mpitohex(x);
         }
@@ -279,6 +279,7 @@ Tag6::Ptr Tag5::get_public_ptr() const {
 }
 
 void Tag5::set_s2k_con(const uint8_t c) {
+    modified();
     s2k_con = c;
     size = raw_common().size() + 1;
     if (s2k) {
@@ -291,6 +292,7 @@ void Tag5::set_s2k_con(const uint8_t c) {
 }
 
 void Tag5::set_sym(const uint8_t s) {
+    modified();
     sym = s;
     size = raw_common().size() + 1;
     if (s2k) {
@@ -303,6 +305,7 @@ void Tag5::set_sym(const uint8_t s) {
 }
 
 void Tag5::set_s2k(const S2K::S2K::Ptr & s) {
+    modified();
     if (s -> get_type() == S2K::ID::SIMPLE_S2K) {
         s2k = std::make_shared <S2K::S2K0> ();
     }
@@ -324,6 +327,7 @@ void Tag5::set_s2k(const S2K::S2K::Ptr & s) {
 }
 
 void Tag5::set_IV(const std::string & iv) {
+    modified();
     IV = iv;
     size = raw_common().size() + 1;
     if (s2k) {
@@ -336,6 +340,7 @@ void Tag5::set_IV(const std::string & iv) {
 }
 
 void Tag5::set_secret(const std::string & s) {
+    modified();
     secret = s;
     size = raw_common().size() + 1;
     if (s2k) {
@@ -368,11 +373,12 @@ std::string Tag5::calculate_key(const std::string & passphrase) const {
 }
 
 const std::string & Tag5::encrypt_secret_keys(const std::string & passphrase, const PKA::Values & keys) {
+    modified();
     secret = "";
 
     // convert keys into string
     for(MPI const & mpi : keys) {
-        secret += write_MPI(mpi);
+        write_MPI(mpi, secret);
     }
 
     // calculate checksum
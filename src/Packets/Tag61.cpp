@@ -4,7 +4,7 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag61::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_stream(data.substr(pos, length));
+    stream.assign(data, pos, length);
     pos += length;
 }
 
@@ -36,6 +36,7 @@ std::string Tag61::get_stream() const {
 }
 
 void Tag61::set_stream(const std::string & data) {
+    modified();
     stream = data;
 }
 
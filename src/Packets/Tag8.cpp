@@ -17,7 +17,7 @@ std::string Tag8::decompress(const std::string & data) const {
 void Tag8::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
     if (length) {
         comp = data[pos + 0]; // don't call set_comp here to prevent decompressing and recompressing old data
-        set_compressed_data(data.substr(pos + 1, length - 1));
+        compressed_data.assign(data, pos + 1, length - 1);
         pos += length;
     }
 }
@@ -44,6 +44,20 @@ std::string Tag8::actual_raw() const {
     return std::string(1, comp) + compressed_data;
 }
 
+// compressed data can be large; a cached copy would double it
+bool Tag8::keep_raw() const {
+    return false;
+}
+
+std::size_t Tag8::raw_size() const {
+    return 1 + compressed_data.size();
+}
+
+void Tag8::append_raw(std::string & out) const {
+    out += static_cast <char> (comp);
+    out += compressed_data;
+}
+
 std::string Tag8::actual_write() const {
     return Partial::write(header_format, tag, raw());
 }
@@ -96,6 +110,7 @@ std::string Tag8::get_compressed_data() const {
 }
 
 void Tag8::set_comp(const uint8_t alg) {
+    modified();
     // recompress data
     const std::string data = get_data();// decompress data
     comp = alg;                         // set new compression algorithm
@@ -103,15 +118,18 @@ void Tag8::set_comp(const uint8_t alg) {
 }
 
 void Tag8::set_data(const std::string & data) {
+    modified();
     compressed_data = compress(data);
 }
 
 void Tag8::set_body(const Message & msg) {
+    modified();
     // set the decompressed data to the raw packets of the message
     set_data(msg.raw());
 }
 
 void Tag8::set_compressed_data(const std::string & data) {
+    modified();
     compressed_data = data;
 }
 
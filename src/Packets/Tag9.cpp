@@ -4,7 +4,7 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag9::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
-    set_encrypted_data(data.substr(pos, length));
+    encrypted_data.assign(data, pos, length);
     pos += length;
 }
 
@@ -20,6 +20,19 @@ std::string Tag9::actual_raw() const {
     return encrypted_data;
 }
 
+// raw() is mostly the encrypted data, which is not worth copying
+bool Tag9::keep_raw() const {
+    return false;
+}
+
+std::size_t Tag9::raw_size() const {
+    return encrypted_data.size();
+}
+
+void Tag9::append_raw(std::string & out) const {
+    out += encrypted_data;
+}
+
 std::string Tag9::actual_write() const {
     return Partial::write(header_format, tag, raw());
 }
@@ -57,6 +70,7 @@ std::string Tag9::get_encrypted_data() const {
 }
 
 void Tag9::set_encrypted_data(const std::string & e) {
+    modified();
     encrypted_data = e;
 }
 
@@ -0,0 +1,108 @@
+#include "PreparedKey.h"
+
+#include <stdexcept>
+
+#include "Misc/PKCS1.h"
+
+namespace OpenPGP {
+
+PreparedKey::PreparedKey(const Packet::Key::Ptr & key)
+    : key(key),
+      mpi(),
+      modulus_length(0),
+      keyid(),
+      fingerprint(),
+      emsa(),
+      dsa_g(nullptr),
+      dsa_y(nullptr),
+      elgamal_g(nullptr),
+      elgamal_y(nullptr)
+{
+    if (!key) {
+        throw std::runtime_error("Error: No key to prepare.");
+    }
+
+    mpi = key -> get_mpi();
+    keyid = key -> get_keyid();
+    fingerprint = key -> get_fingerprint();
+
+    const uint8_t pka = key -> get_pka();
+    if (PKA::is_RSA(pka) && (mpi.size() > 1)) {
+        modulus_length = bytesize(mpi[0]);
+
+        // only encodings that fit in the modulus
+        for(std::pair <const uint8_t, std::string> const & der : Hash::ASN1_DER) {
+            if (modulus_length >= (der.second.size() >> 1) + (Hash::LENGTH.at(der.first) >> 3) + 11) {
+                emsa[der.first] = EMSA_PKCS1_v1_5_prefix(der.first, modulus_length);
+            }
+        }
+    }
+    else if ((pka == PKA::ID::DSA) && (mpi.size() > 3)) {
+        dsa_g = PKA::DSA::domain_table(mpi[0], mpi[2]);
+        if (dsa_g) {
+            dsa_y = std::make_shared <WindowTable> (mpi[3], dsa_g -> get_ctx(), window_size(bitsize(mpi[1])));
+        }
+    }
+    else if ((pka == PKA::ID::ELGAMAL) && (mpi.size() > 2)) {
+        modulus_length = bytesize(mpi[0]);
+
+        if ((mpi[0] > 2) && mpz_odd_p(mpi[0].get_mpz_t())) {
+            const Montgomery ctx(mpi[0]);
+            elgamal_g = std::make_shared <CombTable> (mpi[1], ctx, bitsize(mpi[0]));
+            elgamal_y = std::make_shared <CombTable> (mpi[2], ctx, bitsize(mpi[0]));
+        }
+    }
+}
+
+const Packet::Key::Ptr & PreparedKey::get_key() const {
+    return key;
+}
+
+uint8_t PreparedKey::get_pka() const {
+    return key -> get_pka();
+}
+
+const PKA::Values & PreparedKey::get_mpi() const {
+    return mpi;
+}
+
+std::size_t PreparedKey::get_modulus_length() const {
+    return modulus_length;
+}
+
+const std::string & PreparedKey::get_keyid() const {
+    return keyid;
+}
+
+const std::string & PreparedKey::get_fingerprint() const {
+    return fingerprint;
+}
+
+const std::string & PreparedKey::get_emsa_prefix(const uint8_t hash) const {
+    static const std::string none;
+
+    std::map <uint8_t, std::string>::const_iterator it = emsa.find(hash);
+    if (it == emsa.end()) {
+        return none;
+    }
+
+    return it -> second;
+}
+
+const std::shared_ptr <const WindowTable> & PreparedKey::get_dsa_g() const {
+    return dsa_g;
+}
+
+const std::shared_ptr <const WindowTable> & PreparedKey::get_dsa_y() const {
+    return dsa_y;
+}
+
+const std::shared_ptr <const CombTable> & PreparedKey::get_elgamal_g() const {
+    return elgamal_g;
+}
+
+const std::shared_ptr <const CombTable> & PreparedKey::get_elgamal_y() const {
+    return elgamal_y;
+}
+
+}
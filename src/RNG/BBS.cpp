@@ -1,5 +1,6 @@
 #include "RNG/BBS.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "common/cryptomath.h"
@@ -9,6 +10,8 @@
 namespace OpenPGP {
 namespace RNG {
 
+std::recursive_mutex BBS::mutex;
+
 bool BBS::seeded = false;
 
 MPI BBS::state = 0;
@@ -18,6 +21,7 @@ MPI BBS::m = 0;
 const MPI BBS::two = 2;
 
 void BBS::init(const MPI & seed, const unsigned int & bits, MPI p, MPI q) {
+    std::lock_guard <std::recursive_mutex> lock(mutex);
     if (!seeded) {
         /*
         p and q should be:
@@ -84,6 +88,7 @@ BBS::BBS(const MPI & SEED, const unsigned int & bits, MPI p, MPI q)
 }
 
 std::string BBS::rand_bits(const unsigned int & bits, const std::string & par) {
+    std::lock_guard <std::recursive_mutex> lock(mutex);
     BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
 
     // returns string because SIZE might be larger than 64 bits
@@ -99,5 +104,10 @@ std::string BBS::rand_bytes(const unsigned int & bytes, const std::string & par)
     return unbinify(rand_bits(bytes << 3, par));
 }
 
+void BBS::rand_bytes(void * buf, const std::size_t bytes) {
+    const std::string out = rand_bytes(bytes);
+    std::copy(out.begin(), out.end(), static_cast <char *> (buf));
+}
+
 }
 }
@@ -0,0 +1,191 @@
+#include "RNG/ChaCha20.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/random.h>
+#include <unistd.h>
+
+#include "common/includes.h"
+
+namespace OpenPGP {
+namespace RNG {
+
+const std::size_t ChaCha20::RESEED_INTERVAL;
+
+// blocks generated per refill; the first half block becomes the next key
+static const std::size_t BLOCKS = 16;
+static const std::size_t BUFFER = BLOCKS * 64;
+static const std::size_t KEY    = 32;
+
+struct State {
+    uint32_t key[8];
+    uint8_t buffer[BUFFER];
+    std::size_t used;           // octets of buffer already handed out
+    std::size_t generated;      // octets since the last reseed
+    pid_t pid;                  // process that last reseeded
+    bool seeded;
+};
+
+static thread_local State state = {};
+
+static inline uint32_t rotl(const uint32_t x, const unsigned int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+#define QUARTERROUND(a, b, c, d)                    \
+    a += b; d ^= a; d = rotl(d, 16);                \
+    c += d; b ^= c; b = rotl(b, 12);                \
+    a += b; d ^= a; d = rotl(d,  8);                \
+    c += d; b ^= c; b = rotl(b,  7);
+
+void ChaCha20::block(const uint32_t key[8], const uint32_t counter, uint8_t out[64]) {
+    const uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3],
+        key[4], key[5], key[6], key[7],
+        counter, 0, 0, 0,
+    };
+
+    uint32_t x[16];
+    std::memcpy(x, in, sizeof(x));
+
+    for(int i = 0; i < 10; i++) {
+        QUARTERROUND(x[0], x[4], x[ 8], x[12]);
+        QUARTERROUND(x[1], x[5], x[ 9], x[13]);
+        QUARTERROUND(x[2], x[6], x[10], x[14]);
+        QUARTERROUND(x[3], x[7], x[11], x[15]);
+        QUARTERROUND(x[0], x[5], x[10], x[15]);
+        QUARTERROUND(x[1], x[6], x[11], x[12]);
+        QUARTERROUND(x[2], x[7], x[ 8], x[13]);
+        QUARTERROUND(x[3], x[4], x[ 9], x[14]);
+    }
+
+    for(int i = 0; i < 16; i++) {
+        const uint32_t v = x[i] + in[i];
+        out[(i << 2)    ] = v;
+        out[(i << 2) + 1] = v >> 8;
+        out[(i << 2) + 2] = v >> 16;
+        out[(i << 2) + 3] = v >> 24;
+    }
+}
+
+#undef QUARTERROUND
+
+static void os_random(uint8_t * buf, std::size_t len) {
+    while (len) {
+        const ssize_t got = getrandom(buf, len, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        buf += got;
+        len -= got;
+    }
+
+    if (len) {
+        std::ifstream urandom("/dev/urandom", std::ios::binary);
+        if (!urandom.read(reinterpret_cast <char *> (buf), len)) {
+            throw std::runtime_error("Error: Could not get random octets from the operating system.");
+        }
+    }
+}
+
+// xor input into the key
+static void mix(const uint8_t * input, const std::size_t len) {
+    uint8_t * key = reinterpret_cast <uint8_t *> (state.key);
+    for(std::size_t i = 0; i < len; i++) {
+        key[i % KEY] ^= input[i];
+    }
+}
+
+static void refill() {
+    for(std::size_t i = 0; i < BLOCKS; i++) {
+        ChaCha20::block(state.key, i, state.buffer + (i << 6));
+    }
+
+    // replace the key and forget it
+    std::memcpy(state.key, state.buffer, KEY);
+    std::memset(state.buffer, 0, KEY);
+    state.used = KEY;
+}
+
+static void reseed() {
+    uint8_t fresh[KEY];
+    os_random(fresh, KEY);
+    mix(fresh, KEY);
+    std::memset(fresh, 0, KEY);
+
+    state.generated = 0;
+    state.pid = getpid();
+    state.seeded = true;
+    refill();
+}
+
+static void generate(uint8_t * out, std::size_t len) {
+    // a forked child must not repeat its parent's stream,
+    // including the octets still left in the buffer
+    if (!state.seeded                                       ||
+        (state.pid != getpid())                             ||
+        (state.generated >= ChaCha20::RESEED_INTERVAL)) {
+        reseed();
+    }
+
+    state.generated += len;
+
+    while (len) {
+        if (state.used == BUFFER) {
+            refill();
+        }
+
+        const std::size_t take = std::min(len, BUFFER - state.used);
+        std::memcpy(out, state.buffer + state.used, take);
+        std::memset(state.buffer + state.used, 0, take);
+        state.used += take;
+        out += take;
+        len -= take;
+    }
+}
+
+ChaCha20::ChaCha20(...)
+{}
+
+ChaCha20::ChaCha20(const std::string & seed)
+    : ChaCha20(seed.data(), seed.size())
+{}
+
+ChaCha20::ChaCha20(const void * buf, const std::size_t num) {
+    if (!state.seeded) {
+        reseed();
+    }
+
+    mix(static_cast <const uint8_t *> (buf), num);
+    refill();
+}
+
+std::string ChaCha20::rand_bits(const unsigned int & bits) {
+    return binify(rand_bytes((bits + 7) >> 3)).substr(0, bits);
+}
+
+std::string ChaCha20::rand_bytes(const unsigned int & bytes) {
+    std::string out(bytes, 0);
+    generate(reinterpret_cast <uint8_t *> (&out[0]), bytes);
+    return out;
+}
+
+void ChaCha20::rand_bytes(void * buf, const std::size_t bytes) {
+    generate(static_cast <uint8_t *> (buf), bytes);
+}
+
+std::size_t ChaCha20::get_generated() {
+    return state.generated;
+}
+
+}
+}
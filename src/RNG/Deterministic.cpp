@@ -0,0 +1,48 @@
+#include "RNG/Deterministic.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Hashes/Hashes.h"
+#include "RNG/ChaCha20.h"
+
+namespace OpenPGP {
+namespace RNG {
+
+Deterministic::Deterministic(const std::string & seed)
+    : mutex(),
+      key(),
+      counter(0),
+      block(),
+      used(sizeof(block))
+{
+    const std::string digest = Hash::use(Hash::ID::SHA256, seed);
+    for(std::size_t i = 0; i < 8; i++) {
+        key[i] = (static_cast <uint32_t> (static_cast <uint8_t> (digest[(i << 2)    ]))      ) |
+                 (static_cast <uint32_t> (static_cast <uint8_t> (digest[(i << 2) + 1])) <<  8) |
+                 (static_cast <uint32_t> (static_cast <uint8_t> (digest[(i << 2) + 2])) << 16) |
+                 (static_cast <uint32_t> (static_cast <uint8_t> (digest[(i << 2) + 3])) << 24);
+    }
+}
+
+void Deterministic::generate(void * buf, const std::size_t bytes) {
+    std::lock_guard <std::mutex> lock(mutex);
+
+    uint8_t * out = static_cast <uint8_t *> (buf);
+    std::size_t len = bytes;
+    while (len) {
+        if (used == sizeof(block)) {
+            ChaCha20::block(key, counter++, block);
+            used = 0;
+        }
+
+        const std::size_t take = std::min(len, sizeof(block) - used);
+        std::memcpy(out, block + used, take);
+        used += take;
+        out += take;
+        len -= take;
+    }
+}
+
+}
+}
@@ -0,0 +1,46 @@
+#include "RNG/Provider.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace OpenPGP {
+namespace RNG {
+
+static std::mutex mutex;                    // guards global
+static Provider::Ptr global = nullptr;
+static std::atomic <bool> installed(false); // skip the lock when nothing is installed
+static thread_local Provider::Ptr local = nullptr;
+
+Provider::~Provider() {}
+
+void set_provider(const Provider::Ptr & provider) {
+    std::lock_guard <std::mutex> lock(mutex);
+    global = provider;
+    installed.store((bool) provider, std::memory_order_release);
+}
+
+Provider::Ptr get_provider() {
+    if (local) {
+        return local;
+    }
+
+    if (!installed.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    std::lock_guard <std::mutex> lock(mutex);
+    return global;
+}
+
+ScopedProvider::ScopedProvider(const Provider::Ptr & provider)
+    : previous(local)
+{
+    local = provider;
+}
+
+ScopedProvider::~ScopedProvider() {
+    local = previous;
+}
+
+}
+}
@@ -55,5 +55,18 @@ std::string RAND_bytes::rand_bytes(const unsigned int & bytes, const std::size_t
     return ret;
 }
 
+void RAND_bytes::rand_bytes(void * buf, const std::size_t bytes, const std::size_t max_attempts) {
+    RAND_bytes();
+
+    std::size_t attempt = 0;
+    while ((attempt < max_attempts) && (::RAND_bytes(static_cast <unsigned char *> (buf), bytes) != 1)) {
+        attempt++;
+    }
+
+    if (attempt == max_attempts) {
+        throw std::runtime_error("Could not get " + std::to_string(bytes) + " random bytes after " + std::to_string(max_attempts) + " attempts");
+    }
+}
+
 }
 }
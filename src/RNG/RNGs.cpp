@@ -0,0 +1,75 @@
+#include "RNG/RNGs.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "common/includes.h"
+
+namespace OpenPGP {
+namespace RNG {
+
+RNG::RNG(...)
+{}
+
+std::string RNG::rand_bits(const unsigned int & bits) {
+    return binify(rand_bytes((bits + 7) >> 3)).substr(0, bits);
+}
+
+std::string RNG::rand_bytes(const unsigned int & bytes) {
+    std::string out(bytes, 0);
+    rand_bytes(&out[0], bytes);
+    return out;
+}
+
+void RNG::rand_bytes(void * buf, const std::size_t bytes) {
+    if (const Provider::Ptr provider = get_provider()) {
+        provider -> generate(buf, bytes);
+    }
+    else {
+        Default().rand_bytes(buf, bytes);
+    }
+}
+
+MPI random_mpi(const unsigned int bits, const uint8_t flags) {
+    MPI out = 0;
+    if (!bits) {
+        return out;
+    }
+
+    const std::size_t bytes = (bits + 7) >> 3;
+    std::vector <uint8_t> buf(bytes);
+    RNG().rand_bytes(buf.data(), bytes);
+
+    // clear the octet's bits above the requested size
+    buf[0] &= 0xff >> ((bytes << 3) - bits);
+
+    if (flags & TOP_BIT) {
+        buf[0] |= 1 << ((bits - 1) & 7);
+    }
+
+    if (flags & ODD) {
+        buf[bytes - 1] |= 1;
+    }
+
+    mpz_import(out.get_mpz_t(), bytes, 1, 1, 1, 0, buf.data());
+    std::fill(buf.begin(), buf.end(), 0);
+    return out;
+}
+
+MPI random_mpi(const MPI & modulus) {
+    if (modulus <= 1) {
+        return 0;
+    }
+
+    // rejection sampling: each draw is accepted with probability > 1/2
+    const unsigned int bits = bitsize(modulus - 1);
+    MPI out;
+    do {
+        out = random_mpi(bits);
+    } while (out >= modulus);
+
+    return out;
+}
+
+}
+}
@@ -1,5 +1,7 @@
 #include "RevocationCertificate.h"
 
+#include "common/MappedFile.h"
+
 namespace OpenPGP {
 
 RevocationCertificate::RevocationCertificate()
@@ -38,6 +40,10 @@ RevocationCertificate::RevocationCertificate(std::istream & stream)
     }
 }
 
+RevocationCertificate RevocationCertificate::from_file(const std::string & path) {
+    return read_mapped <RevocationCertificate> (path);
+}
+
 RevocationCertificate::~RevocationCertificate() {}
 
 uint8_t RevocationCertificate::get_revoke_type() const {
@@ -45,7 +51,7 @@ uint8_t RevocationCertificate::get_revoke_type() const {
         throw std::runtime_error("Error: Bad Revocation Certificate.");
     }
 
-    return std::static_pointer_cast <Packet::Tag2> (packets[0]) -> get_type();
+    return std::static_pointer_cast <Packet::Tag2> (get_packet(0)) -> get_type();
 }
 
 bool RevocationCertificate::meaningful(const PGP & pgp) {
@@ -54,17 +60,17 @@ bool RevocationCertificate::meaningful(const PGP & pgp) {
         return false;
     }
 
-    if (pgp.get_packets().size() != 1) {
+    if (pgp.size() != 1) {
         // "Error: Wrong number of packets.\n";
         return false;
     }
 
-    if (pgp.get_packets()[0] -> get_tag() != Packet::SIGNATURE) {
+    if (pgp.get_tag(0) != Packet::SIGNATURE) {
         // "Error: Packet is not a signature packet.\n";
         return false;
     }
 
-    if (!Signature_Type::is_revocation(std::static_pointer_cast <Packet::Tag2> (pgp.get_packets()[0]) -> get_type())) {
+    if (!Signature_Type::is_revocation(std::static_pointer_cast <Packet::Tag2> (pgp.get_packet(0)) -> get_type())) {
         // "Error: Signature packet does not contain a revocation certificate.\n";
         return false;
     }
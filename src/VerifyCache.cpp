@@ -0,0 +1,260 @@
+#include "VerifyCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Hashes/Hashes.h"
+#include "common/includes.h"
+
+namespace OpenPGP {
+
+static const char MAGIC[] = "PGPVCACH";
+
+static uint32_t read_be32(const uint8_t * p) {
+    return (static_cast <uint32_t> (p[0]) << 24) |
+           (static_cast <uint32_t> (p[1]) << 16) |
+           (static_cast <uint32_t> (p[2]) <<  8) |
+            static_cast <uint32_t> (p[3]);
+}
+
+const std::size_t VerifyCache::KEY_SIZE;
+const std::size_t VerifyCache::RECORD_SIZE;
+const std::size_t VerifyCache::HEADER_SIZE;
+const uint32_t VerifyCache::VERSION;
+
+bool VerifyCache::load() {
+    std::unique_ptr <MappedFile> mapped(new MappedFile(path));
+    if (!*mapped) {
+        // "Error: Could not open cache file.\n";
+        return false;
+    }
+
+    if (mapped -> size() < HEADER_SIZE) {
+        // "Error: Cache file too short.\n";
+        return false;
+    }
+
+    const uint8_t * data = reinterpret_cast <const uint8_t *> (mapped -> get_data());
+    const std::size_t records = read_be32(data + 12);
+    if (std::memcmp(data, MAGIC, 8) ||
+        (read_be32(data + 8) != VERSION) ||
+        (mapped -> size() != HEADER_SIZE + records * RECORD_SIZE)) {
+        // "Error: Bad cache file.\n";
+        return false;
+    }
+
+    file = std::move(mapped);
+    map = data;
+    count = records;
+    return true;
+}
+
+void VerifyCache::unload() {
+    file.reset();
+    map = nullptr;
+    count = 0;
+}
+
+bool VerifyCache::find_mapped(const std::string & key, bool & result) const {
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        const std::size_t mid = low + ((high - low) >> 1);
+        const uint8_t * record = map + HEADER_SIZE + mid * RECORD_SIZE;
+        const int cmp = std::memcmp(record, key.data(), KEY_SIZE);
+        if (cmp == 0) {
+            result = record[KEY_SIZE];
+            return true;
+        }
+        else if (cmp < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
+void VerifyCache::touch(const std::string & key, const bool result) {
+    if (!capacity) {
+        return;
+    }
+
+    std::unordered_map <std::string, LRU::iterator>::iterator it = index.find(key);
+    if (it != index.end()) {
+        it -> second -> second = result;
+        lru.splice(lru.begin(), lru, it -> second);
+        return;
+    }
+
+    lru.emplace_front(key, result);
+    index[key] = lru.begin();
+
+    if (lru.size() > capacity) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+    }
+}
+
+VerifyCache::VerifyCache(const std::size_t capacity)
+    : mutex(),
+      path(),
+      file(),
+      map(nullptr),
+      count(0),
+      pending(),
+      capacity(capacity),
+      lru(),
+      index()
+{}
+
+VerifyCache::VerifyCache(const std::string & path, const std::size_t capacity)
+    : VerifyCache(capacity)
+{
+    if (!path.size()) {
+        throw std::runtime_error("Error: No cache file given.");
+    }
+
+    this -> path = path;
+
+    // a missing or unreadable file is the same as an empty cache
+    load();
+}
+
+VerifyCache::~VerifyCache() {
+    unload();
+}
+
+std::string VerifyCache::key(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & sig, const std::string & digest) const {
+    std::string fingerprint, raw;
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        fingerprint = signer -> get_fingerprint();
+        raw = sig -> raw();
+    }
+
+    // fixed size keys regardless of the hash algorithms involved
+    return Hash::use(Hash::ID::SHA256, fingerprint + Hash::use(Hash::ID::SHA256, raw) + digest);
+}
+
+bool VerifyCache::get(const std::string & key, bool & result) {
+    if (key.size() != KEY_SIZE) {
+        return false;
+    }
+
+    std::lock_guard <std::mutex> lock(mutex);
+
+    std::unordered_map <std::string, LRU::iterator>::iterator it = index.find(key);
+    if (it != index.end()) {
+        result = it -> second -> second;
+        lru.splice(lru.begin(), lru, it -> second);
+        return true;
+    }
+
+    std::map <std::string, bool>::const_iterator p = pending.find(key);
+    if (p != pending.end()) {
+        result = p -> second;
+    }
+    else if (!find_mapped(key, result)) {
+        return false;
+    }
+
+    touch(key, result);
+    return true;
+}
+
+void VerifyCache::set(const std::string & key, const bool result) {
+    if (key.size() != KEY_SIZE) {
+        return;
+    }
+
+    std::lock_guard <std::mutex> lock(mutex);
+
+    bool old;
+    if (!find_mapped(key, old) || (old != result)) {
+        pending[key] = result;
+    }
+    else {
+        pending.erase(key);
+    }
+
+    touch(key, result);
+}
+
+std::size_t VerifyCache::size() const {
+    std::lock_guard <std::mutex> lock(mutex);
+
+    std::size_t total = count;
+    bool result;
+    for(std::pair <const std::string, bool> const & p : pending) {
+        total += !find_mapped(p.first, result);
+    }
+
+    return total;
+}
+
+bool VerifyCache::save() {
+    if (!path.size()) {
+        // "Error: Cache is not backed by a file.\n";
+        return false;
+    }
+
+    std::lock_guard <std::mutex> lock(mutex);
+
+    // merge the sorted file records with the sorted pending entries
+    std::string out;
+    out.reserve(HEADER_SIZE + (count + pending.size()) * RECORD_SIZE);
+    out += std::string(MAGIC, 8);
+    out += unhexlify(makehex(VERSION, 8));
+    out += std::string(4, 0);
+
+    std::size_t records = 0;
+    std::size_t i = 0;
+    std::map <std::string, bool>::const_iterator p = pending.begin();
+    while ((i < count) || (p != pending.end())) {
+        const char * record = reinterpret_cast <const char *> (map + HEADER_SIZE + i * RECORD_SIZE);
+        const int cmp = (i == count)?1:(p == pending.end())?-1:std::memcmp(record, p -> first.data(), KEY_SIZE);
+        if (cmp < 0) {
+            out.append(record, RECORD_SIZE);
+            i++;
+        }
+        else {
+            out += p -> first;
+            out += static_cast <char> (p -> second);
+            i += (cmp == 0);
+            p++;
+        }
+        records++;
+    }
+
+    out.replace(12, 4, unhexlify(makehex(records, 8)));
+
+    // write a new file and move it over the old one
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f || !f.write(out.data(), out.size())) {
+            // "Error: Could not write cache file.\n";
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    unload();
+
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        // "Error: Could not replace cache file.\n";
+        std::remove(tmp.c_str());
+        load();
+        return false;
+    }
+
+    pending.clear();
+    return load();
+}
+
+}
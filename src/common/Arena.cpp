@@ -0,0 +1,67 @@
+#include "common/Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace OpenPGP {
+
+// arena used by make_shared_in_arena on this thread
+static thread_local Arena::Ptr current_arena;
+
+Arena::Scope::Scope(const Arena::Ptr & arena)
+    : previous(current_arena)
+{
+    current_arena = arena;
+}
+
+Arena::Scope::~Scope() {
+    current_arena = previous;
+}
+
+Arena::Ptr Arena::current() {
+    return current_arena;
+}
+
+Arena::Arena(const std::size_t size)
+    : block_size(size?size:BLOCK_SIZE),
+      blocks(),
+      next(nullptr),
+      left(0),
+      total(0)
+{}
+
+Arena::~Arena() {
+    for(char * block : blocks) {
+        ::operator delete(block);
+    }
+}
+
+void * Arena::allocate(const std::size_t size, const std::size_t align) {
+    std::size_t padding = (align - (reinterpret_cast <std::uintptr_t> (next) % align)) % align;
+    if (!next || ((padding + size) > left)) {
+        // oversized requests get a block of their own
+        const std::size_t new_size = std::max(block_size, size + align);
+        char * block = static_cast <char *> (::operator new(new_size));
+        blocks.push_back(block);
+        next = block;
+        left = new_size;
+        padding = (align - (reinterpret_cast <std::uintptr_t> (next) % align)) % align;
+    }
+
+    char * out = next + padding;
+    next = out + size;
+    left -= padding + size;
+    total += size;
+    return out;
+}
+
+std::size_t Arena::used() const {
+    return total;
+}
+
+std::size_t Arena::block_count() const {
+    return blocks.size();
+}
+
+}
@@ -0,0 +1,126 @@
+#include "common/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OpenPGP {
+
+MemoryBuffer::pos_type MemoryBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type target = off;
+    if (dir == std::ios_base::cur) {
+        target += gptr() - eback();
+    }
+    else if (dir == std::ios_base::end) {
+        target += egptr() - eback();
+    }
+
+    if ((target < 0) || (target > (egptr() - eback()))) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + target, egptr());
+    return pos_type(target);
+}
+
+MemoryBuffer::pos_type MemoryBuffer::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+MemoryBuffer::MemoryBuffer(const char * data, const std::size_t size)
+    : std::streambuf()
+{
+    reset(data, size);
+}
+
+void MemoryBuffer::reset(const char * data, const std::size_t size) {
+    // the get area is never written to
+    char * begin = const_cast <char *> (data);
+    setg(begin, begin, begin + size);
+}
+
+MappedFile::MappedFile(const std::string & path)
+    : data(nullptr),
+      length(0),
+      opened(false),
+      mapped(false),
+      contents(),
+      buf(),
+      in(&buf)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        in.setstate(std::ios::failbit);
+        return;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && st.st_size) {
+        void * map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            // the whole file is read front to back
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+            data = static_cast <const char *> (map);
+            length = st.st_size;
+            mapped = true;
+        }
+    }
+
+    if (!mapped) {
+        char chunk[4096];
+        ssize_t got = 0;
+        while ((got = read(fd, chunk, sizeof(chunk))) > 0) {
+            contents.append(chunk, got);
+        }
+
+        if (got < 0) {
+            close(fd);
+            in.setstate(std::ios::failbit);
+            return;
+        }
+
+        data = contents.data();
+        length = contents.size();
+    }
+
+    close(fd);
+
+    opened = true;
+    buf.reset(data, length);
+}
+
+MappedFile::~MappedFile() {
+    if (mapped) {
+        munmap(const_cast <char *> (data), length);
+    }
+}
+
+bool MappedFile::operator!() const {
+    return !opened;
+}
+
+const char * MappedFile::get_data() const {
+    return data;
+}
+
+std::size_t MappedFile::size() const {
+    return length;
+}
+
+std::string MappedFile::str() const {
+    return data?std::string(data, length):std::string();
+}
+
+std::istream & MappedFile::stream() {
+    in.clear(opened?std::ios::goodbit:std::ios::failbit);
+    in.seekg(0);
+    return in;
+}
+
+}
@@ -33,6 +33,14 @@ uint64_t toint(const std::string & s, const int & base) {
     return value;
 }
 
+uint64_t toint(const std::string & data, const std::string::size_type pos, const std::size_t octets) {
+    uint64_t value = 0;
+    for(std::size_t i = 0; (i < octets) && ((pos + i) < data.size()); i++) {
+        value = (value << 8) | static_cast <uint8_t> (data[pos + i]);
+    }
+    return value;
+}
+
 std::string little_end(const std::string & str, const unsigned int & base) {
     // Changes a string to its little endian form
     if (const uint32_t s = 8 * (base == 2) + 2 * (base == 16) + (base == 256)) {
@@ -145,13 +145,28 @@ Message pka(const SecretKey & pri,
     else if (tag1 -> get_pka() == PKA::ID::ELGAMAL) {
         symkey = PKA::ElGamal::decrypt(tag1 -> get_mpi(), secret_keys, sec -> get_mpi());
     }
+    #ifdef GPG_COMPATIBLE
+    else if (tag1 -> get_pka() == PKA::ID::ECDH) {
+        const Packet::Key::Ptr pub = sec -> get_public_ptr();
+        const std::string param = PKA::ECDH::kdf_param(pub -> get_curve(), pub -> get_kdf_hash(), pub -> get_kdf_alg(), pub -> get_fingerprint());
+        symkey = PKA::ECDH::decrypt(tag1 -> get_mpi()[0], tag1 -> get_wrapped(), secret_keys, param, pub -> get_kdf_hash(), pub -> get_kdf_alg());
+        if (!symkey.size()) {
+            // "Error: ECDH session key unwrapping failed.\n";
+            return Message();
+        }
+    }
 
-    // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
-    symkey = zero + symkey;
+    // ECDH session keys are not EME_PKCS1 encoded
+    if (tag1 -> get_pka() != PKA::ID::ECDH)
+    #endif
+    {
+        // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
+        symkey = zero + symkey;
 
-    if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()) {                  // remove EME_PKCS1 encoding
-        // "Error: EME_PKCS1v1_5_DECODE failure.\n";
-        return Message();
+        if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()) {              // remove EME_PKCS1 encoding
+            // "Error: EME_PKCS1v1_5_DECODE failure.\n";
+            return Message();
+        }
     }
 
     const uint8_t sym = symkey[0];                                          // get symmetric algorithm
@@ -72,6 +72,85 @@ Packet::Tag::Ptr data(const Args & args,
     return encrypted;
 }
 
+// prepared, if given, holds the values derived from key
+static Message pka(const Args & args,
+                   const Packet::Key::Ptr & key,
+                   const PreparedKey * prepared) {
+    PKA::Values owned;
+    const PKA::Values & mpi = prepared?prepared -> get_mpi():(owned = key -> get_mpi());
+
+    Packet::Tag1::Ptr tag1 = std::make_shared <Packet::Tag1> ();
+    tag1 -> set_keyid(prepared?prepared -> get_keyid():key -> get_keyid());
+    tag1 -> set_pka(key -> get_pka());
+
+    // do calculations
+
+    // generate session key
+    const std::string session_key = RNG::RNG().rand_bytes(Sym::KEY_LENGTH.at(args.sym) >> 3);
+
+    // get checksum of session key
+    uint16_t sum = 0;
+    for(char const c : session_key) {
+        sum += static_cast <unsigned char> (c);
+    }
+
+    const std::string session = std::string(1, args.sym) + session_key + unhexlify(makehex(sum, 4));
+
+    #ifdef GPG_COMPATIBLE
+    // ECDH wraps the session key with a key derived from a shared secret
+    if (key -> get_pka() == PKA::ID::ECDH) {
+        if (hexlify(key -> get_curve(), true) != PKA::CURVE_OID::CURVE_255) {
+            // "Error: Only Curve25519 is supported for ECDH.\n";
+            return Message();
+        }
+
+        const std::string param = PKA::ECDH::kdf_param(key -> get_curve(), key -> get_kdf_hash(), key -> get_kdf_alg(), prepared?prepared -> get_fingerprint():key -> get_fingerprint());
+        std::string wrapped;
+        const PKA::Values ephemeral = PKA::ECDH::encrypt(session, mpi, param, key -> get_kdf_hash(), key -> get_kdf_alg(), wrapped);
+        if (!ephemeral.size()) {
+            // "Error: ECDH session key wrapping failed.\n";
+            return Message();
+        }
+
+        tag1 -> set_mpi(ephemeral);
+        tag1 -> set_wrapped(wrapped);
+    }
+    else
+    #endif
+    {
+        // pad to the length of the modulus
+        MPI m = rawtompi(EME_PKCS1v1_5_ENCODE(session, prepared?prepared -> get_modulus_length():bytesize(mpi[0])));
+
+        // encrypt m
+        if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
+            (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
+            tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
+        }
+        else if (key -> get_pka() == PKA::ID::ELGAMAL) {
+            if (prepared && prepared -> get_elgamal_y()) {
+                tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi, PKA::ElGamal::ephemeral(mpi, *prepared -> get_elgamal_g(), *prepared -> get_elgamal_y())));
+            }
+            else {
+                tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi));
+            }
+        }
+    }
+
+    // encrypt data and put it into a packet
+    Packet::Tag::Ptr encrypted = data(args, session_key);
+    if (!encrypted) {
+        // "Error: Failed to encrypt data.\n";
+        return Message();
+    }
+
+    // write data to output container
+    Message out;
+    out.set_keys({std::make_pair("Version", "cc")});
+    out.set_packets({tag1, encrypted});
+
+    return out;
+}
+
 Message pka(const Args & args,
             const Key & pgpkey) {
     if (!args.valid()) {
@@ -113,48 +192,22 @@ Message pka(const Args & args,
         return Message();
     }
 
-    PKA::Values mpi = key -> get_mpi();
-    Packet::Tag1::Ptr tag1 = std::make_shared <Packet::Tag1> ();
-    tag1 -> set_keyid(key -> get_keyid());
-    tag1 -> set_pka(key -> get_pka());
-
-    // do calculations
-
-    // generate session key
-    const std::string session_key = RNG::RNG().rand_bytes(Sym::KEY_LENGTH.at(args.sym) >> 3);
-
-    // get checksum of session key
-    uint16_t sum = 0;
-    for(char const c : session_key) {
-        sum += static_cast <unsigned char> (c);
-    }
-
-    std::string nibbles = mpitohex(mpi[0]);        // get hex representation of modulus
-    nibbles += std::string(nibbles.size() & 1, 0); // get even number of nibbles
-    MPI m = rawtompi(EME_PKCS1v1_5_ENCODE(std::string(1, args.sym) + session_key + unhexlify(makehex(sum, 4)), nibbles.size() >> 1));
+    return pka(args, key, nullptr);
+}
 
-    // encrypt m
-    if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
-        (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
-        tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
-    }
-    else if (key -> get_pka() == PKA::ID::ELGAMAL) {
-        tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi));
+Message pka(const Args & args,
+            const PreparedKey & key) {
+    if (!args.valid()) {
+        // "Error: Bad argument.\n";
+        return Message();
     }
 
-    // encrypt data and put it into a packet
-    Packet::Tag::Ptr encrypted = data(args, session_key);
-    if (!encrypted) {
-        // "Error: Failed to encrypt data.\n";
+    if (!PKA::can_encrypt(key.get_pka())) {
+        // "Error: Key cannot encrypt.\n";
         return Message();
     }
 
-    // write data to output container
-    Message out;
-    out.set_keys({std::make_pair("Version", "cc")});
-    out.set_packets({tag1, encrypted});
-
-    return out;
+    return pka(args, key.get_key(), &key);
 }
 
 Message sym(const Args & args,
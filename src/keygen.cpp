@@ -77,6 +77,20 @@ bool fill_key_sigs(SecretKey & private_key, const std::string & passphrase) {
     return true;
 }
 
+#ifdef GPG_COMPATIBLE
+// curve and KDF fields of elliptic curve keys
+static void set_curve(const Packet::Key::Ptr & key) {
+    if (key -> get_pka() == PKA::ID::EdDSA) {
+        key -> set_curve(unhexlify(PKA::CURVE_OID::ED_255));
+    }
+    else if (key -> get_pka() == PKA::ID::ECDH) {
+        key -> set_curve(unhexlify(PKA::CURVE_OID::CURVE_255));
+        key -> set_kdf_hash(Hash::ID::SHA256);
+        key -> set_kdf_alg(Sym::ID::AES128);
+    }
+}
+#endif
+
 SecretKey generate_key(Config & config) {
     if (!config.valid()) {
         // "Error: Bad key generation configuration.\n";
@@ -94,7 +108,7 @@ SecretKey generate_key(Config & config) {
     // generate public key values for primary key
     PKA::Values pub;
     PKA::Values pri;
-    if (!PKA::generate_keypair(config.pka, PKA::generate_params(config.pka, config.bits >> 1), pri, pub)) {
+    if (!PKA::generate_keypair(config.pka, PKA::generate_params(config.pka, config.bits >> 1), pri, pub, config.standard)) {
         // "Error: Could not generate primary key pair.\n";
         return SecretKey();
     }
@@ -102,7 +116,7 @@ SecretKey generate_key(Config & config) {
     // convert the secret values into a string
     std::string secret;
     for(MPI const & mpi : pri) {
-        secret += write_MPI(mpi);
+        write_MPI(mpi, secret);
     }
 
     // Secret Key Packet
@@ -111,6 +125,9 @@ SecretKey generate_key(Config & config) {
     primary -> set_time(time);
     primary -> set_pka(config.pka);
     primary -> set_mpi(pub);
+    #ifdef GPG_COMPATIBLE
+    set_curve(primary);
+    #endif
     primary -> set_s2k_con(0); // no passphrase up to here
 
     // encrypt secret only if there is a passphrase
@@ -191,7 +208,7 @@ SecretKey generate_key(Config & config) {
     for(Config::SubkeyGen const & skey : config.subkeys) {
         PKA::Values subkey_pub;
         PKA::Values subkey_pri;
-        if (!PKA::generate_keypair(skey.pka, PKA::generate_params(skey.pka, skey.bits >> 1), subkey_pri, subkey_pub)) {
+        if (!PKA::generate_keypair(skey.pka, PKA::generate_params(skey.pka, skey.bits >> 1), subkey_pri, subkey_pub, skey.standard)) {
             // "Error: Could not generate subkey pair.\n";
             return SecretKey();
         }
@@ -199,7 +216,7 @@ SecretKey generate_key(Config & config) {
         // convert the secret values into a string
         secret = "";
         for(MPI const & mpi : subkey_pri) {
-            secret += write_MPI(mpi);
+            write_MPI(mpi, secret);
         }
 
         // Secret Subkey Packet
@@ -208,6 +225,9 @@ SecretKey generate_key(Config & config) {
         subkey -> set_time(time);
         subkey -> set_pka(skey.pka);
         subkey -> set_mpi(subkey_pub);
+        #ifdef GPG_COMPATIBLE
+        set_curve(subkey);
+        #endif
         subkey -> set_s2k_con(0); // no passphrase up to here
 
         // encrypt secret only if there is a passphrase
@@ -230,7 +250,7 @@ SecretKey generate_key(Config & config) {
             // encrypt private key value
             subkey -> set_s2k(s2k3);
             subkey -> set_IV(RNG::RNG().rand_bytes(Sym::BLOCK_LENGTH.at(skey.sym) >> 3));
-            secret = use_normal_CFB_encrypt(skey.sym, secret + Hash::use(Hash::ID::SHA1, secret), session_key, subkey -> get_IV());
+            secret = use_normal_CFB_encrypt(skey.sym, secret, session_key, subkey -> get_IV());
         }
         else{
             // add checksum to secret
@@ -15,6 +15,14 @@ PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::V
     else if (pka == PKA::ID::DSA) {
         return PKA::DSA::sign(digest, pri, pub);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDSA) {
+        return PKA::ECDSA::sign(digest, pri, pub);
+    }
+    else if (pka == PKA::ID::EdDSA) {
+        return PKA::EdDSA::sign(digest, pri, pub);
+    }
+    #endif
 
     // "Error: Undefined or incorrect PKA number: " + std::to_string(pka) + "\n";
     return {};
@@ -1,5 +1,10 @@
 #include "verify.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
 namespace OpenPGP {
 namespace Verify {
 
@@ -8,11 +13,19 @@ int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka,
         (pka == PKA::ID::RSA_SIGN_ONLY)) {
         // RFC 4880 sec 5.2.2
         // If RSA, hash value is encoded using EMSA-PKCS1-v1_5
-        return PKA::RSA::verify(EMSA_PKCS1_v1_5(hash, digest, bitsize(signer[0]) >> 3), signee, signer);
+        return PKA::RSA::verify(EMSA_PKCS1_v1_5(hash, digest, bytesize(signer[0])), signee, signer);
     }
     else if (pka == PKA::ID::DSA) {
         return PKA::DSA::verify(digest, signee, signer);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDSA) {
+        return PKA::ECDSA::verify(digest, signee, signer);
+    }
+    else if (pka == PKA::ID::EdDSA) {
+        return PKA::EdDSA::verify(digest, signee, signer);
+    }
+    #endif
 
     // "Error: Bad PKA value.\n";
     return -1;
@@ -22,6 +35,56 @@ int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const
     return with_pka(digest, signee -> get_hash(), signee -> get_pka(), signer -> get_mpi(), signee -> get_mpi());
 }
 
+int with_pka(const std::string & digest, const uint8_t hash, const PreparedKey & signer, const PKA::Values & signee) {
+    const uint8_t pka = signer.get_pka();
+    if (PKA::is_RSA(pka)) {
+        const std::string & prefix = signer.get_emsa_prefix(hash);
+        if (!prefix.size()) {
+            // "Error: Hash does not fit in the RSA modulus.\n";
+            return -1;
+        }
+
+        return PKA::RSA::verify(prefix + digest, signee, signer.get_mpi());
+    }
+    else if ((pka == PKA::ID::DSA) && signer.get_dsa_y()) {
+        return PKA::DSA::verify(rawtompi(digest), signee, signer.get_mpi(), *signer.get_dsa_g(), *signer.get_dsa_y());
+    }
+
+    return with_pka(digest, hash, pka, signer.get_mpi(), signee);
+}
+
+int with_pka(const std::string & digest, const PreparedKey & signer, const Packet::Tag2::Ptr & signee) {
+    if (signee -> get_pka() != signer.get_pka()) {
+        return false;
+    }
+
+    return with_pka(digest, signee -> get_hash(), signer, signee -> get_mpi());
+}
+
+int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee, VerifyCache & cache) {
+    const std::string key = cache.key(signer, signee, digest);
+
+    bool result;
+    if (cache.get(key, result)) {
+        return result;
+    }
+
+    const int rc = with_pka(digest, signer, signee);
+    if (rc != -1) {
+        cache.set(key, rc);
+    }
+
+    return rc;
+}
+
+static int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee, VerifyCache * cache) {
+    if (cache) {
+        return with_pka(digest, signer, signee, *cache);
+    }
+
+    return with_pka(digest, signer, signee);
+}
+
 int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig) {
     if (!key.meaningful()) {
         // "Error: Bad PGP Key.\n";
@@ -65,6 +128,115 @@ int detached_signature(const Key & key, const std::string & data, const Detached
     return with_pka(digest, signing_key, signature);
 }
 
+// keyid is the ID that the signature has to name
+static int detached_signature(const PreparedKey & signer, const std::string & keyid, const std::string & data, const DetachedSignature & sig) {
+    if (!sig.meaningful()) {
+        // "Error: Bad detached signature.\n";
+        return -1;
+    }
+
+    const Packet::Tag2::Ptr signature = std::static_pointer_cast <Packet::Tag2> (sig.get_packets()[0]);
+
+    // find key id in signature
+    const std::string sig_keyid = signature -> get_keyid();
+    if (!sig_keyid.size()) {
+        // "Error: No Key ID subpacket found.\n";
+        return -1;
+    }
+
+    // make sure the key ID on the signature matches the Key's ID
+    if (sig_keyid != keyid) {
+        return false;
+    }
+
+    // calculate the digest of the data (treated as binary)
+    // and check the left 16 bits
+    const std::string digest = to_sign_00(binary_to_canonical(data), signature);
+    if (digest.substr(0, 2) != signature -> get_left16()) {
+        // "Hash digest and given left 16 bits of hash do not match.\n";
+        return false;
+    }
+
+    return with_pka(digest, signer, signature);
+}
+
+int detached_signature(const PreparedKey & signer, const std::string & data, const DetachedSignature & sig) {
+    return detached_signature(signer, signer.get_keyid(), data, sig);
+}
+
+std::vector <int> batch(const std::vector <Job> & jobs, const unsigned int threads) {
+    std::vector <int> out(jobs.size(), -1);
+
+    // signing key of each Key, prepared once per distinct signing key
+    struct Signer {
+        PreparedKey::Ptr prepared;
+        std::string keyid;
+    };
+
+    std::map <const Key *, Signer> signers;
+    std::map <Packet::Key::Fingerprint, PreparedKey::Ptr> prepared;
+    std::vector <const Signer *> signer(jobs.size(), nullptr);
+    for(std::size_t i = 0; i < jobs.size(); i++) {
+        const Job & job = jobs[i];
+        if (!job.key || !job.sig) {
+            continue;
+        }
+
+        std::map <const Key *, Signer>::iterator it = signers.find(job.key.get());
+        if (it == signers.end()) {
+            Signer s;
+            if (job.key -> meaningful()) {
+                const Packet::Key::Ptr signing_key = find_signing_key(*job.key);
+                if (signing_key) {
+                    PreparedKey::Ptr & p = prepared[signing_key -> get_fingerprint_array()];
+                    if (!p) {
+                        p = std::make_shared <PreparedKey> (signing_key);
+                    }
+                    s.prepared = p;
+                    s.keyid = job.key -> keyid();
+                }
+            }
+            it = signers.insert(std::make_pair(job.key.get(), s)).first;
+        }
+
+        if (it -> second.prepared) {
+            signer[i] = &(it -> second);
+
+            // workers share the signatures, so parse lazily read packets
+            // and fill the cached packet octets before they start
+            for(Packet::Tag::Ptr const & p : job.sig -> get_packets()) {
+                if (p) {
+                    p -> raw();
+                }
+            }
+        }
+    }
+
+    // workers take the next unclaimed job until there are none left
+    std::atomic <std::size_t> next(0);
+    const auto work = [&]() {
+        for(std::size_t i = next++; i < jobs.size(); i = next++) {
+            if (signer[i]) {
+                out[i] = detached_signature(*(signer[i] -> prepared), signer[i] -> keyid, jobs[i].data, *jobs[i].sig);
+            }
+        }
+    };
+
+    std::size_t count = threads?threads:std::thread::hardware_concurrency();
+    count = std::max(std::min(count, jobs.size()), static_cast <std::size_t> (1));
+
+    std::vector <std::thread> workers;
+    for(std::size_t i = 1; i < count; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for(std::thread & worker : workers) {
+        worker.join();
+    }
+
+    return out;
+}
+
 // 0x00: Signature of a binary document.
 int binary(const Key & key, const Message & message) {
     if (!key.meaningful()) {
@@ -259,17 +431,17 @@ int cleartext_signature(const Key & key, const CleartextSignature & message) {
 // 0x11: Persona certification of a User ID and Public-Key packet.
 // 0x12: Casual certification of a User ID and Public-Key packet.
 // 0x13: Positive certification of a User ID and Public-Key packet.
-int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature) {
+static int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature, VerifyCache * cache) {
     // if the signing key's ID doesn't match with the signature's ID
     if ((signer_key -> get_keyid() != signee_signature -> get_keyid())) {
         return false;
     }
 
     // check if the signature is valid
-    return with_pka(to_sign_cert(signee_signature -> get_type(), signee_key, signee_id, signee_signature), signer_key, signee_signature);
+    return with_pka(to_sign_cert(signee_signature -> get_type(), signee_key, signee_id, signee_signature), signer_key, signee_signature, cache);
 }
 
-int primary_key(const Key & signer, const Key & signee) {
+static int primary_key(const Key & signer, const Key & signee, VerifyCache * cache) {
     if (!signer.meaningful()) {
         // "Error: Bad Signer Key.\n";
         return -1;
@@ -313,7 +485,7 @@ int primary_key(const Key & signer, const Key & signee) {
             const Packet::Tag2::Ptr signee_signature = std::static_pointer_cast <Packet::Tag2> (signee_packet);
 
             // check if the signature is valid
-            const int rc = primary_key(signer_key, signee_key, signee_id, signee_signature);
+            const int rc = primary_key(signer_key, signee_key, signee_id, signee_signature, cache);
             if (rc == true) {
                 return true;
             }
@@ -327,7 +499,92 @@ int primary_key(const Key & signer, const Key & signee) {
     return false;
 }
 
+int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature) {
+    return primary_key(signer_key, signee_key, signee_id, signee_signature, nullptr);
+}
+
+int primary_key(const Key & signer, const Key & signee) {
+    return primary_key(signer, signee, nullptr);
+}
+
+int primary_key(const Packet::Key::Ptr & signer_key, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signee_signature, VerifyCache & cache) {
+    return primary_key(signer_key, signee_key, signee_id, signee_signature, &cache);
+}
+
+int primary_key(const Key & signer, const Key & signee, VerifyCache & cache) {
+    return primary_key(signer, signee, &cache);
+}
+
 // 0x18: Subkey Binding Signature
+static int subkey_binding(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & binding, VerifyCache * cache) {
+    if (!primary || !subkey || !binding) {
+        // "Error: Missing packet.\n";
+        return -1;
+    }
+
+    if (binding -> get_type() != Signature_Type::SUBKEY_BINDING_SIGNATURE) {
+        return false;
+    }
+
+    // bindings are made by the primary key
+    if (primary -> get_keyid() != binding -> get_keyid()) {
+        return false;
+    }
+
+    return with_pka(to_sign_18(primary, subkey, binding), primary, binding, cache);
+}
+
+static int subkey_binding(const Key & key, VerifyCache * cache) {
+    if (!key.meaningful()) {
+        // "Error: Bad Key.\n";
+        return -1;
+    }
+
+    Packet::Key::Ptr primary = nullptr;
+    Packet::Key::Ptr subkey = nullptr;
+
+    for(Packet::Tag::Ptr const & packet : key.get_packets()) {
+        if (Packet::is_primary_key(packet -> get_tag())) {
+            primary = std::static_pointer_cast <Packet::Key> (packet);
+            subkey = nullptr;
+        }
+        else if (Packet::is_subkey(packet -> get_tag())) {
+            subkey = std::static_pointer_cast <Packet::Key> (packet);
+        }
+        else if (Packet::is_user(packet -> get_tag())) {
+            subkey = nullptr;
+        }
+        else if (subkey && (packet -> get_tag() == Packet::SIGNATURE)) {
+            const Packet::Tag2::Ptr binding = std::static_pointer_cast <Packet::Tag2> (packet);
+            if (binding -> get_type() != Signature_Type::SUBKEY_BINDING_SIGNATURE) {
+                continue;
+            }
+
+            const int rc = subkey_binding(primary, subkey, binding, cache);
+            if (rc != true) {
+                return rc;
+            }
+        }
+    }
+
+    return true;
+}
+
+int subkey_binding(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & binding) {
+    return subkey_binding(primary, subkey, binding, nullptr);
+}
+
+int subkey_binding(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & binding, VerifyCache & cache) {
+    return subkey_binding(primary, subkey, binding, &cache);
+}
+
+int subkey_binding(const Key & key) {
+    return subkey_binding(key, nullptr);
+}
+
+int subkey_binding(const Key & key, VerifyCache & cache) {
+    return subkey_binding(key, &cache);
+}
 
 // 0x19: Primary Key Binding Signature
 
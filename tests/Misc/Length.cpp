@@ -203,11 +203,38 @@ TEST(write_new_length, partial) {
     const char last = data.back();
     data.pop_back();
 
-    // add last length header
-    data += std::string(1, (uint8_t) (0xc0 | tag)) + std::string(1, '\x01') + std::string(1, last);
+    // add last length header (no tag octet, since it is the same packet)
+    data += std::string(1, '\x01') + std::string(1, last);
 
     // reduce copying when doing comparison
     EXPECT_EQ((uint8_t) out[0], 0xc0 | tag);
     EXPECT_EQ((uint8_t) out[1], 0xe0 + 9);
     EXPECT_EQ(out.compare(2, data.size(), data), 0);
 }
+
+TEST(write_length, header_sizes) {
+    for(std::size_t const i : {0, 1, 191, 192, 255, 256, 8383, 8384, 65535, 65536, 100000}) {
+        const std::string data(i, '\x00');
+
+        std::string old_header;
+        OpenPGP::write_old_header(tag, data.size(), old_header);
+        const std::string old_out = OpenPGP::write_old_length(tag, data, OpenPGP::Packet::PartialBodyLength::NOT_PARTIAL);
+        EXPECT_EQ(old_header + data, old_out);
+        EXPECT_EQ(OpenPGP::old_length_size(data.size(), OpenPGP::Packet::PartialBodyLength::NOT_PARTIAL) + data.size(), old_out.size());
+
+        std::string new_header;
+        OpenPGP::write_new_header(tag, data.size(), new_header);
+        const std::string new_out = OpenPGP::write_new_length(tag, data, OpenPGP::Packet::PartialBodyLength::NOT_PARTIAL);
+        EXPECT_EQ(new_header + data, new_out);
+        EXPECT_EQ(OpenPGP::new_length_size(data.size(), OpenPGP::Packet::PartialBodyLength::NOT_PARTIAL) + data.size(), new_out.size());
+    }
+
+    // partial body lengths
+    for(std::size_t const i : {512, 513, 703, 704, 1024, 100000}) {
+        const std::string data(i, '\x00');
+        EXPECT_EQ(OpenPGP::old_length_size(data.size(), OpenPGP::Packet::PartialBodyLength::PARTIAL) + data.size(),
+                  OpenPGP::write_old_length(tag, data, OpenPGP::Packet::PartialBodyLength::PARTIAL).size());
+        EXPECT_EQ(OpenPGP::new_length_size(data.size(), OpenPGP::Packet::PartialBodyLength::PARTIAL) + data.size(),
+                  OpenPGP::write_new_length(tag, data, OpenPGP::Packet::PartialBodyLength::PARTIAL).size());
+    }
+}
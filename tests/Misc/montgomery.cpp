@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "Misc/montgomery.h"
+#include "Misc/mpi.h"
+
+const int COUNT = 10;
+
+// OpenPGP::random is slow for large values, so use GMP's generator for test data
+static gmp_randclass & rng() {
+    static gmp_randclass gen(gmp_randinit_default);
+    return gen;
+}
+
+static OpenPGP::MPI random_mpi(const unsigned int bits) {
+    return rng().get_z_bits(bits);
+}
+
+TEST(Montgomery, mul) {
+    for(unsigned int const bits : {64, 65, 1024, 2048}) {
+        const OpenPGP::MPI m = random_mpi(bits) | 1;
+        const OpenPGP::Montgomery ctx(m);
+        OpenPGP::Montgomery::Residue scratch(ctx.size() << 1);
+
+        for(int i = 0; i < COUNT; ++i) {
+            const OpenPGP::MPI a = random_mpi(bits) % m;
+            const OpenPGP::MPI b = random_mpi(bits) % m;
+
+            EXPECT_EQ(ctx.from(ctx.to(a)), a);
+
+            OpenPGP::Montgomery::Residue ab = ctx.to(a);
+            ctx.mul(ab.data(), ab.data(), ctx.to(b).data(), scratch.data());
+            EXPECT_EQ(ctx.from(ab), (a * b) % m);
+
+            OpenPGP::Montgomery::Residue aa = ctx.to(a);
+            ctx.sqr(aa.data(), aa.data(), scratch.data());
+            EXPECT_EQ(ctx.from(aa), (a * a) % m);
+        }
+    }
+}
+
+TEST(Montgomery, even_modulus) {
+    EXPECT_THROW(OpenPGP::Montgomery(1024), std::runtime_error);
+}
+
+TEST(Montgomery, powm) {
+    for(unsigned int const bits : {64, 1024, 2048}) {
+        const OpenPGP::MPI m = random_mpi(bits) | 1;
+        for(unsigned int const w : {1, 4, 6}) {
+            for(int i = 0; i < COUNT; ++i) {
+                const OpenPGP::MPI b = random_mpi(bits);
+                const OpenPGP::MPI e = random_mpi(256);
+                const OpenPGP::WindowTable table(b, m, w);
+                EXPECT_EQ(OpenPGP::powm(table, e), OpenPGP::powm(b, e, m));
+            }
+
+            EXPECT_EQ(OpenPGP::powm(OpenPGP::WindowTable(5, m, w), 0), 1);
+        }
+    }
+}
+
+TEST(Montgomery, powm2) {
+    for(unsigned int const bits : {64, 1024, 2048}) {
+        const OpenPGP::MPI m = random_mpi(bits) | 1;
+        const OpenPGP::MPI a = random_mpi(bits);
+        const OpenPGP::WindowTable at(a, m, 6);
+        for(int i = 0; i < COUNT; ++i) {
+            const OpenPGP::MPI b = random_mpi(bits);
+            const OpenPGP::MPI x = random_mpi(256);
+            const OpenPGP::MPI y = random_mpi(160 + i);
+            const OpenPGP::WindowTable bt(b, at.get_ctx(), 4);
+            EXPECT_EQ(OpenPGP::powm(at, x, bt, y), (OpenPGP::powm(a, x, m) * OpenPGP::powm(b, y, m)) % m);
+        }
+
+        // one exponent is 0
+        const OpenPGP::MPI x = random_mpi(256);
+        EXPECT_EQ(OpenPGP::powm(at, x, OpenPGP::WindowTable(3, m), 0), OpenPGP::powm(a, x, m));
+    }
+}
+
+TEST(Montgomery, powm_sec) {
+    for(unsigned int const bits : {64, 1024, 2048}) {
+        const OpenPGP::MPI m = random_mpi(bits) | 1;
+        const OpenPGP::MPI b = random_mpi(bits);
+        for(unsigned int const teeth : {1, 4, 6}) {
+            for(std::size_t const ebits : {160, 256, 257}) {
+                const OpenPGP::CombTable table(b, m, ebits, teeth);
+                for(int i = 0; i < COUNT; ++i) {
+                    const OpenPGP::MPI e = random_mpi(ebits);
+                    EXPECT_EQ(OpenPGP::powm_sec(table, e), OpenPGP::powm(b, e, m));
+                }
+
+                EXPECT_EQ(OpenPGP::powm_sec(table, 0), 1);
+                EXPECT_THROW(OpenPGP::powm_sec(table, OpenPGP::MPI(1) << ebits), std::runtime_error);
+            }
+        }
+    }
+}
@@ -5,6 +5,8 @@
 #include <sstream>
 
 #include "Misc/mpi.h"
+#include "RNG/Deterministic.h"
+#include "RNG/RNGs.h"
 #include "common/includes.h"
 
 const int COUNT = 10;
@@ -111,3 +113,84 @@ TEST(MPI, read_write) {
         EXPECT_EQ(OpenPGP::read_MPI(str, pos), value);
     }
 }
+
+TEST(MPI, bytesize) {
+    EXPECT_EQ(OpenPGP::bytesize(0), 1);
+    OpenPGP::MPI mpi = 1;
+    for(std::size_t i = 1; i < 128; i++) {
+        EXPECT_EQ(OpenPGP::bytesize(mpi), (i + 7) >> 3);
+        mpi <<= 1;
+    }
+}
+
+TEST(MPI, convert_raw_buffer) {
+    for(std::pair <const std::string, OpenPGP::MPI> const & test : tests) {
+        EXPECT_EQ(OpenPGP::rawtompi(test.first.data(), test.first.size()), test.second);
+
+        std::string buf(OpenPGP::bytesize(test.second), '\xff');
+        EXPECT_EQ(OpenPGP::mpitoraw(test.second, &buf[0]), test.first.size());
+        EXPECT_EQ(buf, test.first);
+    }
+
+    // 0 is a single zero octet
+    EXPECT_EQ(OpenPGP::rawtompi(std::string()), 0);
+    EXPECT_EQ(OpenPGP::mpitoraw(0), std::string(1, 0));
+}
+
+TEST(MPI, write_append) {
+    std::string out = "prefix";
+    OpenPGP::write_MPI(0x010203UL, out);
+    EXPECT_EQ(out, std::string("prefix\x00\x11\x01\x02\x03", 11));
+
+    std::string::size_type pos = 6;
+    EXPECT_EQ(OpenPGP::read_MPI(out, pos), 0x010203UL);
+    EXPECT_EQ(pos, out.size());
+
+    // zero
+    EXPECT_EQ(OpenPGP::write_MPI(0), std::string("\x00\x01\x00", 3));
+}
+
+TEST(MPI, random_mpi) {
+    EXPECT_EQ(OpenPGP::RNG::random_mpi(0), 0);
+    EXPECT_EQ(OpenPGP::RNG::random_mpi(1, OpenPGP::RNG::TOP_BIT), 1);
+
+    for(unsigned int bits = 1; bits < 80; bits++) {
+        for(int i = 0; i < COUNT; i++) {
+            EXPECT_LE(OpenPGP::bitsize(OpenPGP::RNG::random_mpi(bits)), bits);
+            EXPECT_EQ(OpenPGP::bitsize(OpenPGP::RNG::random_mpi(bits, OpenPGP::RNG::TOP_BIT)), bits);
+
+            const OpenPGP::MPI odd = OpenPGP::RNG::random_mpi(bits, OpenPGP::RNG::TOP_BIT | OpenPGP::RNG::ODD);
+            EXPECT_EQ(OpenPGP::bitsize(odd), bits);
+            EXPECT_EQ(mpz_odd_p(odd.get_mpz_t()), 1);
+        }
+    }
+
+    // values below a modulus, covering every residue of a small one
+    const OpenPGP::MPI modulus = 5;
+    std::map <unsigned long, int> seen;
+    for(int i = 0; i < 200; i++) {
+        const OpenPGP::MPI value = OpenPGP::RNG::random_mpi(modulus);
+        ASSERT_LT(value, modulus);
+        seen[OpenPGP::mpitoulong(value)]++;
+    }
+    EXPECT_EQ(seen.size(), 5);
+
+    const OpenPGP::MPI big = OpenPGP::hextompi("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    for(int i = 0; i < COUNT; i++) {
+        EXPECT_LT(OpenPGP::RNG::random_mpi(big), big);
+    }
+}
+
+TEST(MPI, random_mpi_provider) {
+    OpenPGP::RNG::set_provider(std::make_shared <OpenPGP::RNG::Deterministic> ("seed"));
+    const OpenPGP::MPI a = OpenPGP::RNG::random_mpi(256);
+    const OpenPGP::MPI b = OpenPGP::RNG::random_mpi(256);
+
+    OpenPGP::RNG::set_provider(std::make_shared <OpenPGP::RNG::Deterministic> ("seed"));
+    EXPECT_EQ(OpenPGP::RNG::random_mpi(256), a);
+    EXPECT_EQ(OpenPGP::RNG::random_mpi(256), b);
+
+    OpenPGP::RNG::set_provider(nullptr);
+    EXPECT_EQ(OpenPGP::RNG::get_provider(), nullptr);
+    EXPECT_NE(OpenPGP::RNG::random_mpi(256), a);
+}
@@ -23,3 +23,27 @@ TEST(Radix64, rfc4648_base64_test_vectors) {
     EXPECT_EQ(OpenPGP::radix642ascii("Zm9vYmFy"), "foobar");
 
 }
+
+TEST(Radix64, round_trip) {
+    std::string data;
+    for(unsigned int i = 0; i < 1000; i++) {
+        data += static_cast <char> (i * 131 + 7);
+    }
+
+    // every length mod 3, and every byte value
+    for(std::string::size_type length = 0; length < data.size(); length += 37) {
+        const std::string str = data.substr(0, length);
+        EXPECT_EQ(OpenPGP::radix642ascii(OpenPGP::ascii2radix64(str)), str);
+    }
+}
+
+TEST(Radix64, alphabet) {
+    // 0xfb 0xff encodes to the last two characters of the alphabet
+    EXPECT_EQ(OpenPGP::ascii2radix64("\xfb\xff"), "+/8=");
+    EXPECT_EQ(OpenPGP::ascii2radix64("\xfb\xff", '-', '_'), "-_8=");
+    EXPECT_EQ(OpenPGP::radix642ascii("-_8=", '-', '_'), "\xfb\xff");
+
+    EXPECT_THROW(OpenPGP::radix642ascii("-_8="), std::runtime_error);
+    EXPECT_THROW(OpenPGP::radix642ascii("Zm9v Zm9"), std::runtime_error);
+    EXPECT_THROW(OpenPGP::radix642ascii("Zm=v"), std::runtime_error);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "PKA/Curve25519.h"
+#include "common/includes.h"
+
+using namespace OpenPGP::PKA;
+
+// RFC 8032 7.1 TEST 1 - 3
+static const std::vector <std::string> ED25519_SEED = {
+    "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+    "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+    "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+};
+
+static const std::vector <std::string> ED25519_PUBLIC = {
+    "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+    "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+    "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+};
+
+static const std::vector <std::string> ED25519_MESSAGE = {
+    "",
+    "72",
+    "af82",
+};
+
+static const std::vector <std::string> ED25519_SIGNATURE = {
+    "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+    "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00",
+    "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a",
+};
+
+TEST(Curve25519, ed25519) {
+    for(std::size_t i = 0; i < ED25519_SEED.size(); i++) {
+        const std::string seed = unhexlify(ED25519_SEED[i]);
+        const std::string pub = unhexlify(ED25519_PUBLIC[i]);
+        const std::string message = unhexlify(ED25519_MESSAGE[i]);
+        const std::string sig = unhexlify(ED25519_SIGNATURE[i]);
+
+        EXPECT_EQ(Curve25519::ed25519_public(seed), pub);
+        EXPECT_EQ(Curve25519::ed25519_sign(message, seed, pub), sig);
+        EXPECT_TRUE(Curve25519::ed25519_verify(message, sig, pub));
+
+        // wrong message
+        EXPECT_FALSE(Curve25519::ed25519_verify(message + "x", sig, pub));
+
+        // flipped bit in S
+        std::string bad = sig;
+        bad[40] ^= 1;
+        EXPECT_FALSE(Curve25519::ed25519_verify(message, bad, pub));
+
+        // S >= L
+        bad = sig;
+        bad[63] ^= 0x10;
+        EXPECT_FALSE(Curve25519::ed25519_verify(message, bad, pub));
+    }
+
+    // public key does not belong to the seed
+    EXPECT_EQ(Curve25519::ed25519_sign("", unhexlify(ED25519_SEED[0]), unhexlify(ED25519_PUBLIC[1])), "");
+}
+
+TEST(Curve25519, ed25519_batch) {
+    std::vector <std::string> messages, sigs, pubs;
+    for(std::size_t i = 0; i < 16; i++) {
+        const std::string seed = std::string(31, 0) + std::string(1, i);
+        const std::string message = "message " + std::to_string(i);
+        pubs.push_back(Curve25519::ed25519_public(seed));
+        messages.push_back(message);
+        sigs.push_back(Curve25519::ed25519_sign(message, seed, pubs.back()));
+    }
+
+    for(std::size_t i = 0; i < ED25519_SEED.size(); i++) {
+        messages.push_back(unhexlify(ED25519_MESSAGE[i]));
+        sigs.push_back(unhexlify(ED25519_SIGNATURE[i]));
+        pubs.push_back(unhexlify(ED25519_PUBLIC[i]));
+    }
+
+    EXPECT_TRUE(Curve25519::ed25519_verify(messages, sigs, pubs));
+    EXPECT_TRUE(Curve25519::ed25519_verify(std::vector <std::string> (), std::vector <std::string> (), std::vector <std::string> ()));
+
+    // one bad signature fails the batch
+    messages[5] += "x";
+    EXPECT_FALSE(Curve25519::ed25519_verify(messages, sigs, pubs));
+
+    // mismatched sizes
+    pubs.pop_back();
+    EXPECT_FALSE(Curve25519::ed25519_verify(messages, sigs, pubs));
+}
+
+TEST(Curve25519, x25519) {
+    // RFC 7748 5.2
+    EXPECT_EQ(hexlify(Curve25519::x25519(unhexlify("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4"),
+                                         unhexlify("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c"))),
+              "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552");
+
+    const std::string nine = std::string(1, 9) + std::string(31, 0);
+    EXPECT_EQ(hexlify(Curve25519::x25519(nine, nine)),
+              "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079");
+
+    // RFC 7748 6.1
+    const std::string a = unhexlify("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    const std::string b = unhexlify("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+    const std::string A = Curve25519::x25519_base(a);
+    const std::string B = Curve25519::x25519_base(b);
+    EXPECT_EQ(hexlify(A), "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a");
+    EXPECT_EQ(hexlify(B), "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f");
+    EXPECT_EQ(A, Curve25519::x25519(a, nine));
+    EXPECT_EQ(hexlify(Curve25519::x25519(a, B)), "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742");
+    EXPECT_EQ(Curve25519::x25519(b, A), Curve25519::x25519(a, B));
+
+    // low order point gives the all-zero shared secret
+    EXPECT_EQ(Curve25519::x25519(a, std::string(32, 0)), "");
+
+    // bad lengths
+    EXPECT_EQ(Curve25519::x25519(a.substr(1), B), "");
+}
@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "PKA/DSA.h"
+#include "RNG/Deterministic.h"
 #include "sign.h"
 
 #include "testvectors/dsa/dsasiggen.h"
@@ -56,3 +57,91 @@ TEST(DSA, keygen) {
         EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
     }
 }
+
+TEST(DSA, prepared_tables) {
+    static const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, unhexlify(DSA_SIGGEN_MSG[0]));
+
+    OpenPGP::PKA::Values pub = OpenPGP::PKA::DSA::standard_public(2048, 256);
+    const OpenPGP::PKA::Values pri = OpenPGP::PKA::DSA::keygen(pub);
+    ASSERT_EQ(pub.size(), 4);
+
+    const std::shared_ptr <const OpenPGP::WindowTable> g = OpenPGP::PKA::DSA::domain_table(pub[0], pub[2]);
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(OpenPGP::PKA::DSA::domain_table(pub[0], pub[2]), g);
+    EXPECT_EQ(OpenPGP::PKA::DSA::domain_table(pub[0] + 1, pub[2]), nullptr);
+
+    const OpenPGP::WindowTable y(pub[3], g -> get_ctx());
+    const OpenPGP::PKA::Values sig = OpenPGP::PKA::DSA::sign(digest, pri, pub);
+    EXPECT_TRUE(OpenPGP::PKA::DSA::verify(OpenPGP::rawtompi(digest), sig, pub, *g, y));
+    EXPECT_FALSE(OpenPGP::PKA::DSA::verify(OpenPGP::rawtompi(digest) + 1, sig, pub, *g, y));
+    EXPECT_FALSE(OpenPGP::PKA::DSA::verify(OpenPGP::rawtompi(digest), {sig[0], 0}, pub, *g, y));
+}
+
+TEST(DSA, standard_public) {
+    static const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, unhexlify(DSA_SIGGEN_MSG[0]));
+
+    for(OpenPGP::PKA::DSA::DomainParameters const & params : OpenPGP::PKA::DSA::STANDARD_DOMAIN_PARAMETERS) {
+        OpenPGP::PKA::Values pub = OpenPGP::PKA::DSA::standard_public(params.L, params.N);
+        ASSERT_EQ(pub.size(), 3);
+
+        const OpenPGP::MPI & p = pub[0];
+        const OpenPGP::MPI & q = pub[1];
+        const OpenPGP::MPI & g = pub[2];
+        EXPECT_EQ(OpenPGP::bitsize(p), params.L);
+        EXPECT_EQ(OpenPGP::bitsize(q), params.N);
+        EXPECT_TRUE(OpenPGP::knuth_prime_test(p, 5));
+        EXPECT_TRUE(OpenPGP::knuth_prime_test(q, 5));
+        EXPECT_EQ((p - 1) % q, 0);
+        EXPECT_GT(g, 1);
+        EXPECT_EQ(OpenPGP::powm(g, q, p), 1);
+
+        const OpenPGP::PKA::Values pri = OpenPGP::PKA::DSA::keygen(pub);
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::DSA::sign(digest, pri, pub, 0);
+        EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
+    }
+
+    EXPECT_EQ(OpenPGP::PKA::DSA::standard_public(1024, 256).size(), 0);
+}
+
+TEST(DSA, presignature_pool) {
+    static const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, unhexlify(DSA_SIGGEN_MSG[0]));
+
+    OpenPGP::PKA::Values pub = OpenPGP::PKA::DSA::standard_public(2048, 256);
+    const OpenPGP::PKA::Values pri = OpenPGP::PKA::DSA::keygen(pub);
+
+    OpenPGP::PKA::DSA::PresignaturePool pool(pub, 4);
+    OpenPGP::PKA::Values last;
+    for(int i = 0; i < 8; ++i) {
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::DSA::sign(digest, pri, pub, pool);
+        EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
+
+        // presignatures are never reused
+        EXPECT_NE(sig, last);
+        last = sig;
+    }
+}
+
+TEST(DSA, deterministic_rng) {
+    static const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, unhexlify(DSA_SIGGEN_MSG[0]));
+
+    const OpenPGP::PKA::Values group = OpenPGP::PKA::DSA::standard_public(2048, 256);
+
+    // key and signature generated from a seed
+    auto run = [&](const std::string & seed) {
+        OpenPGP::RNG::ScopedProvider scope(std::make_shared <OpenPGP::RNG::Deterministic> (seed));
+        OpenPGP::PKA::Values pub = group;
+        OpenPGP::PKA::Values out = OpenPGP::PKA::DSA::keygen(pub);
+        for(OpenPGP::MPI const & v : OpenPGP::PKA::DSA::sign(digest, out, pub)) {
+            out.push_back(v);
+        }
+        return out;
+    };
+
+    const OpenPGP::PKA::Values first = run("benchmark");
+    EXPECT_EQ(run("benchmark"), first);
+    EXPECT_NE(run("another seed"), first);
+
+    // the default generator is back once the scope ends
+    OpenPGP::PKA::Values pub = group;
+    EXPECT_NE(OpenPGP::PKA::DSA::keygen(pub), OpenPGP::PKA::Values(first.begin(), first.begin() + 1));
+}
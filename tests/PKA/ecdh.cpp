@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "Encryptions/Encryptions.h"
+#include "Hashes/Hashes.h"
+#include "Misc/mpi.h"
+#include "PKA/ECDH.h"
+#include "common/includes.h"
+
+using namespace OpenPGP;
+
+TEST(ECDH, key_wrap) {
+    // RFC 3394 4.1 and 4.6
+    const std::string kek128 = unhexlify("000102030405060708090a0b0c0d0e0f");
+    const std::string kek256 = unhexlify("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const std::string data = unhexlify("00112233445566778899aabbccddeeff");
+    const std::string data256 = unhexlify("00112233445566778899aabbccddeeff000102030405060708090a0b0c0d0e0f");
+
+    const std::string wrapped = PKA::ECDH::key_wrap(Sym::ID::AES128, kek128, data);
+    EXPECT_EQ(hexlify(wrapped), "1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5");
+    EXPECT_EQ(PKA::ECDH::key_unwrap(Sym::ID::AES128, kek128, wrapped), data);
+
+    const std::string wrapped256 = PKA::ECDH::key_wrap(Sym::ID::AES256, kek256, data256);
+    EXPECT_EQ(hexlify(wrapped256), "28c9f404c4b810f4cbccb35cfb87f8263f5786e2d80ed326cbc7f0e71a99f43bfb988b9b7a02dd21");
+    EXPECT_EQ(PKA::ECDH::key_unwrap(Sym::ID::AES256, kek256, wrapped256), data256);
+
+    // integrity check
+    std::string bad = wrapped;
+    bad[10] ^= 1;
+    EXPECT_EQ(PKA::ECDH::key_unwrap(Sym::ID::AES128, kek128, bad), "");
+}
+
+TEST(ECDH, encrypt_decrypt) {
+    const PKA::Values keys = PKA::ECDH::keygen();
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(bitsize(keys[0]), 263);
+
+    const PKA::Values pub = {keys[0]};
+    const PKA::Values pri = {keys[1]};
+    const std::string param = PKA::ECDH::kdf_param(unhexlify("2b060104019755010501"), Hash::ID::SHA256, Sym::ID::AES128, std::string(20, 'f'));
+
+    // symmetric algorithm, session key and checksum
+    const std::string m = std::string(1, Sym::ID::AES256) + std::string(32, 'k') + "\x0d\x60";
+
+    std::string wrapped;
+    const PKA::Values ephemeral = PKA::ECDH::encrypt(m, pub, param, Hash::ID::SHA256, Sym::ID::AES128, wrapped);
+    ASSERT_EQ(ephemeral.size(), 1);
+    EXPECT_EQ(wrapped.size(), 48);
+    EXPECT_EQ(PKA::ECDH::decrypt(ephemeral[0], wrapped, pri, param, Hash::ID::SHA256, Sym::ID::AES128), m);
+
+    // different KDF parameters derive a different key
+    const std::string other = PKA::ECDH::kdf_param(unhexlify("2b060104019755010501"), Hash::ID::SHA256, Sym::ID::AES128, std::string(20, 'g'));
+    EXPECT_EQ(PKA::ECDH::decrypt(ephemeral[0], wrapped, pri, other, Hash::ID::SHA256, Sym::ID::AES128), "");
+
+    // wrong key
+    const PKA::Values other_keys = PKA::ECDH::keygen();
+    EXPECT_EQ(PKA::ECDH::decrypt(ephemeral[0], wrapped, {other_keys[1]}, param, Hash::ID::SHA256, Sym::ID::AES128), "");
+}
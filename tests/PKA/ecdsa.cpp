@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "Hashes/Hashes.h"
+#include "Misc/mpi.h"
+#include "PKA/ECDSA.h"
+#include "common/includes.h"
+
+using namespace OpenPGP;
+
+// RFC 6979 A.2.5
+static const PKA::Values P256_PUB = {hextompi("04"
+                                              "60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6"
+                                              "7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299")};
+static const PKA::Values P256_PRI = {hextompi("C9AFA9D845BA75166B5C215767B1D6934E50C3DB36E89B127B8A622B120F6721")};
+
+// RFC 6979 A.2.6
+static const PKA::Values P384_PUB = {hextompi("04"
+                                              "EC3A4E415B4E19A4568618029F427FA5DA9A8BC4AE92E02E06AAE5286B300C64DEF8F0EA9055866064A254515480BC13"
+                                              "8015D9B72D7D57244EA8EF9AC0C621896708A59367F9DFB9F54CA84B3F1C9DB1288B231C3AE0D4FE7344FD2533264720")};
+static const PKA::Values P384_PRI = {hextompi("6B9D3DAD2E1B8C1C05B19875B6659F4DE23C3B667BF297BA9AA47740787137D896D5724E4C70A825F872C9EA60D2EDF5")};
+
+TEST(ECDSA, p256_sign_verify) {
+    const std::string digest = Hash::use(Hash::ID::SHA256, "sample");
+    const PKA::Values sig = PKA::ECDSA::sign(digest, P256_PRI, P256_PUB, hextompi("A6E3C57DD01ABE90086538398355DD4C3B17AA873382B0F24D6129493D8AAD60"));
+    ASSERT_EQ(sig.size(), 2);
+    EXPECT_EQ(sig[0], hextompi("EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716"));
+    EXPECT_EQ(sig[1], hextompi("F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8"));
+    EXPECT_TRUE(PKA::ECDSA::verify(digest, sig, P256_PUB));
+
+    // digest longer than the group order is truncated
+    const std::string digest512 = Hash::use(Hash::ID::SHA512, "sample");
+    const PKA::Values sig512 = {hextompi("8496A60B5E9B47C825488827E0495B0E3FA109EC4568FD3F8D1097678EB97F00"),
+                                hextompi("2362AB1ADBE2B8ADF9CB9EDAB740EA6049C028114F2460F96554F61FAE3302FE")};
+    EXPECT_TRUE(PKA::ECDSA::verify(digest512, sig512, P256_PUB));
+
+    // random k
+    const PKA::Values rand = PKA::ECDSA::sign(digest, P256_PRI, P256_PUB);
+    ASSERT_EQ(rand.size(), 2);
+    EXPECT_TRUE(PKA::ECDSA::verify(digest, rand, P256_PUB));
+
+    EXPECT_FALSE(PKA::ECDSA::verify(digest.substr(1), sig, P256_PUB));
+    EXPECT_FALSE(PKA::ECDSA::verify(digest, {sig[1], sig[0]}, P256_PUB));
+    EXPECT_FALSE(PKA::ECDSA::verify(digest, {sig[0]}, P256_PUB));
+    EXPECT_FALSE(PKA::ECDSA::verify(digest, sig, P384_PUB));
+
+    // point not on the curve
+    EXPECT_FALSE(PKA::ECDSA::verify(digest, sig, {P256_PUB[0] + 1}));
+}
+
+TEST(ECDSA, p384_sign_verify) {
+    const std::string digest = Hash::use(Hash::ID::SHA256, "sample");
+    const PKA::Values sig = PKA::ECDSA::sign(digest, P384_PRI, P384_PUB, hextompi("180AE9F9AEC5438A44BC159A1FCB277C7BE54FA20E7CF404B490650A8ACC414E375572342863C899F9F2EDF9747A9B60"));
+    ASSERT_EQ(sig.size(), 2);
+    EXPECT_EQ(sig[0], hextompi("21B13D1E013C7FA1392D03C5F99AF8B30C570C6F98D4EA8E354B63A21D3DAA33BDE1E888E63355D92FA2B3C36D8FB2CD"));
+    EXPECT_EQ(sig[1], hextompi("F3AA443FB107745BF4BD77CB3891674632068A10CA67E3D45DB2266FA7D1FEEBEFDC63ECCD1AC42EC0CB8668A4FA0AB0"));
+    EXPECT_TRUE(PKA::ECDSA::verify(digest, sig, P384_PUB));
+
+    const std::string digest512 = Hash::use(Hash::ID::SHA512, "sample");
+    const PKA::Values sig512 = PKA::ECDSA::sign(digest512, P384_PRI, P384_PUB, hextompi("92FC3C7183A883E24216D1141F1A8976C5B0DD797DFA597E3D7B32198BD35331A4E966532593A52980D0E3AAA5E10EC3"));
+    ASSERT_EQ(sig512.size(), 2);
+    EXPECT_EQ(sig512[0], hextompi("ED0959D5880AB2D869AE7F6C2915C6D60F96507F9CB3E047C0046861DA4A799CFE30F35CC900056D7C99CD7882433709"));
+    EXPECT_EQ(sig512[1], hextompi("512C8CCEEE3890A84058CE1E22DBC2198F42323CE8ACA9135329F03C068E5112DC7CC3EF3446DEFCEB01A45C2667FDD5"));
+    EXPECT_TRUE(PKA::ECDSA::verify(digest512, sig512, P384_PUB));
+
+    EXPECT_FALSE(PKA::ECDSA::verify(digest512, sig, P384_PUB));
+}
+
+TEST(ECDSA, keygen) {
+    for(std::string const & curve : {std::string("2A8648CE3D030107"), std::string("2B81040022")}) {
+        const PKA::Values keys = PKA::ECDSA::keygen(curve);
+        ASSERT_EQ(keys.size(), 2);
+
+        const PKA::Values pub = {keys[0]};
+        const PKA::Values pri = {keys[1]};
+        const std::string digest = Hash::use(Hash::ID::SHA384, "abc");
+        EXPECT_TRUE(PKA::ECDSA::verify(digest, PKA::ECDSA::sign(digest, pri, pub), pub));
+    }
+
+    EXPECT_EQ(PKA::ECDSA::keygen("2B81040023").size(), 0);
+}
+
+TEST(ECDSA, batch) {
+    std::vector <std::string> digests;
+    std::vector <PKA::Values> sigs, pubs;
+    for(int i = 0; i < 8; i++) {
+        const PKA::Values & pri = (i & 1)?P384_PRI:P256_PRI;
+        const PKA::Values & pub = (i & 1)?P384_PUB:P256_PUB;
+        digests.push_back(Hash::use(Hash::ID::SHA256, std::to_string(i)));
+        sigs.push_back(PKA::ECDSA::sign(digests.back(), pri, pub));
+        pubs.push_back(pub);
+    }
+
+    EXPECT_EQ(PKA::ECDSA::verify(digests, sigs, pubs), std::vector <bool> (8, true));
+
+    // the bad and malformed signatures are singled out
+    digests[2] = "";
+    sigs[5] = {sigs[5][0]};
+    std::swap(pubs[6], pubs[7]);
+    std::vector <bool> expected(8, true);
+    expected[2] = false;
+    expected[5] = false;
+    expected[6] = false;
+    expected[7] = false;
+    EXPECT_EQ(PKA::ECDSA::verify(digests, sigs, pubs), expected);
+}
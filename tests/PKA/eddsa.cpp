@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "Hashes/Hashes.h"
+#include "Misc/mpi.h"
+#include "PKA/EdDSA.h"
+#include "common/includes.h"
+
+using namespace OpenPGP;
+
+TEST(EdDSA, sign_verify) {
+    // RFC 8032 7.1 TEST 1; S starts with a zero octet once R is split off
+    const PKA::Values pub = {rawtompi(unhexlify("40d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a"))};
+    const PKA::Values pri = {rawtompi(unhexlify("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60"))};
+    const std::string digest = Hash::use(Hash::ID::SHA256, "abc");
+
+    const PKA::Values sig = PKA::EdDSA::sign(digest, pri, pub);
+    ASSERT_EQ(sig.size(), 2);
+    EXPECT_TRUE(PKA::EdDSA::verify(digest, sig, pub));
+    EXPECT_FALSE(PKA::EdDSA::verify(digest.substr(1), sig, pub));
+    EXPECT_FALSE(PKA::EdDSA::verify(digest, {sig[0]}, pub));
+    EXPECT_FALSE(PKA::EdDSA::verify(digest, sig, {pri[0]}));
+}
+
+TEST(EdDSA, keygen) {
+    const PKA::Values keys = PKA::EdDSA::keygen();
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(bitsize(keys[0]), 263);
+
+    const PKA::Values pub = {keys[0]};
+    const PKA::Values pri = {keys[1]};
+    const std::string digest = Hash::use(Hash::ID::SHA256, "abc");
+    EXPECT_TRUE(PKA::EdDSA::verify(digest, PKA::EdDSA::sign(digest, pri, pub), pub));
+}
+
+TEST(EdDSA, batch) {
+    std::vector <std::string> digests;
+    std::vector <PKA::Values> sigs, pubs;
+    for(int i = 0; i < 8; i++) {
+        const PKA::Values pri = {i + 1};
+        const PKA::Values pub = {rawtompi("\x40" + PKA::Curve25519::ed25519_public(std::string(31, 0) + std::string(1, i + 1)))};
+        digests.push_back(Hash::use(Hash::ID::SHA256, std::to_string(i)));
+        sigs.push_back(PKA::EdDSA::sign(digests.back(), pri, pub));
+        pubs.push_back(pub);
+    }
+
+    EXPECT_EQ(PKA::EdDSA::verify(digests, sigs, pubs), std::vector <bool> (8, true));
+
+    // the bad and malformed signatures are singled out
+    digests[2] = "";
+    sigs[6] = {sigs[6][0]};
+    std::vector <bool> expected(8, true);
+    expected[2] = false;
+    expected[6] = false;
+    EXPECT_EQ(PKA::EdDSA::verify(digests, sigs, pubs), expected);
+}
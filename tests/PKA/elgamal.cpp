@@ -3,6 +3,7 @@
 #include "Misc/mpi.h"
 #include "Misc/pgptime.h"
 #include "PKA/ElGamal.h"
+#include "PKA/FixedBase.h"
 #include "RNG/RNGs.h"
 #include "common/includes.h"
 
@@ -25,3 +26,84 @@ TEST(ElGamal, keygen) {
         EXPECT_EQ(mpi_data, OpenPGP::rawtompi(decrypted));
     }
 }
+
+TEST(ElGamal, keygen_standard) {
+    OpenPGP::RNG::RNG rng;
+
+    for(OpenPGP::PKA::ElGamal::Group const & group : OpenPGP::PKA::ElGamal::MODP_GROUPS) {
+        const OpenPGP::PKA::Values params = OpenPGP::PKA::ElGamal::standard_group(group.bits);
+        ASSERT_EQ(params.size(), 2);
+
+        // p should be a safe prime
+        const OpenPGP::MPI & p = params[0];
+        EXPECT_EQ(OpenPGP::bitsize(p), group.bits);
+        EXPECT_TRUE(OpenPGP::knuth_prime_test(p, 2));
+        EXPECT_TRUE(OpenPGP::knuth_prime_test((p - 1) >> 1, 2));
+    }
+
+    // keep bitsize small to reduce computation time
+    for(unsigned int const bitsize : {1024, 2048}) {
+        const std::string data = unbinify(rng.rand_bits(bitsize >> 1));
+        const OpenPGP::MPI mpi_data = OpenPGP::rawtompi(data);
+
+        const OpenPGP::PKA::Values key = OpenPGP::PKA::ElGamal::keygen_standard(bitsize);
+        ASSERT_EQ(key.size(), 4);
+        const OpenPGP::PKA::Values pub = {key[0], key[1], key[2]};
+        const OpenPGP::PKA::Values pri = {key[3]};
+
+        const OpenPGP::PKA::Values encrypted = OpenPGP::PKA::ElGamal::encrypt(data, pub);
+        const std::string decrypted = OpenPGP::PKA::ElGamal::decrypt(encrypted, pri, pub);
+
+        EXPECT_EQ(mpi_data, OpenPGP::rawtompi(decrypted));
+    }
+
+    EXPECT_EQ(OpenPGP::PKA::ElGamal::keygen_standard(1000).size(), 0);
+}
+
+TEST(ElGamal, repeated_encrypt) {
+    const OpenPGP::PKA::Values key = OpenPGP::PKA::ElGamal::keygen_standard(1024);
+    ASSERT_EQ(key.size(), 4);
+    const OpenPGP::PKA::Values pub = {key[0], key[1], key[2]};
+    const OpenPGP::PKA::Values pri = {key[3]};
+
+    // the first encryption uses powm; later ones use the cached comb tables of g and y
+    const std::string data = "testing testing 123";
+    for(int i = 0; i < 4; ++i) {
+        const OpenPGP::PKA::Values encrypted = OpenPGP::PKA::ElGamal::encrypt(data, pub);
+        EXPECT_EQ(OpenPGP::PKA::ElGamal::decrypt(encrypted, pri, pub), data);
+    }
+
+    EXPECT_NE(OpenPGP::PKA::fixed_base(pub[1], pub[0], OpenPGP::bitsize(pub[0])), nullptr);
+    OpenPGP::PKA::clear_fixed_base();
+}
+
+TEST(ElGamal, prepared_tables) {
+    const OpenPGP::PKA::Values key = OpenPGP::PKA::ElGamal::keygen_standard(1024);
+    ASSERT_EQ(key.size(), 4);
+    const OpenPGP::PKA::Values pub = {key[0], key[1], key[2]};
+    const OpenPGP::PKA::Values pri = {key[3]};
+
+    const OpenPGP::CombTable g(pub[1], pub[0], OpenPGP::bitsize(pub[0]));
+    const OpenPGP::CombTable y(pub[2], pub[0], OpenPGP::bitsize(pub[0]));
+
+    const std::string data = "testing testing 123";
+    const OpenPGP::PKA::Values encrypted = OpenPGP::PKA::ElGamal::encrypt(OpenPGP::rawtompi(data), pub, OpenPGP::PKA::ElGamal::ephemeral(pub, g, y));
+    EXPECT_EQ(OpenPGP::PKA::ElGamal::decrypt(encrypted, pri, pub), data);
+}
+
+TEST(ElGamal, ephemeral_pool) {
+    const OpenPGP::PKA::Values key = OpenPGP::PKA::ElGamal::keygen_standard(1024);
+    ASSERT_EQ(key.size(), 4);
+    const OpenPGP::PKA::Values pub = {key[0], key[1], key[2]};
+    const OpenPGP::PKA::Values pri = {key[3]};
+
+    OpenPGP::PKA::ElGamal::EphemeralPool pool(pub, 4);
+    const std::string data = "testing testing 123";
+    OpenPGP::PKA::Values last;
+    for(int i = 0; i < 8; ++i) {
+        const OpenPGP::PKA::Values encrypted = OpenPGP::PKA::ElGamal::encrypt(data, pub, pool);
+        EXPECT_EQ(OpenPGP::PKA::ElGamal::decrypt(encrypted, pri, pub), data);
+        EXPECT_NE(encrypted, last);
+        last = encrypted;
+    }
+}
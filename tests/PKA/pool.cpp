@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "PKA/Pool.h"
+
+TEST(Pool, generator_throws) {
+    // the generator only fails on the background thread
+    const std::thread::id caller = std::this_thread::get_id();
+    OpenPGP::PKA::Pool <int> pool([caller]() {
+        if (std::this_thread::get_id() != caller) {
+            throw std::runtime_error("Error: generator failed.");
+        }
+        return 1;
+    }, 4);
+
+    // the failure reaches the caller instead of terminating the process
+    bool thrown = false;
+    for(int i = 0; (i < 1000) && !thrown; i++) {
+        try {
+            EXPECT_EQ(pool.take(), 1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        catch (const std::runtime_error &) {
+            thrown = true;
+        }
+    }
+    EXPECT_TRUE(thrown);
+
+    // after that, values are generated on the calling thread
+    EXPECT_EQ(pool.take(), 1);
+    EXPECT_EQ(pool.size(), (std::size_t) 0);
+}
@@ -76,6 +76,14 @@ TEST(Tag1, read_write) {
         TAG1_EQ(tag1);
 
         EXPECT_EQ(tag1.raw(), raw);
+
+        // read in place from the middle of a larger buffer
+        const std::string buffer = std::string(64, 'x') + raw + std::string(64, 'x');
+        std::string::size_type pos = 64;
+        OpenPGP::Packet::Tag1 inner;
+        inner.read(buffer, pos, raw.size());
+        EXPECT_EQ(inner.get_mpi(), mpi);
+        EXPECT_EQ(pos, 64 + raw.size());
     }
 
     // DSA
@@ -105,3 +105,23 @@ TEST(Tag11, clone) {
         TAG11_EQ(*std::static_pointer_cast<OpenPGP::Packet::Tag11>(clone), data_format.first);
     }
 }
+
+TEST(Tag11, write_into) {
+    OpenPGP::Packet::Tag11 tag11;
+    tag11.set_data_format(OpenPGP::Packet::Literal::BINARY);
+    tag11.set_filename("file");
+    tag11.set_time(0x01020304);
+    tag11.set_literal(std::string(1000, 'a'));
+
+    for(OpenPGP::Packet::HeaderFormat const format : {OpenPGP::Packet::HeaderFormat::OLD, OpenPGP::Packet::HeaderFormat::NEW}) {
+        for(OpenPGP::Packet::PartialBodyLength const partial : {OpenPGP::Packet::NOT_PARTIAL, OpenPGP::Packet::PARTIAL}) {
+            tag11.set_header_format(format);
+            tag11.set_partial(partial);
+
+            std::string out = "prefix";
+            tag11.write_into(out);
+            EXPECT_EQ(out, "prefix" + tag11.write());
+            EXPECT_EQ(tag11.write_size(), tag11.write().size());
+        }
+    }
+}
@@ -98,6 +98,71 @@ TEST(Tag2, read_write) {
     OpenPGP::Packet::Tag2 tag2(raw);
     TAG2_EQ(tag2);
     EXPECT_EQ(tag2.raw(), raw);
+
+    // read in place from the middle of a larger buffer
+    {
+        const std::string buffer = "junk" + raw + "junk";
+        std::string::size_type pos = 4;
+        OpenPGP::Packet::Tag2 inner;
+        inner.read(buffer, pos, raw.size());
+        TAG2_EQ(inner);
+        EXPECT_EQ(pos, 4 + raw.size());
+    }
+}
+
+TEST(Tag2, subpackets_as_read) {
+    // creation time with a longer length encoding than needed
+    const std::string hashed_str = std::string("\xff\x00\x00\x00\x05\x02\x00\x00\x01\x00", 10) +
+                                   std::string("\x05\x09\x00\x00\x00\x10", 6);
+    const std::string unhashed_str = std::string("\x09\x10", 2) + "ABCDEFGH";
+
+    const std::string raw = std::string(1, version) +
+        std::string(1, type) +
+        std::string(1, pka) +
+        std::string(1, hash) +
+        unhexlify(makehex(hashed_str.size(), 4)) + hashed_str +
+        unhexlify(makehex(unhashed_str.size(), 4)) + unhashed_str +
+        std::string(2, '\x00') + OpenPGP::write_MPI(mpi[0]);
+
+    OpenPGP::Packet::Tag2 tag2(raw);
+    EXPECT_EQ(tag2.get_keyid(), "ABCDEFGH");
+    const std::array <uint32_t, 3> times = tag2.get_times();
+    EXPECT_EQ(times[0], (uint32_t) 0x100);
+    EXPECT_EQ(times[1], (uint32_t) 0);
+    EXPECT_EQ(times[2], (uint32_t) 0x110);
+    EXPECT_EQ(tag2.find_subpacket(OpenPGP::Subpacket::Tag2::ISSUER), "ABCDEFGH");
+
+    // checking subpackets does not need them to be kept
+    EXPECT_EQ(tag2.valid(), OpenPGP::Status::SUCCESS);
+
+    // subpackets are written back exactly as they were read
+    EXPECT_EQ(tag2.raw(), raw);
+    EXPECT_EQ(tag2.get_up_to_hashed().substr(6), hashed_str);
+
+    const OpenPGP::Packet::Tag2 copy(tag2);
+    EXPECT_EQ(copy.raw(), raw);
+    ASSERT_EQ(copy.get_hashed_subpackets().size(), (OpenPGP::Packet::Tag2::Subpackets::size_type) 2);
+
+    // subpackets handed out are copies, so editing them leaves the packet alone
+    OpenPGP::Packet::Tag2::Subpackets hashed = tag2.get_hashed_subpackets();
+    ASSERT_EQ(hashed[0] -> get_type(), OpenPGP::Subpacket::Tag2::SIGNATURE_CREATION_TIME);
+    std::static_pointer_cast <OpenPGP::Subpacket::Tag2::Sub2> (hashed[0]) -> set_time(0x300);
+    EXPECT_EQ(tag2.get_times()[0], (uint32_t) 0x100);
+    EXPECT_EQ(tag2.raw(), raw);
+
+    // until they are set back
+    OpenPGP::Packet::Tag2 edited(tag2);
+    edited.set_hashed_subpackets(hashed);
+    EXPECT_EQ(edited.get_times()[0], (uint32_t) 0x300);
+    EXPECT_NE(edited.raw(), raw);
+
+    // changing a subpacket rewrites the area
+    tag2.set_time(0x200);
+    EXPECT_EQ(tag2.get_times()[0], (uint32_t) 0x200);
+    EXPECT_EQ(tag2.get_times()[2], (uint32_t) 0x210);
+    EXPECT_NE(tag2.raw(), raw);
+    EXPECT_EQ(OpenPGP::Packet::Tag2(tag2.raw()).get_times()[0], (uint32_t) 0x200);
+    EXPECT_EQ(copy.get_times()[0], (uint32_t) 0x100);
 }
 
 TEST(Tag2, show) {
@@ -78,6 +78,56 @@ TEST(Tag6, read_write) {
     EXPECT_EQ(tag6.raw(), raw);
 }
 
+TEST(Tag6, raw_after_change) {
+    const std::string raw = std::string(1, version) +
+                            unhexlify(makehex(timestamp, 8)) +
+                            std::string(1, pka) +
+                            OpenPGP::write_MPI(mpi[0]) +
+                            OpenPGP::write_MPI(mpi[1]);
+
+    OpenPGP::Packet::Tag6 tag6(raw);
+    EXPECT_EQ(tag6.raw(), raw);
+    EXPECT_EQ(tag6.raw_common(), raw);
+    const std::string fingerprint = tag6.get_fingerprint();
+
+    // setters drop the saved octets
+    tag6.set_time(1);
+    const std::string changed = std::string(1, version) +
+                                unhexlify(makehex(1, 8)) +
+                                std::string(1, pka) +
+                                OpenPGP::write_MPI(mpi[0]) +
+                                OpenPGP::write_MPI(mpi[1]);
+    EXPECT_EQ(tag6.raw(), changed);
+    EXPECT_EQ(tag6.raw_common(), changed);
+    EXPECT_NE(tag6.get_fingerprint(), fingerprint);
+
+    // copies start with the same octets
+    const OpenPGP::Packet::Tag6 copy(tag6);
+    EXPECT_EQ(copy.raw(), changed);
+}
+
+TEST(Tag6, fingerprint_keyid) {
+    OpenPGP::Packet::Tag6 tag6;
+    TAG6_FILL(tag6);
+    tag6.set_mpi({OpenPGP::hextompi("0123456789abcdef0123"), 65537});
+
+    const OpenPGP::Packet::Key::Fingerprint & fpr = tag6.get_fingerprint_array();
+    EXPECT_EQ(std::string(fpr.begin(), fpr.end()), tag6.get_fingerprint());
+    EXPECT_EQ(tag6.get_keyid(), tag6.get_fingerprint().substr(12, 8));
+    EXPECT_EQ(tag6.get_keyid_int(), toint(tag6.get_keyid(), 256));
+
+    // changing the key changes the cached values
+    const uint64_t keyid = tag6.get_keyid_int();
+    tag6.set_time(1);
+    EXPECT_NE(tag6.get_keyid_int(), keyid);
+    EXPECT_EQ(tag6.get_keyid_int(), toint(tag6.get_fingerprint().substr(12, 8), 256));
+
+    // version 3 key IDs are the low 64 bits of the modulus
+    tag6.set_version(3);
+    EXPECT_EQ(tag6.get_keyid_int(), 0x456789abcdef0123ULL);
+    EXPECT_EQ(tag6.get_fingerprint().size(), (std::string::size_type) 16);
+}
+
 TEST(Tag6, show) {
     OpenPGP::Packet::Tag6 tag6;
     EXPECT_NO_THROW(TAG6_FILL(tag6));
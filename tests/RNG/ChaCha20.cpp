@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "RNG/ChaCha20.h"
+#include "common/includes.h"
+
+TEST(ChaCha20, block) {
+    // RFC 7539 sec A.1 Test Vector #1
+    const uint32_t key[8] = {};
+    uint8_t out[64];
+    OpenPGP::RNG::ChaCha20::block(key, 0, out);
+
+    EXPECT_EQ(hexlify(std::string(reinterpret_cast <char *> (out), sizeof(out))),
+              "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+              "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586");
+}
+
+TEST(ChaCha20, fork) {
+    // leave unused octets in the buffer before forking
+    OpenPGP::RNG::ChaCha20().rand_bytes(1);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        const std::string child = OpenPGP::RNG::ChaCha20().rand_bytes(16);
+        const bool ok = (write(fds[1], child.data(), child.size()) == static_cast <ssize_t> (child.size()));
+        _exit(ok?0:1);
+    }
+
+    close(fds[1]);
+    const std::string parent = OpenPGP::RNG::ChaCha20().rand_bytes(16);
+
+    std::string child(16, 0);
+    EXPECT_EQ(read(fds[0], &child[0], child.size()), static_cast <ssize_t> (child.size()));
+    close(fds[0]);
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    EXPECT_NE(parent, child);
+}
+
+TEST(ChaCha20, reseed_interval) {
+    OpenPGP::RNG::ChaCha20 rng;
+    rng.rand_bytes(1);
+    EXPECT_LT(OpenPGP::RNG::ChaCha20::get_generated(), OpenPGP::RNG::ChaCha20::RESEED_INTERVAL);
+
+    // run the generator up to its reseed interval
+    std::string buf(OpenPGP::RNG::ChaCha20::RESEED_INTERVAL, 0);
+    rng.rand_bytes(&buf[0], buf.size());
+    EXPECT_GE(OpenPGP::RNG::ChaCha20::get_generated(), OpenPGP::RNG::ChaCha20::RESEED_INTERVAL);
+
+    // the next request reseeds first
+    rng.rand_bytes(16);
+    EXPECT_EQ(OpenPGP::RNG::ChaCha20::get_generated(), 16);
+}
@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <ctime>
 #include <sstream>
 
@@ -815,6 +816,119 @@ TEST(gpg, verify_detached) {
     EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
 }
 
+#ifdef GPG_COMPATIBLE
+TEST(gpg, verify_detached_ecdsa) {
+
+    for(std::string const curve : {"256", "384"}) {
+        OpenPGP::PublicKey pub;
+        ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("ecdsa" + curve + "pub", pub, GPG_DIR), true);
+
+        OpenPGP::DetachedSignature sig;
+        ASSERT_EQ(read_pgp <OpenPGP::DetachedSignature> ("ecdsa" + curve + "detached", sig, GPG_DIR), true);
+
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(pub, MESSAGE, sig), true);
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(pub, MESSAGE.substr(1), sig), false);
+    }
+}
+#endif
+
+TEST(gpg, verify_batch) {
+
+    OpenPGP::PublicKey::Ptr pub = std::make_shared <OpenPGP::PublicKey> ();
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", *pub, GPG_DIR), true);
+
+    OpenPGP::DetachedSignature::Ptr sig = std::make_shared <OpenPGP::DetachedSignature> ();
+    ASSERT_EQ(read_pgp <OpenPGP::DetachedSignature> ("detached", *sig, GPG_DIR), true);
+
+    std::vector <OpenPGP::Verify::Job> jobs;
+    std::vector <int> expected;
+    for(int i = 0; i < 16; i++) {
+        jobs.push_back({pub, (i & 1)?MESSAGE.substr(1):MESSAGE, sig});
+        expected.push_back(!(i & 1));
+    }
+
+    // missing signature
+    jobs.push_back({pub, MESSAGE, nullptr});
+    expected.push_back(-1);
+
+    for(unsigned int threads : {1, 4}) {
+        EXPECT_EQ(OpenPGP::Verify::batch(jobs, threads), expected);
+    }
+
+    // a lazily read signature shared by every job is parsed before the workers start
+    for(unsigned int threads : {1, 4}) {
+        OpenPGP::DetachedSignature::Ptr lazy = std::make_shared <OpenPGP::DetachedSignature> ();
+        lazy -> set_lazy(true);
+        ASSERT_EQ(read_pgp <OpenPGP::DetachedSignature> ("detached", *lazy, GPG_DIR), true);
+
+        for(int i = 0; i < 16; i++) {
+            jobs[i].sig = lazy;
+        }
+
+        EXPECT_EQ(OpenPGP::Verify::batch(jobs, threads), expected);
+    }
+}
+
+TEST(gpg, verify_cache) {
+
+    OpenPGP::PublicKey pub;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", pub, GPG_DIR), true);
+
+    const std::string path = "verify_cache_test";
+    std::remove(path.c_str());
+
+    std::size_t entries = 0;
+    {
+        OpenPGP::VerifyCache cache(path);
+        EXPECT_EQ(cache.size(), (std::size_t) 0);
+
+        EXPECT_EQ(OpenPGP::Verify::primary_key(pub, pub, cache), true);
+        EXPECT_EQ(OpenPGP::Verify::subkey_binding(pub, cache), true);
+        entries = cache.size();
+        EXPECT_GE(entries, (std::size_t) 2);
+
+        // same answers the second time around
+        EXPECT_EQ(OpenPGP::Verify::primary_key(pub, pub, cache), true);
+        EXPECT_EQ(OpenPGP::Verify::subkey_binding(pub, cache), true);
+        EXPECT_EQ(cache.size(), entries);
+
+        EXPECT_EQ(cache.save(), true);
+    }
+
+    // reload from the file with no in-memory entries
+    OpenPGP::VerifyCache cache(path, 0);
+    EXPECT_EQ(cache.size(), entries);
+
+    // the first certification is answered by the cache, not the key
+    OpenPGP::Packet::Key::Ptr key = nullptr;
+    OpenPGP::Packet::User::Ptr uid = nullptr;
+    OpenPGP::Packet::Tag2::Ptr cert = nullptr;
+    for(OpenPGP::Packet::Tag::Ptr const & p : pub.get_packets()) {
+        if (OpenPGP::Packet::is_primary_key(p -> get_tag())) {
+            key = std::static_pointer_cast <OpenPGP::Packet::Key> (p);
+        }
+        else if (OpenPGP::Packet::is_user(p -> get_tag())) {
+            uid = std::static_pointer_cast <OpenPGP::Packet::User> (p);
+        }
+        else if (uid && !cert && (p -> get_tag() == OpenPGP::Packet::SIGNATURE)) {
+            cert = std::static_pointer_cast <OpenPGP::Packet::Tag2> (p);
+        }
+    }
+    ASSERT_NE(cert, nullptr);
+
+    const std::string entry = cache.key(key, cert, OpenPGP::to_sign_cert(cert -> get_type(), key, uid, cert));
+    bool result = false;
+    EXPECT_EQ(cache.get(entry, result), true);
+    EXPECT_EQ(result, true);
+
+    cache.set(entry, false);
+    EXPECT_EQ(OpenPGP::Verify::primary_key(key, key, uid, cert, cache), false);
+    EXPECT_EQ(OpenPGP::Verify::primary_key(key, key, uid, cert), true);
+    EXPECT_EQ(cache.size(), entries);
+
+    EXPECT_EQ(std::remove(path.c_str()), 0);
+}
+
 TEST(gpg, verify_binary) {
 
     OpenPGP::SecretKey pri;
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
 #include <fstream>
 
 #include "Key.h"
@@ -343,3 +344,24 @@ TEST(SecretKey, PublicKey) {
         EXPECT_EQ(key, pub);
     }
 }
+
+TEST(SecretKey, from_file) {
+    std::ifstream file(dir + "Alicepri");
+    ASSERT_TRUE(file);
+
+    const OpenPGP::SecretKey key(file);
+    const OpenPGP::SecretKey mapped = OpenPGP::SecretKey::from_file(dir + "Alicepri");
+    EXPECT_TRUE(mapped.meaningful());
+    EXPECT_EQ(mapped, key);
+
+    // binary input
+    const std::string path = "SecretKey_from_file.gpg";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << key.raw();
+    }
+    EXPECT_EQ(OpenPGP::SecretKey::from_file(path), key);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(OpenPGP::SecretKey::from_file(dir + "does not exist"), std::runtime_error);
+}
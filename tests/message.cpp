@@ -154,3 +154,30 @@ TEST(Message, signature) {
     // const std::string orig = trim_whitespace(std::string(std::istreambuf_iterator <char> (file), {}), true, true);
     // EXPECT_EQ(msg.write(), orig);
 }
+
+TEST(Message, indeterminate_length) {
+    // old format literal data packet running to the end of the input
+    const std::string body = std::string("b\x00\x00\x00\x00\x00", 6) + "hello world";
+    const std::string data = std::string(1, '\xaf') + body;
+
+    OpenPGP::Message msg;
+    msg.read_raw(data);
+
+    const OpenPGP::PGP::Packets packets = msg.get_packets();
+    ASSERT_EQ(packets.size(), 1);
+    ASSERT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::LITERAL_DATA);
+
+    const OpenPGP::Packet::Tag11::Ptr literal = std::static_pointer_cast <OpenPGP::Packet::Tag11> (packets[0]);
+    EXPECT_EQ(literal -> get_literal(), "hello world");
+    EXPECT_EQ(literal -> raw(), body);
+}
+
+TEST(Message, from_file) {
+    std::ifstream file(dir + "pkaencrypted");
+    ASSERT_TRUE(file);
+
+    const OpenPGP::Message msg(file);
+    const OpenPGP::Message mapped = OpenPGP::Message::from_file(dir + "pkaencrypted");
+    EXPECT_TRUE(mapped.meaningful());
+    EXPECT_EQ(mapped.write(), msg.write());
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "Key.h"
+#include "PacketReader.h"
+
+#include "testvectors/msg.h"
+
+static const std::string dir = "tests/testvectors/gpg/";
+
+TEST(PacketReader, key) {
+    std::ifstream file(dir + "Alicepri");
+    ASSERT_TRUE(file);
+
+    const OpenPGP::SecretKey pri(file);
+    ASSERT_TRUE(pri.meaningful());
+
+    std::stringstream stream(pri.raw());
+    OpenPGP::PacketReader reader(stream);
+
+    const OpenPGP::PGP::Packets & packets = pri.get_packets();
+    for(OpenPGP::Packet::Tag::Ptr const & p : packets) {
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ(reader.get_tag(), p -> get_tag());
+
+        const OpenPGP::Packet::Tag::Ptr packet = reader.packet();
+        ASSERT_NE(packet, nullptr);
+        EXPECT_EQ(packet -> raw(), p -> raw());
+    }
+
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(PacketReader, skip) {
+    std::ifstream file(dir + "Alicepri");
+    ASSERT_TRUE(file);
+
+    const OpenPGP::SecretKey pri(file);
+    const std::string data = pri.raw();
+
+    // only look at headers
+    std::stringstream stream(data);
+    OpenPGP::PacketReader reader(stream);
+
+    std::size_t i = 0;
+    std::string::size_type pos = 0;
+    while (reader.next()) {
+        ASSERT_LT(i, pri.size());
+        EXPECT_EQ(reader.get_tag(), pri.get_tag(i));
+        EXPECT_EQ(reader.get_offset(), pos);
+        pos += pri.get_packets()[i] -> write().size();
+        i++;
+    }
+
+    EXPECT_EQ(i, pri.size());
+    EXPECT_EQ(pos, data.size());
+}
+
+TEST(PacketReader, partial_body_length) {
+    std::string literal = "";
+    while (literal.size() < 5000) {
+        literal += MESSAGE;
+    }
+
+    // partial body length literal data packet followed by another packet
+    OpenPGP::Packet::Tag11::Ptr tag11 = std::make_shared <OpenPGP::Packet::Tag11> ();
+    tag11 -> set_partial(OpenPGP::Packet::PARTIAL);
+    tag11 -> set_data_format(OpenPGP::Packet::Literal::BINARY);
+    tag11 -> set_filename("filename");
+    tag11 -> set_time(0);
+    tag11 -> set_literal(literal);
+
+    OpenPGP::PGP out;
+    out.set_packets({tag11, std::make_shared <OpenPGP::Packet::Tag10> ()});
+
+    // read the body through a small buffer
+    std::stringstream stream(out.raw());
+    OpenPGP::PacketReader reader(stream, 100);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.get_tag(), OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_EQ(reader.get_partial(), OpenPGP::Packet::PARTIAL);
+
+    const std::string body(std::istreambuf_iterator <char> (reader.body()), {});
+    EXPECT_EQ(body, tag11 -> raw());
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.get_tag(), OpenPGP::Packet::MARKER_PACKET);
+    EXPECT_EQ(reader.read_body(), "PGP");
+
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(PacketReader, indeterminate_length) {
+    // old format literal data packet running to the end of the input
+    const std::string body = std::string("b\x00\x00\x00\x00\x00", 6) + "hello world";
+    std::stringstream stream(std::string(1, '\xaf') + body);
+    OpenPGP::PacketReader reader(stream);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.get_format(), OpenPGP::Packet::HeaderFormat::OLD);
+    EXPECT_EQ(reader.get_tag(), OpenPGP::Packet::LITERAL_DATA);
+
+    const OpenPGP::Packet::Tag::Ptr packet = reader.packet();
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(std::static_pointer_cast <OpenPGP::Packet::Tag11> (packet) -> get_literal(), "hello world");
+
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(PacketReader, truncated) {
+    // header says 10 octets, but only 3 follow
+    std::stringstream stream(std::string("\xcb\x0a" "abc", 5));
+    OpenPGP::PacketReader reader(stream);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_THROW(reader.read_body(), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "PGP.h"
+#include "PacketReader.h"
+#include "PacketWriter.h"
+
+#include "testvectors/msg.h"
+
+static OpenPGP::Packet::Tag11::Ptr literal_packet(const std::string & literal) {
+    OpenPGP::Packet::Tag11::Ptr tag11 = std::make_shared <OpenPGP::Packet::Tag11> ();
+    tag11 -> set_header_format(OpenPGP::Packet::HeaderFormat::NEW);
+    tag11 -> set_data_format(OpenPGP::Packet::Literal::BINARY);
+    tag11 -> set_filename("filename");
+    tag11 -> set_time(0);
+    tag11 -> set_literal(literal);
+    return tag11;
+}
+
+TEST(PacketWriter, short_body) {
+    // bodies that do not fill a chunk get a single definite length
+    const OpenPGP::Packet::Tag11::Ptr tag11 = literal_packet(MESSAGE);
+
+    std::stringstream stream;
+    OpenPGP::PacketWriter writer(stream);
+    writer.begin(OpenPGP::Packet::LITERAL_DATA);
+    writer.write(tag11 -> raw());
+    writer.finish();
+
+    EXPECT_EQ(writer.get_length(), tag11 -> raw().size());
+    EXPECT_EQ(stream.str(), tag11 -> write());
+}
+
+TEST(PacketWriter, partial_body_length) {
+    std::string literal = "";
+    while (literal.size() < 5000) {
+        literal += MESSAGE;
+    }
+
+    const OpenPGP::Packet::Tag11::Ptr tag11 = literal_packet(literal);
+    const std::string body = tag11 -> raw();
+
+    // write the body in uneven pieces through the stream interface
+    std::stringstream stream;
+    {
+        OpenPGP::PacketWriter writer(stream, 1000);
+        EXPECT_EQ(writer.get_chunk_size(), 512);
+
+        writer.begin(OpenPGP::Packet::LITERAL_DATA);
+        for(std::string::size_type i = 0; i < body.size(); i += 77) {
+            writer.body() << body.substr(i, 77);
+        }
+        writer.packet(std::make_shared <OpenPGP::Packet::Tag10> ());
+    }
+
+    OpenPGP::PacketReader reader(stream);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.get_tag(), OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_EQ(reader.get_partial(), OpenPGP::Packet::PARTIAL);
+
+    const OpenPGP::Packet::Tag::Ptr packet = reader.packet();
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(std::static_pointer_cast <OpenPGP::Packet::Tag11> (packet) -> get_literal(), literal);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.get_tag(), OpenPGP::Packet::MARKER_PACKET);
+
+    EXPECT_FALSE(reader.next());
+
+    // the whole output can also be parsed in one go
+    const OpenPGP::PGP pgp(stream.str());
+    ASSERT_EQ(pgp.get_packets().size(), 2);
+    EXPECT_EQ(pgp.get_packets()[0] -> raw(), body);
+}
+
+TEST(PacketWriter, last_piece_is_definite) {
+    // exactly two chunks: one partial piece, then the last chunk with a definite length
+    std::stringstream stream;
+    OpenPGP::PacketWriter writer(stream, 512);
+    writer.begin(OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA);
+    writer.write(std::string(1024, 'a'));
+    writer.finish();
+
+    const std::string out = stream.str();
+    ASSERT_EQ(out.size(), 1 + 1 + 512 + 2 + 512);
+    EXPECT_EQ(static_cast <uint8_t> (out[0]), 0xc0 | OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA);
+    EXPECT_EQ(static_cast <uint8_t> (out[1]), 0xe9);
+    EXPECT_EQ(out.substr(514, 2), "\xc1\x40");
+}
+
+TEST(PacketWriter, invalid) {
+    std::stringstream stream;
+    OpenPGP::PacketWriter writer(stream);
+
+    // only data packets can have partial body lengths
+    EXPECT_THROW(writer.begin(OpenPGP::Packet::SIGNATURE), std::runtime_error);
+
+    // nothing started
+    EXPECT_THROW(writer.write("abc"), std::runtime_error);
+}
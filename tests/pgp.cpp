@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include "PreparedKey.h"
 #include "decrypt.h"
 #include "encrypt.h"
 #include "keygen.h"
@@ -271,6 +272,44 @@ TEST(PGP, encrypt_decrypt_pka_mdc) {
     EXPECT_EQ(message, MESSAGE);
 }
 
+TEST(PGP, prepared_key) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
+
+    const OpenPGP::Packet::Key::Ptr key = OpenPGP::find_signing_key(pri);
+    ASSERT_NE(key, nullptr);
+
+    const OpenPGP::PreparedKey prepared(key);
+    EXPECT_EQ(prepared.get_keyid(), key -> get_keyid());
+    EXPECT_EQ(prepared.get_fingerprint(), key -> get_fingerprint());
+    EXPECT_EQ(prepared.get_modulus_length(), OpenPGP::bytesize(key -> get_mpi()[0]));
+    EXPECT_EQ(prepared.get_emsa_prefix(OpenPGP::Hash::ID::SHA256), OpenPGP::EMSA_PKCS1_v1_5(OpenPGP::Hash::ID::SHA256, "", prepared.get_modulus_length()));
+    EXPECT_EQ(prepared.get_emsa_prefix(255), "");
+
+    OpenPGP::DetachedSignature sig;
+    ASSERT_EQ(read_pgp <OpenPGP::DetachedSignature> ("detached", sig, GPG_DIR), true);
+    for(int i = 0; i < 2; i++) {
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(prepared, MESSAGE, sig), true);
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(prepared, MESSAGE.substr(1), sig), false);
+    }
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    for(int i = 0; i < 2; i++) {
+        const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encrypt_args, prepared);
+        ASSERT_EQ(encrypted.meaningful(), true);
+
+        const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, PASSPHRASE, encrypted);
+        std::string message = "";
+        for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()) {
+            if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA) {
+                message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+            }
+        }
+        EXPECT_EQ(message, MESSAGE);
+    }
+}
+
 TEST(PGP, encrypt_decrypt_pka_no_mdc) {
 
     OpenPGP::SecretKey pri;
@@ -387,6 +426,54 @@ TEST(PGP, encrypt_sign_decrypt_verify) {
     EXPECT_EQ(OpenPGP::Verify::binary(pri, decrypted), true);
 }
 
+#ifdef GPG_COMPATIBLE
+TEST(PGP, ed25519_cv25519) {
+
+    OpenPGP::KeyGen::Config config;
+    config.pka = OpenPGP::PKA::ID::EdDSA;
+    config.bits = 256;
+    config.passphrase = PASSPHRASE;
+    config.uids.push_back(OpenPGP::KeyGen::Config::UserID());
+    config.uids[0].user = "alice";
+    config.subkeys.push_back(OpenPGP::KeyGen::Config::SubkeyGen());
+    config.subkeys[0].pka = OpenPGP::PKA::ID::ECDH;
+    config.subkeys[0].bits = 256;
+    ASSERT_EQ(config.valid(), true);
+
+    const OpenPGP::SecretKey generated = OpenPGP::KeyGen::generate_key(config);
+    ASSERT_EQ(generated.meaningful(), true);
+
+    // curve OIDs and KDF parameters survive writing and reading
+    const OpenPGP::SecretKey pri(generated.write());
+    ASSERT_EQ(pri.meaningful(), true);
+    EXPECT_EQ(pri.fingerprint(), generated.fingerprint());
+    EXPECT_EQ(OpenPGP::Verify::primary_key(pri, pri), true);
+
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA256);
+    const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, MESSAGE);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE + "x", sig), false);
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    const OpenPGP::Message encrypted(OpenPGP::Encrypt::pka(encrypt_args, pri).write());
+    ASSERT_EQ(encrypted.meaningful(), true);
+
+    const OpenPGP::Packet::Tag1::Ptr tag1 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag1> (encrypted.get_packets()[0]);
+    EXPECT_EQ(tag1 -> get_pka(), OpenPGP::PKA::ID::ECDH);
+    EXPECT_EQ(tag1 -> get_mpi().size(), (OpenPGP::PKA::Values::size_type) 1);
+    EXPECT_EQ(tag1 -> get_wrapped().size(), (std::string::size_type) 48);
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, PASSPHRASE, encrypted);
+    std::string message = "";
+    for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()) {
+        if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA) {
+            message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+        }
+    }
+    EXPECT_EQ(message, MESSAGE);
+}
+#endif
+
 TEST(PGP, new_partial_body_length) {
 
     // fixed literal data packet values
@@ -452,6 +539,171 @@ TEST(PGP, new_partial_body_length) {
     EXPECT_EQ(tag11 -> get_literal(), literal);
 }
 
+TEST(PGP, lazy_read) {
+
+    OpenPGP::SecretKey eager;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", eager, GPG_DIR), true);
+    EXPECT_EQ(eager.get_index().size(), (OpenPGP::PGP::Index::size_type) 0);
+
+    OpenPGP::SecretKey lazy;
+    lazy.set_lazy(true);
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", lazy, GPG_DIR), true);
+
+    // only headers have been read
+    const OpenPGP::PGP::Index & index = lazy.get_index();
+    ASSERT_EQ(index.size(), eager.size());
+    for(OpenPGP::PGP::Index::size_type i = 0; i < index.size(); i++) {
+        EXPECT_EQ(index[i].tag, eager.get_packets()[i] -> get_tag());
+        EXPECT_EQ(lazy.get_tag(i), index[i].tag);
+    }
+
+    // the fingerprint only needs the primary key
+    EXPECT_EQ(lazy.fingerprint(), eager.fingerprint());
+
+    // copies made before anything is parsed stay lazy
+    OpenPGP::SecretKey copy;
+    copy.set_lazy(true);
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", copy, GPG_DIR), true);
+    const OpenPGP::SecretKey copy2(copy);
+    EXPECT_EQ(copy2.get_index().size(), index.size());
+
+    // parsing everything gives the same packets
+    EXPECT_EQ(lazy.raw(), eager.raw());
+    EXPECT_EQ(copy2.raw(), eager.raw());
+    EXPECT_EQ(lazy, eager);
+}
+
+TEST(PGP, lazy_assign) {
+
+    OpenPGP::PublicKey eager;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", eager, GPG_DIR), true);
+
+    OpenPGP::PublicKey lazy;
+    lazy.set_lazy(true);
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", lazy, GPG_DIR), true);
+
+    // unparsed packets are assigned along with the index they come from
+    OpenPGP::PublicKey other;
+    other = lazy;
+    EXPECT_EQ(other.get_lazy(), true);
+    EXPECT_EQ(other.get_index().size(), lazy.get_index().size());
+    EXPECT_EQ(other.size(), eager.size());
+    EXPECT_EQ(other.raw(), eager.raw());
+    EXPECT_EQ(lazy.raw(), eager.raw());
+}
+
+TEST(PGP, lazy_read_partial_body_length) {
+
+    std::string literal = "";
+    while (literal.size() < 2048) {
+        literal += MESSAGE;
+    }
+
+    // partial body length literal data packet followed by another packet
+    OpenPGP::Packet::Tag11::Ptr tag11 = std::make_shared <OpenPGP::Packet::Tag11> ();
+    tag11 -> set_partial(OpenPGP::Packet::PARTIAL);
+    tag11 -> set_data_format(OpenPGP::Packet::Literal::BINARY);
+    tag11 -> set_filename("filename");
+    tag11 -> set_time(0);
+    tag11 -> set_literal(literal);
+
+    OpenPGP::Packet::Tag10::Ptr tag10 = std::make_shared <OpenPGP::Packet::Tag10> ();
+
+    OpenPGP::PGP out;
+    out.set_packets({tag11, tag10});
+    const std::string data = out.raw();
+
+    OpenPGP::PGP eager;
+    eager.read_raw(data);
+    ASSERT_EQ(eager.size(), (OpenPGP::PGP::Packets::size_type) 2);
+    EXPECT_EQ(eager.get_tag(1), OpenPGP::Packet::MARKER_PACKET);
+
+    OpenPGP::PGP lazy;
+    lazy.set_lazy(true);
+    lazy.read_raw(data);
+    ASSERT_EQ(lazy.size(), (OpenPGP::PGP::Packets::size_type) 2);
+    EXPECT_EQ(lazy.get_index()[0].partial, OpenPGP::Packet::PARTIAL);
+    EXPECT_EQ(lazy.get_index()[1].tag, OpenPGP::Packet::MARKER_PACKET);
+
+    const OpenPGP::Packet::Tag11::Ptr in = std::static_pointer_cast <OpenPGP::Packet::Tag11> (lazy.get_packet(0));
+    EXPECT_EQ(in -> get_literal(), literal);
+    EXPECT_EQ(lazy.raw(), eager.raw());
+}
+
+TEST(PGP, many_partial_body_lengths) {
+
+    // literal data header followed by the start of the literal data
+    std::string body = std::string("b\x00\x00\x00\x00\x00", 6);
+    while (body.size() < 512) {
+        body += 'a';
+    }
+
+    // first piece must be at least 512 octets
+    std::string data = std::string(1, '\xcb') + std::string(1, '\xe9') + body;
+
+    // thousands of 1 octet pieces
+    for(std::size_t i = 0; i < 5000; i++) {
+        data += std::string(1, '\xe0') + std::string(1, 'b');
+        body += 'b';
+    }
+
+    // final piece
+    data += std::string(1, '\x01') + std::string(1, 'c');
+    body += 'c';
+
+    OpenPGP::PGP pgp;
+    pgp.read_raw(data);
+    ASSERT_EQ(pgp.size(), (OpenPGP::PGP::Packets::size_type) 1);
+    ASSERT_EQ(pgp.get_tag(0), OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_EQ(pgp.get_packet(0) -> raw(), body);
+
+    OpenPGP::PGP lazy;
+    lazy.set_lazy(true);
+    lazy.read_raw(data);
+    ASSERT_EQ(lazy.size(), (OpenPGP::PGP::Packets::size_type) 1);
+    EXPECT_EQ(lazy.get_index()[0].length, body.size());
+    EXPECT_EQ(lazy.get_packet(0) -> raw(), body);
+}
+
+TEST(PGP, arena) {
+
+    OpenPGP::SecretKey plain;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", plain, GPG_DIR), true);
+    EXPECT_EQ(plain.get_arena(), nullptr);
+
+    OpenPGP::PGP::Packets packets;
+    {
+        OpenPGP::SecretKey arena;
+        arena.set_use_arena(true);
+        ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", arena, GPG_DIR), true);
+        ASSERT_NE(arena.get_arena(), nullptr);
+        EXPECT_GT(arena.get_arena() -> used(), (std::size_t) 0);
+        EXPECT_EQ(arena.raw(), plain.raw());
+        EXPECT_EQ(arena.fingerprint(), plain.fingerprint());
+
+        // copies do not allocate from the original arena
+        const OpenPGP::SecretKey copy(arena);
+        EXPECT_EQ(copy.get_use_arena(), true);
+        EXPECT_EQ(copy.get_arena(), nullptr);
+
+        packets = arena.get_packets();
+    }
+
+    // packets keep the arena alive after the key is gone
+    OpenPGP::PGP pgp;
+    pgp.set_packets(packets);
+    EXPECT_EQ(pgp.raw(), plain.raw());
+
+    // lazy reads create the arena when the first packet is parsed
+    OpenPGP::SecretKey lazy;
+    lazy.set_lazy(true);
+    lazy.set_use_arena(true);
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", lazy, GPG_DIR), true);
+    EXPECT_EQ(lazy.fingerprint(), plain.fingerprint());
+    ASSERT_NE(lazy.get_arena(), nullptr);
+    EXPECT_EQ(lazy.raw(), plain.raw());
+}
+
 TEST(PGP, sign_verify_detached) {
 
     OpenPGP::SecretKey pri;